@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Every kernel runs its workload the given number of times and returns a checksum of the results.
+// The checksum is compared against a reference value computed on a host machine, so a kernel that
+// runs fast but computes the wrong answer is reported as a failure.
+typedef uint32_t (*bench_kernel)(uint32_t iterations);
+
+uint32_t bench_coremark(uint32_t iterations);
+uint32_t bench_dhrystone(uint32_t iterations);
+uint32_t bench_memcpy(uint32_t iterations);
+uint32_t bench_memset(uint32_t iterations);
+uint32_t bench_crc32(uint32_t iterations);
+uint32_t bench_fir(uint32_t iterations);
+uint32_t bench_matmul(uint32_t iterations);
+uint32_t bench_bitops(uint32_t iterations);
+
+// Deterministic pseudo-random sequence used to fill input buffers (xorshift32)
+static inline uint32_t bench_random(uint32_t *state)
+{
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+void *memcpy(void *dest, const void *src, size_t n);
+void *memset(void *s, int c, size_t n);
+
+#endif // BENCH_H
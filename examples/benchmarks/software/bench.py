@@ -0,0 +1,108 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2020-2025 RVX Project Contributors
+
+# Reads the output of the benchmark firmware running on mcu_sim and prints a summary table, and
+# with --baseline the cycles compared with another run.
+# Each result line has the format (numbers in hexadecimal):
+#   bench <name> <iterations> <cycles> <instructions retired> <checksum> <pass|fail>
+
+import sys
+import argparse
+
+
+class scolor:
+    NORMAL  = '\033[0m'
+    PASS    = '\033[32m'
+    FAIL    = '\033[31m'
+
+
+def parse(lines):
+    results = []
+    for line in lines:
+        fields = line.split()
+        if len(fields) != 7 or fields[0] != "bench":
+            continue
+        results.append({
+            "name":         fields[1],
+            "iterations":   int(fields[2], 16),
+            "cycles":       int(fields[3], 16),
+            "instret":      int(fields[4], 16),
+            "checksum":     int(fields[5], 16),
+            "passed":       fields[6] == "pass",
+        })
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Summarize RVX benchmark results")
+    parser.add_argument("--clock-frequency", type=int, default=50000000,
+                        help="clock frequency of the simulated MCU in Hz (default: 50000000)")
+    parser.add_argument("--baseline", type=argparse.FileType("r"),
+                        help="output of a reference run, for example without the M extension, to "
+                             "compare the cycles with")
+    parser.add_argument("input", nargs="?", type=argparse.FileType("r"), default=sys.stdin,
+                        help="simulator output (default: stdin)")
+    args = parser.parse_args()
+
+    results = parse(args.input)
+    if not results:
+        print(f"{scolor.FAIL}No benchmark results found (did the simulation time out?){scolor.NORMAL}")
+        return 1
+
+    mhz = args.clock_frequency / 1e6
+    header = f"{'Benchmark':<12}{'Iterations':>12}{'Cycles':>14}{'Instret':>14}{'CPI':>8}" \
+             f"{'Iter/s':>12}{'Score/MHz':>12}  Result"
+    print(header)
+    print("-" * len(header))
+
+    failed = 0
+    for r in results:
+        cpi = r["cycles"] / r["instret"] if r["instret"] else 0.0
+        # Iterations per second at the given clock, normalized to a 1 MHz clock
+        score_per_mhz = r["iterations"] * 1e6 / r["cycles"] if r["cycles"] else 0.0
+        iterations_per_second = score_per_mhz * mhz
+        if r["passed"]:
+            result = f"{scolor.PASS}PASS{scolor.NORMAL}"
+        else:
+            result = f"{scolor.FAIL}FAIL (checksum 0x{r['checksum']:08x}){scolor.NORMAL}"
+            failed += 1
+        print(f"{r['name']:<12}{r['iterations']:>12}{r['cycles']:>14}{r['instret']:>14}"
+              f"{cpi:>8.3f}{iterations_per_second:>12.1f}{score_per_mhz:>12.3f}  {result}")
+
+    total_cycles = sum(r["cycles"] for r in results)
+    total_instret = sum(r["instret"] for r in results)
+    print("-" * len(header))
+    print(f"{'Total':<12}{'':>12}{total_cycles:>14}{total_instret:>14}"
+          f"{total_cycles / total_instret if total_instret else 0.0:>8.3f}")
+
+    if args.baseline:
+        compare(parse(args.baseline), results)
+
+    return 1 if failed else 0
+
+
+def compare(baseline, results):
+    reference = {r["name"]: r for r in baseline}
+
+    header = f"{'Benchmark':<12}{'Baseline':>14}{'Cycles':>14}{'Base CPI':>10}{'CPI':>8}" \
+             f"{'Reduction':>11}{'Speedup':>9}"
+    print()
+    print(header)
+    print("-" * len(header))
+    for r in results:
+        before = reference.get(r["name"])
+        if not before or not before["iterations"] or not r["iterations"] or not r["cycles"]:
+            continue
+        # Compares cycles per iteration, in case the two runs did not do the same iterations
+        before_per_iteration = before["cycles"] / before["iterations"]
+        after_per_iteration = r["cycles"] / r["iterations"]
+        reduction = 100 * (1 - after_per_iteration / before_per_iteration)
+        speedup = before_per_iteration / after_per_iteration
+        before_cpi = before["cycles"] / before["instret"] if before["instret"] else 0.0
+        cpi = r["cycles"] / r["instret"] if r["instret"] else 0.0
+        print(f"{r['name']:<12}{before['cycles']:>14}{r['cycles']:>14}{before_cpi:>10.3f}{cpi:>8.3f}"
+              f"{reduction:>10.1f}%{speedup:>8.2f}x")
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "bench.h"
+
+#define WORDS 256
+#define PRIORITIES 32
+
+static uint32_t words[WORDS];
+static uint32_t weights[PRIORITIES];
+
+// Bit manipulation found in protocol and driver code: byte order swaps, population counts, bit
+// scans, rotations, saturation and mask clearing, plus a ready-bitmap scheduler that picks the
+// lowest set bit and indexes a table with it. RV32I emulates most of these in long sequences (or
+// libgcc calls), Zba and Zbb have an instruction for each one.
+static uint32_t bitops(uint32_t checksum)
+{
+  for (size_t i = 0; i < WORDS; i++)
+  {
+    uint32_t word = words[i];
+    uint32_t leading = word ? (uint32_t)__builtin_clz(word) : 32;
+    uint32_t trailing = word ? (uint32_t)__builtin_ctz(word) : 32;
+    int32_t level = (int32_t)word >> 20;
+    level = level < -1000 ? -1000 : level > 1000 ? 1000 : level;
+
+    checksum = (checksum << 5 | checksum >> 27) ^ __builtin_bswap32(word);
+    checksum += (uint32_t)__builtin_popcount(word) + (leading << 8) + (trailing << 16);
+    checksum ^= (uint32_t)level;
+
+    // Ready bitmap: serve every pending priority, lowest first
+    for (uint32_t ready = word & ~checksum; ready; ready &= ready - 1)
+      checksum += weights[__builtin_ctz(ready)];
+
+    words[i] = word ^ (checksum & ~word);
+  }
+  return checksum;
+}
+
+uint32_t bench_bitops(uint32_t iterations)
+{
+  uint32_t state = 0x5eed1e55;
+  for (uint32_t i = 0; i < WORDS; i++)
+    words[i] = bench_random(&state) >> (i % 24);
+  for (uint32_t i = 0; i < PRIORITIES; i++)
+    weights[i] = bench_random(&state);
+
+  uint32_t checksum = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+    checksum = bitops(checksum);
+  return checksum;
+}
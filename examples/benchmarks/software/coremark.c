@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+// CoreMark-style workload. Like CoreMark, each iteration runs a linked-list search and sort, a
+// small integer matrix computation and a byte-driven state machine, and folds the results into a
+// CRC-16. The data set is smaller than CoreMark's so it fits comfortably in the 32 KiB RAM of the
+// simulated MCU; scores are therefore only comparable between RVX configurations.
+
+#include "bench.h"
+
+#define LIST_SIZE 32
+#define MATRIX_N 6
+#define INPUT_SIZE 96
+
+typedef struct Node
+{
+  struct Node *next;
+  int16_t value;
+  int16_t index;
+} Node;
+
+static Node nodes[LIST_SIZE];
+static int16_t matrix_a[MATRIX_N * MATRIX_N];
+static int16_t matrix_b[MATRIX_N * MATRIX_N];
+static int32_t matrix_c[MATRIX_N * MATRIX_N];
+static char input[INPUT_SIZE];
+
+static uint16_t crc16(uint16_t data, uint16_t crc)
+{
+  for (int i = 0; i < 16; i++)
+  {
+    uint16_t carry = (data ^ crc) & 1;
+    data >>= 1;
+    crc >>= 1;
+    if (carry)
+      crc ^= 0xa001;
+  }
+  return crc;
+}
+
+// Insertion sort of the list by value, returns the new head
+static Node *list_sort(Node *head)
+{
+  Node *sorted = NULL;
+  while (head)
+  {
+    Node *current = head;
+    head = head->next;
+    Node **position = &sorted;
+    while (*position && (*position)->value < current->value)
+      position = &(*position)->next;
+    current->next = *position;
+    *position = current;
+  }
+  return sorted;
+}
+
+static Node *list_reverse(Node *head)
+{
+  Node *previous = NULL;
+  while (head)
+  {
+    Node *next = head->next;
+    head->next = previous;
+    previous = head;
+    head = next;
+  }
+  return previous;
+}
+
+static uint16_t list_bench(Node **list, uint16_t seed, uint16_t crc)
+{
+  Node *head = list_sort(*list);
+  int16_t found = -1;
+  for (Node *n = head; n; n = n->next)
+  {
+    if ((uint16_t)n->value == (seed & 0x7f))
+    {
+      found = n->index;
+      break;
+    }
+  }
+  crc = crc16((uint16_t)found, crc);
+  head = list_reverse(head);
+  for (Node *n = head; n; n = n->next)
+  {
+    n->value = (int16_t)((n->value * 5 + seed) & 0x7f);
+    crc = crc16((uint16_t)n->value, crc);
+  }
+  *list = head;
+  return crc;
+}
+
+static uint16_t matrix_bench(int16_t scalar, uint16_t crc)
+{
+  for (int i = 0; i < MATRIX_N * MATRIX_N; i++)
+    matrix_a[i] = (int16_t)(matrix_a[i] + scalar);
+  for (int i = 0; i < MATRIX_N; i++)
+    for (int j = 0; j < MATRIX_N; j++)
+    {
+      int32_t sum = 0;
+      for (int k = 0; k < MATRIX_N; k++)
+        sum += matrix_a[i * MATRIX_N + k] * matrix_b[k * MATRIX_N + j];
+      matrix_c[i * MATRIX_N + j] = sum;
+    }
+  for (int i = 0; i < MATRIX_N * MATRIX_N; i++)
+  {
+    crc = crc16((uint16_t)matrix_c[i], crc);
+    matrix_a[i] = (int16_t)(matrix_c[i] & 0xff);
+  }
+  return crc;
+}
+
+// Classifies the comma-separated tokens of the input as integers, decimals, scientific notation
+// or invalid, the same way the CoreMark state machine does
+enum state
+{
+  STATE_START,
+  STATE_INT,
+  STATE_FLOAT,
+  STATE_EXPONENT,
+  STATE_SCIENTIFIC,
+  STATE_INVALID,
+  STATE_COUNT
+};
+
+static uint16_t state_bench(uint16_t crc)
+{
+  uint32_t final_counts[STATE_COUNT] = {0};
+  enum state state = STATE_START;
+  for (int i = 0; i < INPUT_SIZE; i++)
+  {
+    char ch = input[i];
+    if (ch == ',')
+    {
+      final_counts[state]++;
+      state = STATE_START;
+      continue;
+    }
+    int digit = ch >= '0' && ch <= '9';
+    switch (state)
+    {
+    case STATE_START:
+      state = digit || ch == '-' ? STATE_INT : ch == '.' ? STATE_FLOAT : STATE_INVALID;
+      break;
+    case STATE_INT:
+      state = digit ? STATE_INT : ch == '.' ? STATE_FLOAT : STATE_INVALID;
+      break;
+    case STATE_FLOAT:
+      state = digit ? STATE_FLOAT : ch == 'e' ? STATE_EXPONENT : STATE_INVALID;
+      break;
+    case STATE_EXPONENT:
+      state = digit || ch == '-' ? STATE_SCIENTIFIC : STATE_INVALID;
+      break;
+    case STATE_SCIENTIFIC:
+      state = digit ? STATE_SCIENTIFIC : STATE_INVALID;
+      break;
+    default:
+      break;
+    }
+  }
+  for (int i = 0; i < STATE_COUNT; i++)
+    crc = crc16((uint16_t)final_counts[i], crc);
+  return crc;
+}
+
+uint32_t bench_coremark(uint32_t iterations)
+{
+  static const char tokens[] = "5012,1234,-874,-12,.0012,12.5e-3,8e4,1.5e,+1,0x3f,99.";
+  uint32_t state = 0x00c0ffee;
+
+  for (int i = 0; i < LIST_SIZE; i++)
+  {
+    nodes[i].value = (int16_t)(bench_random(&state) & 0x7f);
+    nodes[i].index = (int16_t)i;
+    nodes[i].next = i + 1 < LIST_SIZE ? &nodes[i + 1] : NULL;
+  }
+  for (int i = 0; i < MATRIX_N * MATRIX_N; i++)
+  {
+    matrix_a[i] = (int16_t)(bench_random(&state) & 0xff);
+    matrix_b[i] = (int16_t)(bench_random(&state) & 0xff);
+  }
+  for (int i = 0; i < INPUT_SIZE; i++)
+    input[i] = tokens[i % (sizeof(tokens) - 1)];
+
+  Node *head = &nodes[0];
+  uint16_t crc = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    crc = list_bench(&head, (uint16_t)i, crc);
+    crc = matrix_bench((int16_t)(i & 0xf), crc);
+    input[i % INPUT_SIZE] = tokens[(i * 3) % (sizeof(tokens) - 1)];
+    crc = state_bench(crc);
+  }
+  return crc;
+}
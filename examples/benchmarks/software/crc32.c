@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "bench.h"
+
+#define BUFFER_SIZE 512
+
+static uint8_t buffer[BUFFER_SIZE];
+
+// Bitwise CRC-32 (IEEE 802.3, reflected polynomial). A table-driven version would trade 1 KiB of
+// RAM for speed; the bitwise form keeps the benchmark dominated by shifts, XORs and branches.
+static uint32_t crc32(const uint8_t *data, size_t length, uint32_t crc)
+{
+  crc = ~crc;
+  while (length--)
+  {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+  }
+  return ~crc;
+}
+
+uint32_t bench_crc32(uint32_t iterations)
+{
+  uint32_t state = 0xc0ffee11;
+  for (uint32_t i = 0; i < BUFFER_SIZE; i++)
+    buffer[i] = (uint8_t)bench_random(&state);
+
+  uint32_t crc = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+    crc = crc32(buffer, BUFFER_SIZE, crc);
+  return crc;
+}
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+// Dhrystone-style synthetic workload. It follows the structure of Dhrystone 2.1 (record
+// assignments through pointers, enumeration switches, string copies and comparisons, small integer
+// arithmetic) in a compact, self-checking form. The results are not comparable to published
+// DMIPS figures, but they track the same mix of control flow and memory traffic.
+
+#include "bench.h"
+
+typedef enum
+{
+  IDENT_1,
+  IDENT_2,
+  IDENT_3,
+  IDENT_4,
+  IDENT_5
+} enumeration;
+
+typedef struct Record
+{
+  struct Record *next;
+  enumeration discriminant;
+  enumeration enum_comp;
+  int32_t int_comp;
+  char str_comp[31];
+} Record;
+
+static Record record_a;
+static Record record_b;
+static int32_t array_1[50];
+static int32_t array_2[50][50];
+static char string_1[31];
+static char string_2[31];
+static int32_t int_glob;
+static char char_glob;
+
+static void string_copy(char *dest, const char *src)
+{
+  while ((*dest++ = *src++) != '\0')
+    ;
+}
+
+static int string_compare(const char *s1, const char *s2)
+{
+  while (*s1 != '\0' && *s1 == *s2)
+  {
+    s1++;
+    s2++;
+  }
+  return (unsigned char)*s1 - (unsigned char)*s2;
+}
+
+static enumeration func_1(char ch_1, char ch_2)
+{
+  if (ch_1 != ch_2)
+    return IDENT_1;
+  char_glob = ch_1;
+  return IDENT_2;
+}
+
+static int func_2(const char *str_1, const char *str_2)
+{
+  int int_loc = 2;
+  char ch_loc = 'A';
+  while (int_loc <= 2)
+  {
+    if (func_1(str_1[int_loc], str_2[int_loc + 1]) == IDENT_1)
+    {
+      ch_loc = 'A';
+      int_loc += 1;
+    }
+  }
+  if (ch_loc >= 'W' && ch_loc < 'Z')
+    int_loc = 7;
+  if (ch_loc == 'R')
+    return 1;
+  if (string_compare(str_1, str_2) > 0)
+  {
+    int_glob = int_loc + 7;
+    return 1;
+  }
+  return 0;
+}
+
+static enumeration proc_6(enumeration value)
+{
+  switch (value)
+  {
+  case IDENT_1:
+    return IDENT_1;
+  case IDENT_2:
+    return int_glob > 100 ? IDENT_1 : IDENT_4;
+  case IDENT_3:
+    return IDENT_2;
+  case IDENT_5:
+    return IDENT_3;
+  default:
+    return IDENT_4;
+  }
+}
+
+static void proc_8(int32_t int_1, int32_t int_2)
+{
+  int32_t index = int_1 + 5;
+  array_1[index] = int_2;
+  array_1[index + 1] = array_1[index];
+  array_1[index + 30] = index;
+  for (int32_t i = index; i <= index + 1; i++)
+    array_2[index][i] = index;
+  array_2[index][index - 1] += 1;
+  array_2[index + 20][index] = array_1[index];
+  int_glob = 5;
+}
+
+static void proc_1(Record *ptr)
+{
+  Record *next = ptr->next;
+  *next = *ptr;
+  ptr->int_comp = 5;
+  next->int_comp = ptr->int_comp;
+  next->next = ptr->next;
+  if (next->discriminant == IDENT_1)
+  {
+    next->int_comp = 6;
+    next->enum_comp = proc_6(ptr->enum_comp);
+    next->next = ptr->next;
+    next->int_comp = next->int_comp + 10 + int_glob;
+  }
+  else
+    *ptr = *next;
+}
+
+uint32_t bench_dhrystone(uint32_t iterations)
+{
+  record_a.next = &record_b;
+  record_a.discriminant = IDENT_1;
+  record_a.enum_comp = IDENT_3;
+  record_a.int_comp = 40;
+  string_copy(record_a.str_comp, "DHRYSTONE PROGRAM, SOME STRING");
+  string_copy(string_1, "DHRYSTONE PROGRAM, 1'ST STRING");
+  int_glob = 0;
+
+  uint32_t checksum = 0;
+  for (uint32_t run = 1; run <= iterations; run++)
+  {
+    int32_t int_1 = 2;
+    int32_t int_2 = 3;
+    int32_t int_3 = 0;
+    string_copy(string_2, "DHRYSTONE PROGRAM, 2'ND STRING");
+    string_2[7] = (char)('A' + (run & 0xf));
+    int bool_glob = !func_2(string_1, string_2);
+    while (int_1 < int_2)
+    {
+      int_3 = 5 * int_1 - int_2;
+      int_3 = int_1 + int_3 + 2;
+      int_1 += 1;
+    }
+    proc_8(int_1, int_3);
+    proc_1(&record_a);
+    for (char ch = 'A'; ch <= char_glob; ch++)
+    {
+      if (proc_6(IDENT_3) == func_1(ch, 'C'))
+        int_3 = (int32_t)run;
+    }
+    int_2 = int_2 * int_1;
+    int_1 = int_2 / int_3;
+    int_2 = 7 * (int_2 - int_3) - int_1;
+    checksum = checksum * 31 + (uint32_t)(int_1 + int_2 + int_3 + bool_glob) +
+               (uint32_t)record_b.int_comp + (uint32_t)array_2[8][7];
+  }
+  return checksum;
+}
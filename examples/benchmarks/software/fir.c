@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "bench.h"
+
+#define TAPS 16
+#define SAMPLES 128
+
+// Low-pass filter coefficients in Q15 format (symmetric)
+static const int16_t coefficients[TAPS] = {
+    -120, -260, -180, 420, 1510, 2890, 4080, 4620, 4620, 4080, 2890, 1510, 420, -180, -260, -120,
+};
+
+static int16_t input[SAMPLES + TAPS - 1];
+static int16_t output[SAMPLES];
+
+static void fir(const int16_t *x, int16_t *y, size_t samples)
+{
+  for (size_t n = 0; n < samples; n++)
+  {
+    int32_t acc = 0;
+    for (size_t k = 0; k < TAPS; k++)
+      acc += (int32_t)coefficients[k] * x[n + k];
+    y[n] = (int16_t)(acc >> 15);
+  }
+}
+
+uint32_t bench_fir(uint32_t iterations)
+{
+  uint32_t state = 0x0badf00d;
+  for (uint32_t i = 0; i < SAMPLES + TAPS - 1; i++)
+    input[i] = (int16_t)(bench_random(&state) >> 18) - 8192;
+
+  uint32_t checksum = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    fir(input, output, SAMPLES);
+    input[i % SAMPLES] = output[(i * 5) % SAMPLES];
+    for (uint32_t n = 0; n < SAMPLES; n++)
+      checksum = (checksum << 3 | checksum >> 29) ^ (uint16_t)output[n];
+  }
+  return checksum;
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "bench.h"
+
+// Characters written to this address are printed by the simulator (mcu_sim --host-out)
+#define HOST_OUT (*(volatile uint32_t *)0x90000000)
+
+// Writing 1 to this address ends the simulation (mcu_sim --wr-addr)
+#define HOST_EXIT (*(volatile uint32_t *)0x90000004)
+
+typedef struct
+{
+  const char *name;
+  bench_kernel kernel;
+  uint32_t iterations;
+  uint32_t expected;
+} Benchmark;
+
+// Reference checksums were obtained by running the same kernels on a host machine
+static const Benchmark benchmarks[] = {
+    {"coremark", bench_coremark, 20, 0x0000fa2f},
+    {"dhrystone", bench_dhrystone, 200, 0xa56568d8},
+    {"memcpy", bench_memcpy, 20, 0xfa9982fa},
+    {"memset", bench_memset, 20, 0xc6ef6622},
+    {"crc32", bench_crc32, 4, 0x82e01b17},
+    {"fir", bench_fir, 10, 0xb78045f1},
+    {"matmul", bench_matmul, 10, 0xc11478d0},
+    {"bitops", bench_bitops, 10, 0xad9b7c7a},
+};
+
+// Reads a 64-bit counter whose halves are separate CSRs, retrying if the low half wraps around
+#define READ_CSR64(low, high)                                                                      \
+  uint32_t hi, lo, hi2;                                                                            \
+  do                                                                                               \
+  {                                                                                                \
+    __asm__ volatile("csrr %0, " #high : "=r"(hi));                                                \
+    __asm__ volatile("csrr %0, " #low : "=r"(lo));                                                 \
+    __asm__ volatile("csrr %0, " #high : "=r"(hi2));                                               \
+  } while (hi != hi2);                                                                             \
+  return ((uint64_t)hi << 32) | lo;
+
+static inline uint64_t read_mcycle(void)
+{
+  READ_CSR64(mcycle, mcycleh)
+}
+
+static inline uint64_t read_minstret(void)
+{
+  READ_CSR64(minstret, minstreth)
+}
+
+// Kept out of line so consecutive characters are separate bus writes the simulator can detect
+static void __attribute__((noinline)) put_char(char c)
+{
+  HOST_OUT = (uint8_t)c;
+}
+
+static void put_string(const char *s)
+{
+  while (*s)
+    put_char(*s++);
+}
+
+static void put_hex(uint64_t value)
+{
+  // Prints the value without leading zeros to keep the output short
+  int started = 0;
+  for (int shift = 60; shift >= 0; shift -= 4)
+  {
+    uint32_t digit = (uint32_t)(value >> shift) & 0xf;
+    if (digit || started || shift == 0)
+    {
+      put_char((char)(digit < 10 ? '0' + digit : 'a' + digit - 10));
+      started = 1;
+    }
+  }
+}
+
+// Output format, one line per kernel (numbers in hexadecimal):
+// bench <name> <iterations> <cycles> <instructions retired> <checksum> <pass|fail>
+void main(void)
+{
+  for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++)
+  {
+    const Benchmark *b = &benchmarks[i];
+
+    uint64_t cycles_start = read_mcycle();
+    uint64_t instret_start = read_minstret();
+    uint32_t checksum = b->kernel(b->iterations);
+    uint64_t instret_end = read_minstret();
+    uint64_t cycles_end = read_mcycle();
+
+    put_string("bench ");
+    put_string(b->name);
+    put_char(' ');
+    put_hex(b->iterations);
+    put_char(' ');
+    put_hex(cycles_end - cycles_start);
+    put_char(' ');
+    put_hex(instret_end - instret_start);
+    put_char(' ');
+    put_hex(checksum);
+    put_string(checksum == b->expected ? " pass\n" : " fail\n");
+  }
+
+  HOST_EXIT = 1;
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "bench.h"
+
+#define N 12
+
+static int32_t a[N][N];
+static int32_t b[N][N];
+static int32_t c[N][N];
+
+static void matmul(void)
+{
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+    {
+      int32_t sum = 0;
+      for (int k = 0; k < N; k++)
+        sum += a[i][k] * b[k][j];
+      c[i][j] = sum;
+    }
+}
+
+uint32_t bench_matmul(uint32_t iterations)
+{
+  uint32_t state = 0x600dcafe;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+    {
+      a[i][j] = (int32_t)(bench_random(&state) & 0x3ff) - 512;
+      b[i][j] = (int32_t)(bench_random(&state) & 0x3ff) - 512;
+    }
+
+  uint32_t checksum = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    matmul();
+    a[i % N][(i * 3) % N] = c[(i * 5) % N][i % N] & 0x3ff;
+    for (int r = 0; r < N; r++)
+      for (int s = 0; s < N; s++)
+        checksum = (checksum << 1 | checksum >> 31) + (uint32_t)c[r][s];
+  }
+  return checksum;
+}
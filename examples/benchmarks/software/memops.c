@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "bench.h"
+
+#define BUFFER_SIZE 1024
+
+static uint32_t source[BUFFER_SIZE / 4];
+static uint32_t target[BUFFER_SIZE / 4];
+
+// The implementations below are also the ones the compiler calls for structure copies and
+// initializations, since the application is linked without a C library. RVX does not support
+// unaligned accesses, so the word loop is only taken when both pointers are word aligned.
+
+void *memcpy(void *dest, const void *src, size_t n)
+{
+  uint8_t *d = dest;
+  const uint8_t *s = src;
+  if ((((uintptr_t)d | (uintptr_t)s) & 0x3) == 0)
+  {
+    uint32_t *dw = (uint32_t *)d;
+    const uint32_t *sw = (const uint32_t *)s;
+    for (; n >= 16; n -= 16)
+    {
+      dw[0] = sw[0];
+      dw[1] = sw[1];
+      dw[2] = sw[2];
+      dw[3] = sw[3];
+      dw += 4;
+      sw += 4;
+    }
+    for (; n >= 4; n -= 4)
+      *dw++ = *sw++;
+    d = (uint8_t *)dw;
+    s = (const uint8_t *)sw;
+  }
+  while (n--)
+    *d++ = *s++;
+  return dest;
+}
+
+void *memset(void *s, int c, size_t n)
+{
+  uint8_t *d = s;
+  if (((uintptr_t)d & 0x3) == 0)
+  {
+    uint32_t word = (uint8_t)c;
+    word |= word << 8;
+    word |= word << 16;
+    uint32_t *dw = (uint32_t *)d;
+    for (; n >= 16; n -= 16)
+    {
+      dw[0] = word;
+      dw[1] = word;
+      dw[2] = word;
+      dw[3] = word;
+      dw += 4;
+    }
+    for (; n >= 4; n -= 4)
+      *dw++ = word;
+    d = (uint8_t *)dw;
+  }
+  while (n--)
+    *d++ = (uint8_t)c;
+  return s;
+}
+
+static uint32_t buffer_checksum(const uint32_t *buffer)
+{
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < BUFFER_SIZE / 4; i++)
+    sum = (sum << 1 | sum >> 31) ^ buffer[i];
+  return sum;
+}
+
+uint32_t bench_memcpy(uint32_t iterations)
+{
+  uint32_t state = 0x1234abcd;
+  for (uint32_t i = 0; i < BUFFER_SIZE / 4; i++)
+    source[i] = bench_random(&state);
+
+  uint32_t checksum = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    // Alternate between aligned and byte-offset copies so both paths are measured
+    size_t offset = i & 0x3;
+    memcpy((uint8_t *)target + offset, (uint8_t *)source + offset, BUFFER_SIZE - 4);
+    source[i % (BUFFER_SIZE / 4)] ^= target[(i * 7) % (BUFFER_SIZE / 4)];
+    checksum += buffer_checksum(target);
+  }
+  return checksum;
+}
+
+uint32_t bench_memset(uint32_t iterations)
+{
+  uint32_t checksum = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    size_t offset = i & 0x3;
+    memset((uint8_t *)target + offset, (int)(i + 0x5a), BUFFER_SIZE - 4);
+    checksum += buffer_checksum(target);
+  }
+  return checksum;
+}
@@ -7,6 +7,9 @@ module rvx #(
   parameter CLOCK_FREQUENCY = 50000000  ,
   // Desired baud rate for UART unit
   parameter UART_BAUD_RATE = 9600       ,
+  // Number of bytes of the UART receive and transmit FIFOs (1 to 255)
+  parameter UART_RX_FIFO_DEPTH = 16     ,
+  parameter UART_TX_FIFO_DEPTH = 16     ,
   // Memory size in bytes - must be a power of 2
   parameter MEMORY_SIZE = 8192          ,
   // Text file with program and data (one hex value per line)
@@ -16,7 +19,17 @@ module rvx #(
   // Number of available I/O ports
   parameter GPIO_WIDTH = 1              ,
   // Number of CS (Chip Select) pins for the SPI controller
-  parameter SPI_NUM_CHIP_SELECT = 1
+  parameter SPI_NUM_CHIP_SELECT = 1     ,
+  // Set to 1 to implement the M extension (multiplication and division)
+  parameter M_EXTENSION = 0             ,
+  // Set to 1 to implement the C extension (compressed instructions)
+  parameter C_EXTENSION = 0             ,
+  // Set to 1 to implement the Zba and Zbb extensions (bit manipulation)
+  parameter ZBA_ZBB_EXTENSION = 0       ,
+  // Set to 1 to fetch instructions through a second port of the memory (Harvard architecture)
+  parameter HARVARD = 0                 ,
+  // Number of jump targets kept in a buffer of the core, 0 for none (needs C_EXTENSION = 1)
+  parameter BRANCH_TARGET_BUFFER = 0
 
   ) (
 
@@ -51,7 +64,7 @@ module rvx #(
   assign device_region_size   [32*D0_RAM      +: 32]  = MEMORY_SIZE;
 
   assign device_start_address [32*D1_UART     +: 32]  = 32'h8000_0000;
-  assign device_region_size   [32*D1_UART     +: 32]  = 16;
+  assign device_region_size   [32*D1_UART     +: 32]  = 32;
 
   assign device_start_address [32*D2_MTIMER   +: 32]  = 32'h8001_0000;
   assign device_region_size   [32*D2_MTIMER   +: 32]  = 32;
@@ -62,6 +75,14 @@ module rvx #(
   assign device_start_address [32*D4_SPI      +: 32]  = 32'h8003_0000;
   assign device_region_size   [32*D4_SPI      +: 32]  = 32;
 
+  // RVX 32-bit Processor instruction fetch <=> Second RAM port (used if HARVARD = 1, the system
+  // bus then only carries loads and stores)
+
+  wire  [31:0]                instruction_read_address  ;
+  wire  [31:0]                instruction_read_data     ;
+  wire                        instruction_read_request  ;
+  wire                        instruction_read_response ;
+
   // RVX 32-bit Processor (Manager Device) <=> System Bus
 
   wire  [31:0]                manager_rw_address      ;
@@ -116,7 +137,12 @@ module rvx #(
 
   rvx_core #(
 
-    .BOOT_ADDRESS                   (BOOT_ADDRESS                       )
+    .BOOT_ADDRESS                   (BOOT_ADDRESS                       ),
+    .M_EXTENSION                    (M_EXTENSION                        ),
+    .C_EXTENSION                    (C_EXTENSION                        ),
+    .ZBA_ZBB_EXTENSION              (ZBA_ZBB_EXTENSION                  ),
+    .HARVARD                        (HARVARD                            ),
+    .BRANCH_TARGET_BUFFER           (BRANCH_TARGET_BUFFER               )
 
   ) rvx_core_instance (
 
@@ -137,6 +163,13 @@ module rvx #(
     .write_request                  (manager_write_request              ),
     .write_response                 (manager_write_response             ),
 
+    // Instruction fetch interface
+
+    .instruction_read_address       (instruction_read_address           ),
+    .instruction_read_data          (instruction_read_data              ),
+    .instruction_read_request       (instruction_read_request           ),
+    .instruction_read_response      (instruction_read_response          ),
+
     // Interrupt request signals
 
     .irq_fast                       (irq_fast                           ),
@@ -200,7 +233,8 @@ module rvx #(
   rvx_ram #(
 
     .MEMORY_SIZE                    (MEMORY_SIZE                        ),
-    .MEMORY_INIT_FILE               (MEMORY_INIT_FILE                   )
+    .MEMORY_INIT_FILE               (MEMORY_INIT_FILE                   ),
+    .DUAL_PORT                      (HARVARD                            )
 
   ) rvx_ram_instance (
 
@@ -218,14 +252,24 @@ module rvx #(
     .write_data                     (device_write_data                  ),
     .write_strobe                   (device_write_strobe                ),
     .write_request                  (device_write_request[D0_RAM]       ),
-    .write_response                 (device_write_response[D0_RAM]      )
+    .write_response                 (device_write_response[D0_RAM]      ),
+
+    // Instruction fetch interface
+
+    .instruction_read_address       (instruction_read_address           ),
+    .instruction_read_data          (instruction_read_data              ),
+    .instruction_read_request       (instruction_read_request           ),
+    .instruction_read_response      (instruction_read_response          )
 
   );
 
   rvx_uart #(
 
     .CLOCK_FREQUENCY                (CLOCK_FREQUENCY                    ),
-    .UART_BAUD_RATE                 (UART_BAUD_RATE                     )
+    .UART_BAUD_RATE                 (UART_BAUD_RATE                     ),
+    .RX_FIFO_DEPTH                  (UART_RX_FIFO_DEPTH                 ),
+    .TX_FIFO_DEPTH                  (UART_TX_FIFO_DEPTH                 ),
+    .REPEATED_REQUESTS              (HARVARD == 0 ? 1 : 0               )
 
   ) rvx_uart_instance (
 
@@ -240,7 +284,7 @@ module rvx #(
     .read_data                      (device_read_data[32*D1_UART +: 32] ),
     .read_request                   (device_read_request[D1_UART]       ),
     .read_response                  (device_read_response[D1_UART]      ),
-    .write_data                     (device_write_data[7:0]             ),
+    .write_data                     (device_write_data[15:0]            ),
     .write_request                  (device_write_request[D1_UART]      ),
     .write_response                 (device_write_response[D1_UART]     ),
 
@@ -67,6 +67,10 @@ module rvx_bus #(
     end
   end
 
+  // The devices respond in the cycle after the request, when the manager may already drive the
+  // address of its next request, so the response is selected by the device of the previous cycle
+  // (hardware/tests/bus checks it with back-to-back accesses)
+
   always @(posedge clock) begin
     if (reset)
       device_sel_save <= {NUM_DEVICES{1'b0}};
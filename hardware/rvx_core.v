@@ -3,7 +3,26 @@
 
 module rvx_core #(
 
-  parameter     [31:0]  BOOT_ADDRESS = 32'h00000000
+  parameter     [31:0]  BOOT_ADDRESS = 32'h00000000,
+
+  // Set to 1 to implement the M extension (integer multiplication and division)
+  parameter             M_EXTENSION = 0,
+
+  // Set to 1 to implement the C extension (compressed instructions)
+  parameter             C_EXTENSION = 0,
+
+  // Set to 1 to implement the Zba and Zbb extensions (address generation and basic bit
+  // manipulation)
+  parameter             ZBA_ZBB_EXTENSION = 0,
+
+  // Set to 1 to fetch instructions through a separate port (Harvard architecture), so loads and
+  // stores on the IO interface overlap with the fetch of the next instruction
+  parameter             HARVARD = 0,
+
+  // Number of jump targets whose first half is kept in a buffer, so that a jump to a 32-bit
+  // instruction at an address ending in 2 does not wait for its second half, 0 for none. Only used
+  // if C_EXTENSION = 1
+  parameter             BRANCH_TARGET_BUFFER = 0
 
   ) (
 
@@ -24,6 +43,13 @@ module rvx_core #(
   output wire           write_request,
   input  wire           write_response,
 
+  // Instruction fetch interface (used if HARVARD = 1, hardwire inputs to zero otherwise)
+
+  output wire   [31:0]  instruction_read_address,
+  input  wire   [31:0]  instruction_read_data,
+  output wire           instruction_read_request,
+  input  wire           instruction_read_response,
+
   // Interrupt signals (hardwire inputs to zero if unused)
 
   input  wire           irq_external,
@@ -90,6 +116,8 @@ module rvx_core #(
   localparam WB_TARGET_ADDER      = 3'b011;
   localparam WB_CSR               = 3'b100;
   localparam WB_PC_PLUS_4         = 3'b101;
+  localparam WB_MULDIV            = 3'b110;
+  localparam WB_BITMANIP          = 3'b111;
 
   // Immediate format selection
 
@@ -130,6 +158,15 @@ module rvx_core #(
 
   localparam NOP_INSTRUCTION      = 32'h00000013;
 
+  // Bits of the index of the branch target buffer entries, its last value and its increment
+
+  localparam BTB_INDEX_WIDTH      = BRANCH_TARGET_BUFFER > 1 ? $clog2(BRANCH_TARGET_BUFFER) : 1;
+  localparam BTB_LAST             = BRANCH_TARGET_BUFFER > 1 ? BRANCH_TARGET_BUFFER - 1 : 0;
+
+  localparam [BTB_INDEX_WIDTH-1:0] BTB_LAST_INDEX =
+    BTB_LAST[BTB_INDEX_WIDTH-1:0];
+  localparam [BTB_INDEX_WIDTH-1:0] BTB_NEXT_INDEX = 1;
+
   // Opcodes
 
   localparam OPCODE_OP            = 7'b0110011;
@@ -196,6 +233,7 @@ module rvx_core #(
   localparam FUNCT7_ECALL         = 7'b0000000;
   localparam FUNCT7_EBREAK        = 7'b0000000;
   localparam FUNCT7_MRET          = 7'b0011000;
+  localparam FUNCT7_MULDIV        = 7'b0000001;
 
   // RS1, RS2 and RD encodings for SYSTEM instructions
 
@@ -226,6 +264,7 @@ module rvx_core #(
   wire  [31:0]  alu_srl_result;
   reg           branch_condition_satisfied;
   wire  [31:0]  branch_target_address;
+  wire          bus_stall;
   wire          clock_enable;
   wire  [31:0]  csr_data_mask;
   reg   [31:0]  csr_data_out;
@@ -257,8 +296,15 @@ module rvx_core #(
   reg   [63:0]  csr_utime;
   reg   [31:0]  csr_write_data;
   reg   [3:0 ]  current_state;
+  wire          data_port_hold;
+  wire          data_port_stall;
   wire          ebreak;
   wire          ecall;
+  wire  [31:0]  fetch_address;
+  wire  [31:0]  fetch_read_data;
+  wire          fetch_second_half;
+  wire  [31:0]  fetched_instruction;
+  wire          fetched_instruction_compressed;
   wire          flush;
   wire          illegal_instruction;
   reg   [31:0]  immediate;
@@ -275,6 +321,8 @@ module rvx_core #(
   wire          integer_file_write_request;
   wire  [31:0]  instruction;
   wire  [31:0]  instruction_address;
+  wire          instruction_compressed;
+  wire          instruction_port_stall;
   wire  [2:0 ]  instruction_funct3;
   wire  [6:0 ]  instruction_funct7;
   wire  [6:0 ]  instruction_opcode;
@@ -290,20 +338,30 @@ module rvx_core #(
   reg   [31:0]  load_data;
   reg   [15:0]  load_half_data;
   wire  [15:0]  load_half_upper_bits;
+  wire  [1:0 ]  load_offset;
   wire          load_pending;
   wire          load_request;
   wire  [1:0 ]  load_size;
   wire          load_unsigned;
+  wire          load_writeback;
+  reg   [2:0 ]  load_writeback_funct3;
+  reg   [1:0 ]  load_writeback_offset;
+  reg   [4:0 ]  load_writeback_rd;
   wire          misaligned_address_exception;
   wire          misaligned_instruction_address;
   wire          misaligned_load;
   wire          misaligned_store;
   wire          mret;
+  wire          muldiv;
+  wire  [31:0]  muldiv_output;
+  wire          muldiv_stall;
   wire  [31:0]  next_address;
   reg   [31:0]  next_program_counter;
   reg   [3:0 ]  next_state;
   reg   [31:0]  prev_instruction;
   reg   [31:0]  prev_instruction_address;
+  reg           prev_instruction_compressed;
+  reg           prev_instruction_read_request;
   reg           prev_load_request;
   reg           prev_read_request;
   reg   [31:0]  prev_rw_address;
@@ -317,7 +375,9 @@ module rvx_core #(
   reg           reset_reg;
   wire  [31:0]  rs1_data;
   wire  [31:0]  rs2_data;
+  wire          read_request_internal;
   wire  [31:0]  rw_address_internal;
+  wire  [31:0]  sequential_address;
   wire          store;
   reg   [31:0]  store_byte_data;
   wire          store_commit_cycle;
@@ -365,6 +425,8 @@ module rvx_core #(
   wire          sll;
   wire          srl;
   wire          sra;
+  wire          bitmanip;
+  wire  [31:0]  bitmanip_output;
   wire          csrxxx;
   wire          illegal_store;
   wire          illegal_load;
@@ -387,6 +449,7 @@ module rvx_core #(
   wire          is_greater_or_equal_than_unsigned;
   wire          interrupt_pending;
   wire          exception_pending;
+  wire          instruction_retired;
 
   //-----------------------------------------------------------------------------------------------//
   // Global signals                                                                                //
@@ -397,13 +460,38 @@ module rvx_core #(
 
   assign reset_internal = reset | reset_reg;
 
-  assign clock_enable = !( halt                |
-    (prev_read_request   & !read_response    ) |
-    (prev_write_request  & !write_response   ) );
+  assign bus_stall =
+    halt            |
+    data_port_stall |
+    instruction_port_stall;
+
+  assign data_port_stall =
+    (prev_read_request   & !read_response ) |
+    (prev_write_request  & !write_response);
+
+  assign instruction_port_stall =
+    prev_instruction_read_request & !instruction_read_response;
+
+  // A division holds the pipeline like a bus stall, but the instruction keeps being fetched again
+  // from the same address so it stays in the execution stage
+  assign clock_enable =
+    !(bus_stall | muldiv_stall);
 
   always @(posedge clock) begin
     if (reset_internal) begin
-      prev_instruction_address  <= BOOT_ADDRESS;
+      prev_instruction_address      <= BOOT_ADDRESS;
+      prev_instruction_read_request <= 1'b0;
+    end
+    else if(clock_enable) begin
+      prev_instruction_address      <= instruction_address;
+      prev_instruction_read_request <= instruction_read_request;
+    end
+  end
+
+  // With HARVARD = 1 the data port only repeats a request until its response, in the other cycles
+  // without clock_enable (division, fetch wait, halt) it is idle
+  always @(posedge clock) begin
+    if (reset_internal) begin
       prev_load_request         <= 1'b0;
       prev_rw_address           <= 32'h00000000;
       prev_read_request         <= 1'b0;
@@ -411,8 +499,7 @@ module rvx_core #(
       prev_write_request        <= 1'b0;
       prev_write_strobe         <= 4'b0000;
     end
-    else if(clock_enable) begin
-      prev_instruction_address  <= instruction_address;
+    else if(clock_enable | HARVARD != 0) begin
       prev_load_request         <= load_request;
       prev_rw_address           <= rw_address;
       prev_read_request         <= read_request;
@@ -430,14 +517,31 @@ module rvx_core #(
     reset ?
     BOOT_ADDRESS :
     (clock_enable ?
-      next_program_counter :
+      fetch_address :
       prev_instruction_address);
 
+  // With HARVARD = 1 every cycle fetches through the instruction port, the IO interface is only
+  // used by loads and stores
+  assign instruction_read_address =
+    instruction_address;
+
+  assign instruction_read_request =
+    HARVARD != 0 & !reset_internal;
+
+  assign fetch_read_data =
+    HARVARD != 0 ?
+    instruction_read_data :
+    read_data;
+
     always @(posedge clock)
-    if (reset_internal)
-      prev_instruction <= NOP_INSTRUCTION;
-    else
-      prev_instruction <= instruction;
+    if (reset_internal) begin
+      prev_instruction            <= NOP_INSTRUCTION;
+      prev_instruction_compressed <= 1'b0;
+    end
+    else begin
+      prev_instruction            <= instruction;
+      prev_instruction_compressed <= instruction_compressed;
+    end
 
   always @* begin : next_program_counter_mux
     case (program_counter_source)
@@ -451,6 +555,12 @@ module rvx_core #(
   assign program_counter_plus_4 =
     program_counter + 32'h00000004;
 
+  // Address of the instruction that follows, also the return address of jumps
+  assign sequential_address =
+    instruction_compressed ?
+    program_counter + 32'h00000002 :
+    program_counter_plus_4;
+
   assign target_address_adder =
     target_address_source == 1'b1 ?
     rs1_data + immediate :
@@ -459,10 +569,13 @@ module rvx_core #(
   assign branch_target_address =
     {target_address_adder[31:1], 1'b0};
 
+  // The program counter stays while the second half of an instruction is fetched
   assign next_address =
-   take_branch ?
-   branch_target_address :
-   program_counter_plus_4;
+   fetch_second_half ?
+   program_counter :
+   (take_branch ?
+     branch_target_address :
+     sequential_address);
 
   always @(posedge clock) begin : program_counter_reg_implementation
     if (reset_internal)
@@ -472,11 +585,18 @@ module rvx_core #(
   end
 
   assign instruction =
-    flush ?
+    flush | fetch_second_half ?
     NOP_INSTRUCTION :
-    (!clock_enable | load_commit_cycle | store_commit_cycle) ?
+    (bus_stall | load_commit_cycle | store_commit_cycle) ?
       prev_instruction :
-      read_data;
+      fetched_instruction;
+
+  assign instruction_compressed =
+    flush | fetch_second_half ?
+    1'b0 :
+    (bus_stall | load_commit_cycle | store_commit_cycle) ?
+      prev_instruction_compressed :
+      fetched_instruction_compressed;
 
   assign instruction_opcode =
     instruction[6:0];
@@ -507,8 +627,8 @@ module rvx_core #(
     reset_internal ?
     1'b0 :
     (clock_enable ?
-      ~store_request :
-      prev_read_request);
+      read_request_internal :
+      prev_read_request & data_port_hold);
 
   assign rw_address =
     reset_internal ?
@@ -522,7 +642,7 @@ module rvx_core #(
     1'b0 :
     (clock_enable ?
       store_request :
-      prev_write_request);
+      prev_write_request & data_port_hold);
 
   assign write_data =
     reset_internal ?
@@ -538,17 +658,41 @@ module rvx_core #(
       write_strobe_internal :
       prev_write_strobe);
 
+  assign data_port_hold =
+    HARVARD == 0 | data_port_stall;
+
+  // With a single port a load or store takes two cycles: the instruction stays in the execution
+  // stage until the commit cycle, in which the next one is fetched. With HARVARD = 1 it is fetched
+  // at the same time, so loads and stores take one cycle. The load data is then written back
+  // while the next instruction executes (load_writeback).
+
   assign load_commit_cycle =
-    prev_load_request & read_response;
+    HARVARD == 0 & prev_load_request & read_response;
 
   assign store_commit_cycle =
-    prev_write_request & write_response;
+    HARVARD == 0 & prev_write_request & write_response;
 
   assign load_pending =
-    load  & !load_commit_cycle;
+    HARVARD == 0 & load  & !load_commit_cycle;
 
   assign store_pending =
-    store & !store_commit_cycle;
+    HARVARD == 0 & store & !store_commit_cycle;
+
+  assign load_writeback =
+    HARVARD != 0 & prev_read_request & read_response;
+
+  always @(posedge clock) begin
+    if (reset_internal) begin
+      load_writeback_rd     <= 5'b00000;
+      load_writeback_funct3 <= 3'b000;
+      load_writeback_offset <= 2'b00;
+    end
+    else if (clock_enable & load_request) begin
+      load_writeback_rd     <= instruction_rd_address;
+      load_writeback_funct3 <= instruction_funct3;
+      load_writeback_offset <= target_address_adder[1:0];
+    end
+  end
 
   assign load_request =
     load  & ~misaligned_load  & ~take_trap & ~load_commit_cycle;
@@ -556,6 +700,11 @@ module rvx_core #(
   assign store_request =
     store & ~misaligned_store & ~take_trap & ~store_commit_cycle;
 
+  assign read_request_internal =
+    HARVARD != 0 ?
+    load_request :
+    ~store_request;
+
   assign rw_address_internal =
     load_request | store_request ?
     {target_address_adder[31:2], 2'b00} :
@@ -775,6 +924,11 @@ module rvx_core #(
     instruction_rs2_address == RS2_MRET &
     instruction_rd_address  == RD_MRET;
 
+  assign muldiv =
+    M_EXTENSION != 0 &
+    op_type &
+    instruction_funct7 == FUNCT7_MULDIV;
+
   // Illegal instruction detection
 
   assign illegal_store =
@@ -799,11 +953,11 @@ module rvx_core #(
 
   assign illegal_op =
     op_type &
-    ~(add | sub | slt | sltu | is_and | is_or | is_xor | sll | srl | sra);
+    ~(add | sub | slt | sltu | is_and | is_or | is_xor | sll | srl | sra | muldiv | bitmanip);
 
   assign illegal_op_imm =
     op_imm_type &
-    ~(addi | slti | sltiu | andi | ori | xori | slli | srli | srai);
+    ~(addi | slti | sltiu | andi | ori | xori | slli | srli | srai | bitmanip);
 
   assign illegal_system =
     system_type &
@@ -853,12 +1007,22 @@ module rvx_core #(
     store_type &
     ~illegal_store;
 
+  // With HARVARD = 1 the load data arrives after the load has left the execution stage
   assign load_size =
+    HARVARD != 0 ?
+    load_writeback_funct3[1:0] :
     instruction_funct3[1:0];
 
   assign load_unsigned =
+    HARVARD != 0 ?
+    load_writeback_funct3[2] :
     instruction_funct3[2];
 
+  assign load_offset =
+    HARVARD != 0 ?
+    load_writeback_offset :
+    target_address_adder[1:0];
+
   assign alu_2nd_operand_source =
     instruction_opcode[5];
 
@@ -874,7 +1038,11 @@ module rvx_core #(
   assign csr_operation = instruction_funct3;
 
   always @* begin : writeback_selector_decoding
-    if (op_type == 1'b1 || op_imm_type == 1'b1)
+    if (muldiv == 1'b1)
+      writeback_mux_selector = WB_MULDIV;
+    else if (bitmanip == 1'b1)
+      writeback_mux_selector = WB_BITMANIP;
+    else if (op_type == 1'b1 || op_imm_type == 1'b1)
       writeback_mux_selector = WB_ALU;
     else if (load_type == 1'b1)
       writeback_mux_selector = WB_LOAD_UNIT;
@@ -1038,26 +1206,37 @@ module rvx_core #(
   // Integer File implementation                                                                   //
   //-----------------------------------------------------------------------------------------------//
 
+  // With HARVARD = 1 loads write back through a second port, in the cycle their data arrives. The
+  // instruction executing in that cycle reads the data forwarded, and its own result is written
+  // last if both have the same destination register
   assign integer_file_write_enable =
-    integer_file_write_request & !flush & !load_pending;
+    integer_file_write_request & !flush & !load_pending & !(HARVARD != 0 & load_type);
 
   integer i;
   always @(posedge clock) begin
     if (reset_internal)
       for (i = 1; i < 32; i = i + 1) integer_file[i] <= 32'h00000000;
-    else if (clock_enable & integer_file_write_enable)
-      integer_file[instruction_rd_address] <= writeback_multiplexer_output;
+    else begin
+      if (load_writeback)
+        integer_file[load_writeback_rd] <= load_data;
+      if (clock_enable & integer_file_write_enable)
+        integer_file[instruction_rd_address] <= writeback_multiplexer_output;
+    end
   end
 
   assign rs1_data =
     instruction_rs1_address == 5'b00000 ?
     32'h00000000 :
-    integer_file[instruction_rs1_address];
+    (load_writeback & instruction_rs1_address == load_writeback_rd ?
+      load_data :
+      integer_file[instruction_rs1_address]);
 
   assign rs2_data =
     instruction_rs2_address == 5'b00000 ?
     32'h00000000 :
-    integer_file[instruction_rs2_address];
+    (load_writeback & instruction_rs2_address == load_writeback_rd ?
+      load_data :
+      integer_file[instruction_rs2_address]);
 
   //---------------------------------------------------------------------------------------------//
   // M-mode logic and hart control                                                               //
@@ -1107,7 +1286,7 @@ module rvx_core #(
   always @(posedge clock) begin : m_mode_fsm_current_state_register
     if(reset_internal)
       current_state <= STATE_RESET;
-    else if (clock_enable | interrupt_pending)
+    else if (clock_enable | (interrupt_pending & !muldiv_stall))
       current_state <= next_state;
   end
 
@@ -1181,7 +1360,9 @@ module rvx_core #(
       INSTRETH:      csr_data_out = csr_minstret  [63:32];
       MSTATUS:       csr_data_out = csr_mstatus;
       MSTATUSH:      csr_data_out = 32'h00000000;
-      MISA:          csr_data_out = 32'h40000100; // RV32I base ISA only
+      MISA:          csr_data_out = 32'h40000100 |                           // RV32I
+                                    (M_EXTENSION != 0 ? 32'h00001000 : 32'h0) | // M
+                                    (C_EXTENSION != 0 ? 32'h00000004 : 32'h0);  // C
       MIE:           csr_data_out = csr_mie;
       MTVEC:         csr_data_out = csr_mtvec;
       MSCRATCH:      csr_data_out = csr_mscratch;
@@ -1200,8 +1381,9 @@ module rvx_core #(
   assign csr_file_write_enable =
     csr_file_write_request & !flush;
 
+  // Any even address is aligned with the C extension
   assign misaligned_instruction_address =
-    take_branch & next_address[1];
+    C_EXTENSION == 0 & take_branch & next_address[1];
 
   //---------------------------------------------------------------------------------------------//
   // mstatus : M-mode Status register                                                            //
@@ -1309,7 +1491,7 @@ module rvx_core #(
       if(take_trap)
         csr_mepc <= program_counter;
       else if(current_state == STATE_OPERATING && instruction_csr_address == MEPC && csr_file_write_enable)
-        csr_mepc <= {csr_write_data[31:2], 2'b00};
+        csr_mepc <= {csr_write_data[31:2], csr_write_data[1] & C_EXTENSION != 0, 1'b0};
     end
   end
 
@@ -1345,6 +1527,13 @@ module rvx_core #(
   // minstret : M-mode Instruction Retired Counter register                                      //
   //---------------------------------------------------------------------------------------------//
 
+  // Loads and stores hold the program counter for an extra cycle (unless HARVARD = 1) and trapped
+  // instructions do not retire, so those cycles are not counted, nor the one that fetches the
+  // second half of an instruction
+  assign instruction_retired =
+    current_state == STATE_OPERATING & !load_pending & !store_pending & !take_trap &
+    !fetch_second_half;
+
   always @(posedge clock) begin : minstret_implementation
     if (reset_internal)
       csr_minstret  <= 64'b0;
@@ -1362,7 +1551,7 @@ module rvx_core #(
           csr_minstret <= {csr_write_data, csr_minstret[31:0]};
       end
       else begin
-        if (current_state == STATE_OPERATING)
+        if (instruction_retired)
           csr_minstret <= csr_minstret + 1;
         else
           csr_minstret <= csr_minstret;
@@ -1556,7 +1745,9 @@ module rvx_core #(
       WB_UPPER_IMM:    writeback_multiplexer_output = immediate;
       WB_TARGET_ADDER: writeback_multiplexer_output = target_address_adder;
       WB_CSR:          writeback_multiplexer_output = csr_data_out;
-      WB_PC_PLUS_4:    writeback_multiplexer_output = program_counter_plus_4;
+      WB_PC_PLUS_4:    writeback_multiplexer_output = sequential_address;
+      WB_MULDIV:       writeback_multiplexer_output = muldiv_output;
+      WB_BITMANIP:     writeback_multiplexer_output = bitmanip_output;
       default:         writeback_multiplexer_output = alu_output;
     endcase
   end
@@ -1579,7 +1770,7 @@ module rvx_core #(
   end
 
   always @* begin : load_byte_data_mux
-    case (target_address_adder[1:0])
+    case (load_offset)
       2'b00:
         load_byte_data = read_data[7:0];
       2'b01:
@@ -1592,7 +1783,7 @@ module rvx_core #(
   end
 
   always @* begin : load_half_data_mux
-    case (target_address_adder[1])
+    case (load_offset[1])
       1'b0:
         load_half_data = read_data[15:0];
       1'b1:
@@ -1675,4 +1866,567 @@ module rvx_core #(
     endcase
   end
 
+  //-----------------------------------------------------------------------------------------------//
+  // Multiplier and divider (M extension)                                                          //
+  //-----------------------------------------------------------------------------------------------//
+
+  generate
+    if (M_EXTENSION != 0) begin : m_extension
+
+      // Funct3 of the instructions that need to be told apart (MULHSU, DIVU and REMU are the
+      // remaining ones)
+
+      localparam FUNCT3_MUL       = 3'b000;
+      localparam FUNCT3_MULH      = 3'b001;
+      localparam FUNCT3_MULHU     = 3'b011;
+      localparam FUNCT3_DIV       = 3'b100;
+      localparam FUNCT3_REM       = 3'b110;
+
+      wire          multiply;
+      wire          divide;
+      wire  [63:0]  multiplier_1st_operand;
+      wire  [63:0]  multiplier_2nd_operand;
+      wire  [63:0]  multiplier_result;
+      wire          divider_signed;
+      wire  [31:0]  dividend_magnitude;
+      wire  [31:0]  divisor_magnitude;
+      wire  [32:0]  divider_shifted;
+      wire  [32:0]  divider_difference;
+      wire  [31:0]  quotient_result;
+      wire  [31:0]  remainder_result;
+      reg   [31:0]  divider_quotient;
+      reg   [31:0]  divider_remainder;
+      reg   [31:0]  divider_divisor;
+      reg   [4:0 ]  divider_step;
+      reg           divider_busy;
+      reg           divider_done;
+
+      assign multiply =
+        muldiv & !instruction_funct3[2];
+
+      assign divide =
+        muldiv & instruction_funct3[2];
+
+      // Single-cycle multiplier. The operands are extended to 64 bits, signed for MULH (both) and
+      // MULHSU (rs1 only), so the low 64 bits of the product are the result of all four
+      // instructions
+
+      assign multiplier_1st_operand = {
+        {32{rs1_data[31] & instruction_funct3 != FUNCT3_MULHU}},
+        rs1_data
+      };
+
+      assign multiplier_2nd_operand = {
+        {32{rs2_data[31] & instruction_funct3 == FUNCT3_MULH}},
+        rs2_data
+      };
+
+      assign multiplier_result =
+        multiplier_1st_operand * multiplier_2nd_operand;
+
+      // Iterative divider: one quotient bit per cycle on the magnitudes of the operands. The
+      // pipeline stalls from the first cycle of the division until the cycle after the last bit
+
+      assign divider_signed =
+        instruction_funct3 == FUNCT3_DIV || instruction_funct3 == FUNCT3_REM;
+
+      assign dividend_magnitude =
+        divider_signed & rs1_data[31] ?
+        -rs1_data :
+        rs1_data;
+
+      assign divisor_magnitude =
+        divider_signed & rs2_data[31] ?
+        -rs2_data :
+        rs2_data;
+
+      assign divider_shifted =
+        {divider_remainder, divider_quotient[31]};
+
+      assign divider_difference =
+        divider_shifted - {1'b0, divider_divisor};
+
+      always @(posedge clock) begin : divider_implementation
+        if (reset_internal) begin
+          divider_busy      <= 1'b0;
+          divider_done      <= 1'b0;
+        end
+        else if (clock_enable) begin
+          divider_busy      <= 1'b0;
+          divider_done      <= 1'b0;
+        end
+        else if (divide & !divider_busy & !divider_done) begin
+          divider_quotient  <= dividend_magnitude;
+          divider_remainder <= 32'h00000000;
+          divider_divisor   <= divisor_magnitude;
+          divider_step      <= 5'd0;
+          divider_busy      <= 1'b1;
+        end
+        else if (divider_busy) begin
+          divider_quotient  <= {divider_quotient[30:0], !divider_difference[32]};
+          divider_remainder <=
+            divider_difference[32] ?
+            divider_shifted[31:0] :
+            divider_difference[31:0];
+          divider_step      <= divider_step + 5'd1;
+          if (divider_step == 5'd31) begin
+            divider_busy    <= 1'b0;
+            divider_done    <= 1'b1;
+          end
+        end
+      end
+
+      // Division by zero: the quotient has all bits set and the remainder is the dividend
+      assign quotient_result =
+        rs2_data == 32'h00000000 ?
+        32'hffffffff :
+        (divider_signed & (rs1_data[31] ^ rs2_data[31]) ?
+          -divider_quotient :
+          divider_quotient);
+
+      assign remainder_result =
+        divider_signed & rs1_data[31] ?
+        -divider_remainder :
+        divider_remainder;
+
+      assign muldiv_stall =
+        divide & !divider_done;
+
+      assign muldiv_output =
+        multiply ?
+          (instruction_funct3 == FUNCT3_MUL ?
+            multiplier_result[31:0] :
+            multiplier_result[63:32]) :
+          (instruction_funct3[1] ?
+            remainder_result :
+            quotient_result);
+
+    end
+    else begin : no_m_extension
+
+      assign muldiv_stall = 1'b0;
+      assign muldiv_output = 32'h00000000;
+
+    end
+  endgenerate
+
+  //-----------------------------------------------------------------------------------------------//
+  // Compressed instructions (C extension)                                                         //
+  //-----------------------------------------------------------------------------------------------//
+
+  generate
+    if (C_EXTENSION != 0) begin : c_extension
+
+      // The memory is still read one aligned word at a time. An instruction at an address ending
+      // in 2 starts in the upper half of a word: when it is reached sequentially, that half is
+      // already in prev_instruction_upper_half and the next word is fetched ahead with it. After
+      // a jump to such an address the word is fetched first, and if the instruction has 32 bits
+      // the next word takes one more cycle (fetch_second_half). With a branch target buffer the
+      // first half of such a jump target is kept, and the next word is fetched ahead at once.
+
+      reg   [15:0]  prev_instruction_upper_half;
+      reg           instruction_fetched_ahead;
+      wire          fetch_ahead;
+      wire          target_hit;
+      wire  [15:0]  target_parcel;
+      wire  [15:0]  lower_parcel;
+      wire  [15:0]  upper_parcel;
+      reg   [31:0]  expanded_instruction;
+      wire  [4:0 ]  compressed_rd;
+      wire  [4:0 ]  compressed_rs2;
+      wire  [4:0 ]  compressed_rd_short;
+      wire  [4:0 ]  compressed_rs1_short;
+      wire  [11:0]  compressed_immediate;
+      wire          compressed_immediate_zero;
+
+      always @(posedge clock) begin
+        if (reset_internal) begin
+          prev_instruction_upper_half <= 16'h0000;
+          instruction_fetched_ahead   <= 1'b0;
+        end
+        else if (clock_enable) begin
+          if (!load_commit_cycle & !store_commit_cycle)
+            prev_instruction_upper_half <= target_hit ? target_parcel : fetch_read_data[31:16];
+          instruction_fetched_ahead <= fetch_ahead;
+        end
+      end
+
+      assign lower_parcel =
+        !program_counter[1] ?
+        fetch_read_data[15:0] :
+        (instruction_fetched_ahead ?
+          prev_instruction_upper_half :
+          fetch_read_data[31:16]);
+
+      assign upper_parcel =
+        program_counter[1] ?
+        fetch_read_data[15:0] :
+        fetch_read_data[31:16];
+
+      assign fetched_instruction_compressed =
+        lower_parcel[1:0] != 2'b11;
+
+      assign fetched_instruction =
+        fetched_instruction_compressed ?
+        expanded_instruction :
+        {upper_parcel, lower_parcel};
+
+      assign fetch_second_half =
+        program_counter[1] & !instruction_fetched_ahead & !fetched_instruction_compressed &
+        !flush & !(bus_stall | load_commit_cycle | store_commit_cycle);
+
+      // Sequential instructions, and jumps to a target in the branch target buffer. Otherwise the
+      // upper half saved belongs to the word of a jump target.
+      assign fetch_ahead =
+        next_program_counter[1] & program_counter_source == PC_NEXT & (!take_branch | target_hit);
+
+      assign fetch_address =
+        {next_program_counter[31:2] + {29'b0, fetch_ahead}, 2'b00};
+
+      // Fields of the compressed formats (rd' and rs1' are x8 to x15)
+
+      assign compressed_rd =
+        lower_parcel[11:7];
+
+      assign compressed_rs2 =
+        lower_parcel[6:2];
+
+      assign compressed_rd_short =
+        {2'b01, lower_parcel[4:2]};
+
+      assign compressed_rs1_short =
+        {2'b01, lower_parcel[9:7]};
+
+      assign compressed_immediate =
+        {{7{lower_parcel[12]}}, lower_parcel[6:2]};
+
+      assign compressed_immediate_zero =
+        {lower_parcel[12], lower_parcel[6:2]} == 6'b000000;
+
+      // Equivalent 32-bit instruction. The reserved encodings and those of the F and D extensions
+      // expand to 0, an illegal instruction
+
+      always @* begin : compressed_instruction_expansion
+        case ({lower_parcel[15:13], lower_parcel[1:0]})
+          5'b00000: // C.ADDI4SPN
+            expanded_instruction = lower_parcel[12:5] == 8'b00000000 ? 32'h00000000 :
+              {2'b00, lower_parcel[10:7], lower_parcel[12:11], lower_parcel[5], lower_parcel[6],
+              2'b00, 5'd2, 3'b000, compressed_rd_short, OPCODE_OP_IMM};
+          5'b01000: // C.LW
+            expanded_instruction =
+              {5'b00000, lower_parcel[5], lower_parcel[12:10], lower_parcel[6], 2'b00,
+              compressed_rs1_short, 3'b010, compressed_rd_short, OPCODE_LOAD};
+          5'b11000: // C.SW
+            expanded_instruction =
+              {5'b00000, lower_parcel[5], lower_parcel[12], compressed_rd_short,
+              compressed_rs1_short, FUNCT3_SW, lower_parcel[11:10], lower_parcel[6], 2'b00,
+              OPCODE_STORE};
+          5'b00001: // C.ADDI
+            expanded_instruction =
+              {compressed_immediate, compressed_rd, 3'b000, compressed_rd, OPCODE_OP_IMM};
+          5'b00101, 5'b10101: // C.JAL, C.J
+            expanded_instruction =
+              {lower_parcel[12], lower_parcel[8], lower_parcel[10:9], lower_parcel[6],
+              lower_parcel[7], lower_parcel[2], lower_parcel[11], lower_parcel[5:3],
+              lower_parcel[12], {8{lower_parcel[12]}}, 4'b0000, !lower_parcel[15], OPCODE_JAL};
+          5'b01001: // C.LI
+            expanded_instruction =
+              {compressed_immediate, 5'd0, 3'b000, compressed_rd, OPCODE_OP_IMM};
+          5'b01101: // C.ADDI16SP, C.LUI
+            expanded_instruction = compressed_immediate_zero ? 32'h00000000 :
+              compressed_rd == 5'd2 ?
+              {{3{lower_parcel[12]}}, lower_parcel[4:3], lower_parcel[5], lower_parcel[2],
+              lower_parcel[6], 4'b0000, 5'd2, 3'b000, 5'd2, OPCODE_OP_IMM} :
+              {{15{lower_parcel[12]}}, lower_parcel[6:2], compressed_rd, OPCODE_LUI};
+          5'b10001: // C.SRLI, C.SRAI, C.ANDI, C.SUB, C.XOR, C.OR, C.AND
+            expanded_instruction =
+              lower_parcel[11:10] == 2'b10 ?
+              {compressed_immediate, compressed_rs1_short, 3'b111, compressed_rs1_short,
+              OPCODE_OP_IMM} :
+              lower_parcel[12] ? 32'h00000000 :
+              lower_parcel[11:10] != 2'b11 ?
+              {1'b0, lower_parcel[10], 5'b00000, lower_parcel[6:2], compressed_rs1_short, 3'b101,
+              compressed_rs1_short, OPCODE_OP_IMM} :
+              {1'b0, lower_parcel[6:5] == 2'b00, 5'b00000, compressed_rd_short,
+              compressed_rs1_short, lower_parcel[6] | lower_parcel[5], lower_parcel[6],
+              lower_parcel[6] & lower_parcel[5], compressed_rs1_short, OPCODE_OP};
+          5'b11001, 5'b11101: // C.BEQZ, C.BNEZ
+            expanded_instruction =
+              {{4{lower_parcel[12]}}, lower_parcel[6:5], lower_parcel[2], 5'd0,
+              compressed_rs1_short, 2'b00, lower_parcel[13], lower_parcel[11:10],
+              lower_parcel[4:3], lower_parcel[12], OPCODE_BRANCH};
+          5'b00010: // C.SLLI
+            expanded_instruction = lower_parcel[12] ? 32'h00000000 :
+              {7'b0000000, lower_parcel[6:2], compressed_rd, 3'b001, compressed_rd,
+              OPCODE_OP_IMM};
+          5'b01010: // C.LWSP
+            expanded_instruction = compressed_rd == 5'd0 ? 32'h00000000 :
+              {4'b0000, lower_parcel[3:2], lower_parcel[12], lower_parcel[6:4], 2'b00, 5'd2,
+              3'b010, compressed_rd, OPCODE_LOAD};
+          5'b10010: // C.JR, C.MV, C.EBREAK, C.JALR, C.ADD
+            expanded_instruction =
+              compressed_rs2 != 5'd0 ?
+              {7'b0000000, compressed_rs2, lower_parcel[12] ? compressed_rd : 5'd0, 3'b000,
+              compressed_rd, OPCODE_OP} :
+              compressed_rd != 5'd0 ?
+              {12'h000, compressed_rd, 3'b000, 4'b0000, lower_parcel[12], OPCODE_JALR} :
+              lower_parcel[12] ?
+              32'h00100073 :
+              32'h00000000;
+          5'b11010: // C.SWSP
+            expanded_instruction =
+              {4'b0000, lower_parcel[8:7], lower_parcel[12], compressed_rs2, 5'd2, FUNCT3_SW,
+              lower_parcel[11:9], 2'b00, OPCODE_STORE};
+          default:
+            expanded_instruction = 32'h00000000;
+        endcase
+      end
+
+      // Branch target buffer: the first half of the last 32-bit instructions at an address ending
+      // in 2 that took two cycles to fetch, replaced in turn. An entry is removed when its word is
+      // stored to, so it always matches the memory.
+
+      if (BRANCH_TARGET_BUFFER != 0) begin : branch_target_buffer
+
+        reg   [29:0]                      entry_address [0:BRANCH_TARGET_BUFFER-1];
+        reg   [15:0]                      entry_parcel  [0:BRANCH_TARGET_BUFFER-1];
+        reg   [BRANCH_TARGET_BUFFER-1:0]  entry_valid;
+        reg   [BTB_INDEX_WIDTH-1:0]       replace_index;
+        reg                               lookup_hit;
+        reg   [15:0]                      lookup_parcel;
+        integer                           e;
+        integer                           k;
+
+        always @* begin : lookup
+          lookup_hit    = 1'b0;
+          lookup_parcel = 16'h0000;
+          for (e = 0; e < BRANCH_TARGET_BUFFER; e = e + 1)
+            if (entry_valid[e] && entry_address[e] == branch_target_address[31:2]) begin
+              lookup_hit    = 1'b1;
+              lookup_parcel = entry_parcel[e];
+            end
+        end
+
+        assign target_hit =
+          take_branch & branch_target_address[1] & lookup_hit;
+
+        assign target_parcel =
+          lookup_parcel;
+
+        always @(posedge clock) begin
+          if (reset_internal) begin
+            entry_valid   <= {BRANCH_TARGET_BUFFER{1'b0}};
+            replace_index <= {BTB_INDEX_WIDTH{1'b0}};
+          end
+          else if (clock_enable) begin
+            for (k = 0; k < BRANCH_TARGET_BUFFER; k = k + 1)
+              if (store_request && entry_address[k] == target_address_adder[31:2])
+                entry_valid[k] <= 1'b0;
+            if (fetch_second_half) begin
+              entry_valid[replace_index] <= 1'b1;
+              replace_index <=
+                replace_index == BTB_LAST_INDEX ?
+                {BTB_INDEX_WIDTH{1'b0}} :
+                replace_index + BTB_NEXT_INDEX;
+            end
+          end
+        end
+
+        always @(posedge clock) begin
+          if (clock_enable & fetch_second_half) begin
+            entry_address[replace_index]  <= program_counter[31:2];
+            entry_parcel[replace_index]   <= lower_parcel;
+          end
+        end
+
+      end
+      else begin : no_branch_target_buffer
+
+        assign target_hit     = 1'b0;
+        assign target_parcel  = 16'h0000;
+
+      end
+
+    end
+    else begin : no_c_extension
+
+      assign fetched_instruction = fetch_read_data;
+      assign fetched_instruction_compressed = 1'b0;
+      assign fetch_second_half = 1'b0;
+      assign fetch_address = next_program_counter;
+
+    end
+  endgenerate
+
+  //-----------------------------------------------------------------------------------------------//
+  // Bit manipulation (Zba and Zbb extensions)                                                     //
+  //-----------------------------------------------------------------------------------------------//
+
+  generate
+    if (ZBA_ZBB_EXTENSION != 0) begin : zba_zbb_extension
+
+      // Funct7 (and upper immediate bits in OP-IMM) shared by each group of instructions
+
+      localparam FUNCT7_SHADD     = 7'b0010000;
+      localparam FUNCT7_NEGATED   = 7'b0100000;
+      localparam FUNCT7_MINMAX    = 7'b0000101;
+      localparam FUNCT7_ROTATE    = 7'b0110000;
+      localparam FUNCT7_ZEXT_H    = 7'b0000100;
+      localparam IMMEDIATE_ORC_B  = 12'h287;
+      localparam IMMEDIATE_REV8   = 12'h698;
+
+      wire          shadd;
+      wire          negated_logic;
+      wire          minmax;
+      wire          rotate;
+      wire          unary;
+      wire          orc_b;
+      wire          rev8;
+      wire          zext_h;
+      wire          minmax_less;
+      wire  [4:0 ]  rotate_amount;
+      wire  [63:0]  rotate_shifted;
+      reg   [5:0 ]  leading_zeros;
+      reg   [5:0 ]  trailing_zeros;
+      reg   [5:0 ]  population_count;
+      reg   [31:0]  unary_output;
+      reg   [31:0]  bitmanip_result;
+      integer       i;
+
+      // Instruction decoding
+
+      // SH1ADD, SH2ADD and SH3ADD
+      assign shadd =
+        op_type &
+        instruction_funct7 == FUNCT7_SHADD &
+        instruction_funct3[0] == 1'b0 &
+        instruction_funct3 != 3'b000;
+
+      // XNOR, ORN and ANDN
+      assign negated_logic =
+        op_type &
+        instruction_funct7 == FUNCT7_NEGATED &
+        (instruction_funct3 == FUNCT3_XOR ||
+         instruction_funct3 == FUNCT3_OR ||
+         instruction_funct3 == FUNCT3_AND);
+
+      // MIN, MINU, MAX and MAXU
+      assign minmax =
+        op_type &
+        instruction_funct7 == FUNCT7_MINMAX &
+        instruction_funct3[2] == 1'b1;
+
+      // ROL, ROR and RORI
+      assign rotate =
+        instruction_funct7 == FUNCT7_ROTATE &
+        ((op_type & (instruction_funct3 == FUNCT3_SLL || instruction_funct3 == FUNCT3_SRL)) |
+         (op_imm_type & instruction_funct3 == FUNCT3_SRL));
+
+      // CLZ, CTZ, CPOP, SEXT.B and SEXT.H, told apart by the rs2 field
+      assign unary =
+        op_imm_type &
+        instruction_funct7 == FUNCT7_ROTATE &
+        instruction_funct3 == FUNCT3_SLL &
+        (instruction_rs2_address == 5'd0 ||
+         instruction_rs2_address == 5'd1 ||
+         instruction_rs2_address == 5'd2 ||
+         instruction_rs2_address == 5'd4 ||
+         instruction_rs2_address == 5'd5);
+
+      assign orc_b =
+        op_imm_type &
+        instruction_funct3 == FUNCT3_SRL &
+        instruction[31:20] == IMMEDIATE_ORC_B;
+
+      assign rev8 =
+        op_imm_type &
+        instruction_funct3 == FUNCT3_SRL &
+        instruction[31:20] == IMMEDIATE_REV8;
+
+      assign zext_h =
+        op_type &
+        instruction_funct7 == FUNCT7_ZEXT_H &
+        instruction_funct3 == FUNCT3_XOR &
+        instruction_rs2_address == 5'd0;
+
+      assign bitmanip =
+        shadd | negated_logic | minmax | rotate | unary | orc_b | rev8 | zext_h;
+
+      // The comparison is the one of SLT/SLTU (rs1 against rs2), funct3[0] selects the unsigned
+      // one and funct3[1] the maximum
+
+      assign minmax_less =
+        instruction_funct3[0] ?
+        alu_sltu_result :
+        alu_slt_result;
+
+      // A left rotation is a right rotation by the opposite amount
+
+      assign rotate_amount =
+        instruction_funct3[2] ?
+        alu_2nd_operand[4:0] :
+        -alu_2nd_operand[4:0];
+
+      assign rotate_shifted =
+        {rs1_data, rs1_data} >> rotate_amount;
+
+      always @* begin : bit_counts
+        leading_zeros = 6'd32;
+        trailing_zeros = 6'd32;
+        population_count = 6'd0;
+        for (i = 0; i < 32; i = i + 1) begin
+          if (rs1_data[i]) begin
+            leading_zeros = 6'd31 - i[5:0];
+            population_count = population_count + 6'd1;
+          end
+          if (rs1_data[31 - i])
+            trailing_zeros = 6'd31 - i[5:0];
+        end
+      end
+
+      always @* begin : unary_operations
+        case (instruction_rs2_address[2:0])
+          3'b000:  unary_output = {26'b0, leading_zeros};
+          3'b001:  unary_output = {26'b0, trailing_zeros};
+          3'b010:  unary_output = {26'b0, population_count};
+          3'b100:  unary_output = {{24{rs1_data[7]}}, rs1_data[7:0]};
+          default: unary_output = {{16{rs1_data[15]}}, rs1_data[15:0]};
+        endcase
+      end
+
+      always @* begin : bitmanip_output_selection
+        if (shadd)
+          bitmanip_result = (rs1_data << instruction_funct3[2:1]) + rs2_data;
+        else if (negated_logic)
+          case (instruction_funct3)
+            FUNCT3_XOR: bitmanip_result = ~(rs1_data ^ rs2_data);
+            FUNCT3_OR:  bitmanip_result = rs1_data | ~rs2_data;
+            default:    bitmanip_result = rs1_data & ~rs2_data;
+          endcase
+        else if (minmax)
+          bitmanip_result = minmax_less ^ instruction_funct3[1] ? rs1_data : rs2_data;
+        else if (rotate)
+          bitmanip_result = rotate_shifted[31:0];
+        else if (orc_b)
+          bitmanip_result = {{8{|rs1_data[31:24]}}, {8{|rs1_data[23:16]}},
+                             {8{|rs1_data[15:8]}},  {8{|rs1_data[7:0]}}};
+        else if (rev8)
+          bitmanip_result = {rs1_data[7:0], rs1_data[15:8], rs1_data[23:16], rs1_data[31:24]};
+        else if (zext_h)
+          bitmanip_result = {16'b0, rs1_data[15:0]};
+        else
+          bitmanip_result = unary_output;
+      end
+
+      assign bitmanip_output = bitmanip_result;
+
+    end
+    else begin : no_zba_zbb_extension
+
+      assign bitmanip = 1'b0;
+      assign bitmanip_output = 32'h00000000;
+
+    end
+  endgenerate
+
 endmodule
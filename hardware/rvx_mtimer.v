@@ -41,7 +41,7 @@ module rvx_mtimer (
   // Map bits
   // CR
   localparam BIT_CR_EN        = 5'd0;
-  localparam BIT_CR_WIDTH     = 5'd1;
+  localparam BIT_CR_WIDTH     = 6'd1;
   localparam CR_PADDING       = {6'd32-BIT_CR_WIDTH{1'd0}};
 
   // Control register
@@ -82,7 +82,7 @@ module rvx_mtimer (
 
 
   // mtime
-  wire [63:0] mtime_plus_1 = mtime + 1'd1;
+  wire [63:0] mtime_plus_1 = mtime + 64'd1;
   always @(posedge clock) begin
     if (reset) begin
       mtime <= {64{1'b0}};
@@ -7,7 +7,10 @@ module rvx_ram #(
   parameter MEMORY_SIZE      = 8192,
 
   // File with program and data
-  parameter MEMORY_INIT_FILE = ""
+  parameter MEMORY_INIT_FILE = "",
+
+  // Set to 1 to add a read-only port for instruction fetch (true dual-port memory)
+  parameter DUAL_PORT        = 0
 
   ) (
 
@@ -25,7 +28,14 @@ module rvx_ram #(
   input  wire   [31:0]  write_data,
   input  wire   [3:0 ]  write_strobe,
   input  wire           write_request,
-  output reg            write_response
+  output reg            write_response,
+
+  // Instruction fetch interface (unused if DUAL_PORT = 0)
+
+  input  wire   [31:0]  instruction_read_address,
+  output wire   [31:0]  instruction_read_data,
+  input  wire           instruction_read_request,
+  output wire           instruction_read_response
 
   );
 
@@ -83,6 +93,62 @@ module rvx_ram #(
     end
   end
 
+  // Second port, read only, on the same array: it maps to a true dual-port block RAM, so the
+  // instruction fetch does not wait for the loads and stores of the first port
+
+  generate
+    if (DUAL_PORT != 0) begin : instruction_port
+
+      wire  [31:0]  instruction_effective_address;
+      wire          instruction_invalid_address;
+      reg   [31:0]  instruction_data;
+      reg           instruction_response;
+
+      assign instruction_invalid_address =
+        $unsigned(instruction_read_address) >= $unsigned(MEMORY_SIZE);
+
+      assign instruction_effective_address =
+        $unsigned(instruction_read_address[31:0] >> 2);
+
+      always @(posedge clock) begin
+        if (reset_internal | instruction_invalid_address)
+          instruction_data <= 32'h00000000;
+        else
+          instruction_data <= ram[instruction_effective_address];
+      end
+
+      always @(posedge clock) begin
+        if (reset_internal)
+          instruction_response <= 1'b0;
+        else
+          instruction_response <= instruction_read_request;
+      end
+
+      assign instruction_read_data     = instruction_data;
+      assign instruction_read_response = instruction_response;
+
+      // Avoid warnings about intentionally unused pins/wires
+      wire unused_ok =
+        &{1'b0,
+        instruction_effective_address[31:11],
+        1'b0};
+
+    end
+    else begin : no_instruction_port
+
+      assign instruction_read_data     = 32'h00000000;
+      assign instruction_read_response = 1'b0;
+
+      // Avoid warnings about intentionally unused pins/wires
+      wire unused_ok =
+        &{1'b0,
+        instruction_read_address,
+        instruction_read_request,
+        1'b0};
+
+    end
+  endgenerate
+
   // Avoid warnings about intentionally unused pins/wires
   wire unused_ok =
     &{1'b0,
@@ -4,7 +4,14 @@
 module rvx_uart #(
 
   parameter CLOCK_FREQUENCY = 50000000,
-  parameter UART_BAUD_RATE  = 9600
+  parameter UART_BAUD_RATE  = 9600,
+  // Number of bytes of the receive and transmit FIFOs (1 to 255)
+  parameter RX_FIFO_DEPTH   = 16,
+  parameter TX_FIFO_DEPTH   = 16,
+  // Set to 1 if a request can last several cycles (rvx_core with HARVARD = 0 repeats it while the
+  // core is stalled), so that it takes effect once. Set to 0 if each cycle with a request is a new
+  // access (HARVARD = 1, where two loads of REG_RDATA can follow each other).
+  parameter REPEATED_REQUESTS = 1
 
   )(
 
@@ -19,7 +26,7 @@ module rvx_uart #(
   output reg    [31:0]  read_data,
   input  wire           read_request,
   output reg            read_response,
-  input  wire   [7:0]   write_data,
+  input  wire   [15:0]  write_data,
   input  wire           write_request,
   output reg            write_response,
 
@@ -28,141 +35,317 @@ module rvx_uart #(
   input   wire          uart_rx,
   output  wire          uart_tx,
 
-  // Interrupt signaling
+  // Interrupt signaling (held while an enabled condition holds, until the core takes it)
 
-  output  reg           uart_irq,
+  output  wire          uart_irq,
   input   wire          uart_irq_response
 
   );
 
-  localparam CYCLES_PER_BAUD = CLOCK_FREQUENCY / UART_BAUD_RATE;
+  // Bit period in cycles, with 8 fractional bits. The fraction is accumulated from bit to bit, so
+  // the bits last DIVIDER_INTEGER or DIVIDER_INTEGER + 1 cycles and average the exact baud rate.
+  // The remainder times 256 is divided in 64 bits, it does not fit in 32 above about 8 Mbaud.
+  localparam DIVIDER_INTEGER  = CLOCK_FREQUENCY / UART_BAUD_RATE;
+  localparam [31:0] DIVIDER_REMAINDER = CLOCK_FREQUENCY % UART_BAUD_RATE;
+  localparam [63:0] DIVIDER_FRACTION  =
+    {24'b0, DIVIDER_REMAINDER, 8'b0} / {32'b0, UART_BAUD_RATE[31:0]};
+  localparam [7:0]  FRACTION          = DIVIDER_FRACTION[7:0];
+
+  // Cycles without a byte received or read before the RX idle timeout (4 frames)
+  localparam RX_TIMEOUT_CYCLES = 40 * DIVIDER_INTEGER;
+
+  // Bits of the index of the FIFO entries, their last value and their increment
+  localparam RX_INDEX_WIDTH = RX_FIFO_DEPTH > 1 ? $clog2(RX_FIFO_DEPTH) : 1;
+  localparam TX_INDEX_WIDTH = TX_FIFO_DEPTH > 1 ? $clog2(TX_FIFO_DEPTH) : 1;
+  localparam RX_LAST        = RX_FIFO_DEPTH - 1;
+  localparam TX_LAST        = TX_FIFO_DEPTH - 1;
+
+  localparam [RX_INDEX_WIDTH-1:0] RX_LAST_INDEX = RX_LAST[RX_INDEX_WIDTH-1:0];
+  localparam [TX_INDEX_WIDTH-1:0] TX_LAST_INDEX = TX_LAST[TX_INDEX_WIDTH-1:0];
+  localparam [RX_INDEX_WIDTH-1:0] RX_NEXT_INDEX = 1;
+  localparam [TX_INDEX_WIDTH-1:0] TX_NEXT_INDEX = 1;
+
+  // Number of bytes in a full FIFO (the byte counts are 8 bits wide)
+  localparam [7:0] RX_FULL = RX_FIFO_DEPTH[7:0];
+  localparam [7:0] TX_FULL = TX_FIFO_DEPTH[7:0];
 
   // Register Map
-  localparam REG_WDATA = 5'h00;
-  localparam REG_RDATA = 5'h04;
-  localparam REG_READY = 5'h08;
-  localparam REG_RXSTATUS = 5'h0c;
+  localparam REG_WDATA      = 5'h00;
+  localparam REG_RDATA      = 5'h04;
+  localparam REG_READY      = 5'h08;
+  localparam REG_RXSTATUS   = 5'h0c;
+  localparam REG_STATUS     = 5'h10;
+  localparam REG_LEVEL      = 5'h14;
+  localparam REG_IRQ_ENABLE = 5'h18;
+  localparam REG_WATERMARK  = 5'h1c;
+
+  // Interrupt conditions (bits of REG_IRQ_ENABLE and, from bit 8, of REG_STATUS)
+  localparam IRQ_RX_WATERMARK = 0;
+  localparam IRQ_RX_TIMEOUT   = 1;
+  localparam IRQ_TX_EMPTY     = 2;
+  localparam IRQ_TX_LOW       = 3;
 
   reg [31:0] tx_cycle_counter = 32'b0;
   reg [31:0] rx_cycle_counter = 32'b0;
+  reg [7:0]  tx_fraction = 8'b0;
+  reg [7:0]  rx_fraction = 8'b0;
   reg [3:0]  tx_bit_counter = 4'b0;
   reg [3:0]  rx_bit_counter = 4'b0;
   reg [9:0]  tx_register = 10'b1111111111;
   reg [7:0]  rx_register = 8'b0;
-  reg [7:0]  rx_data = 8'b0;
-  reg        rx_active = 1'b0;
   reg        reset_reg = 1'b0;
 
+  reg [7:0]  tx_fifo [0:TX_FIFO_DEPTH-1];
+  reg [7:0]  tx_fifo_count = 8'b0;
+  reg [TX_INDEX_WIDTH-1:0] tx_read_index = {TX_INDEX_WIDTH{1'b0}};
+  reg [TX_INDEX_WIDTH-1:0] tx_write_index = {TX_INDEX_WIDTH{1'b0}};
+  reg [7:0]  rx_fifo [0:RX_FIFO_DEPTH-1];
+  reg [7:0]  rx_fifo_count = 8'b0;
+  reg [RX_INDEX_WIDTH-1:0] rx_read_index = {RX_INDEX_WIDTH{1'b0}};
+  reg [RX_INDEX_WIDTH-1:0] rx_write_index = {RX_INDEX_WIDTH{1'b0}};
+  reg        rx_overrun = 1'b0;
+  reg [31:0] rx_timeout_counter = 32'b0;
+
+  reg [3:0]  irq_enable = 4'b0001;
+  reg [7:0]  rx_watermark = 8'd1;
+  reg [7:0]  tx_threshold = 8'd0;
+  reg [3:0]  irq_active_reg = 4'b0;
+  reg        irq_taken = 1'b0;
+
   wire       reset_internal;
+  wire       read_repeated;
+  wire       write_repeated;
+  wire       read_access;
+  wire       write_access;
+  wire [8:0] tx_fraction_sum;
+  wire [8:0] rx_fraction_sum;
+  wire       tx_bit_end;
+  wire       tx_load;
+  wire       tx_push;
+  wire       rx_start;
+  wire       rx_sample;
+  wire       rx_push;
+  wire       rx_pop;
+  wire       rx_write;
+  wire       rx_full;
+  wire       tx_full;
+  wire       tx_empty;
+  wire [3:0] irq_pending;
+  wire [3:0] irq_active;
+  wire       irq_event;
 
   always @(posedge clock)
     reset_reg <= reset;
 
   assign reset_internal = reset | reset_reg;
 
+  // A request still high after its response is the same access repeated (REPEATED_REQUESTS = 1).
+  // Only its first cycle pops or pushes a byte, and read_data keeps the value of that cycle.
+  assign read_repeated  = REPEATED_REQUESTS != 0 && read_response == 1'b1;
+  assign write_repeated = REPEATED_REQUESTS != 0 && write_response == 1'b1;
+  assign read_access    = read_request == 1'b1 && !read_repeated;
+  assign write_access   = write_request == 1'b1 && !write_repeated;
+
   assign uart_tx = tx_register[0];
 
+  // Fraction of the next bit period, whose carry makes the bit one cycle longer
+  assign tx_fraction_sum = {1'b0, tx_fraction} + {1'b0, FRACTION};
+  assign rx_fraction_sum = {1'b0, rx_fraction} + {1'b0, FRACTION};
+
+  // Transmitter
+
+  assign tx_bit_end = tx_bit_counter != 0 && tx_cycle_counter == 0;
+
+  // The next byte of the FIFO starts when the line is idle or right after the stop bit
+  assign tx_load =
+    tx_fifo_count != 0 &&
+    (tx_bit_counter == 0 || (tx_bit_counter == 1 && tx_bit_end));
+
+  // Bytes written to a full FIFO are dropped
+  assign tx_push =
+    rw_address == REG_WDATA &&
+    write_access &&
+    tx_fifo_count != TX_FULL;
+
   always @(posedge clock) begin
     if (reset_internal) begin
       tx_cycle_counter <= 0;
+      tx_fraction <= 0;
       tx_register <= 10'b1111111111;
       tx_bit_counter <= 0;
     end
-    else if (tx_bit_counter == 0 &&
-             rw_address == REG_WDATA &&
-             write_request == 1'b1) begin
-      tx_cycle_counter <= 0;
-      tx_register <= {1'b1, write_data[7:0], 1'b0};
+    else if (tx_load) begin
+      tx_cycle_counter <= DIVIDER_INTEGER - 1 + {31'b0, tx_fraction_sum[8]};
+      tx_fraction <= tx_fraction_sum[7:0];
+      tx_register <= {1'b1, tx_fifo[tx_read_index], 1'b0};
       tx_bit_counter <= 10;
     end
+    else if (tx_bit_end) begin
+      tx_cycle_counter <= tx_bit_counter == 1 ? 0 :
+                          DIVIDER_INTEGER - 1 + {31'b0, tx_fraction_sum[8]};
+      tx_fraction <= tx_bit_counter == 1 ? 8'b0 : tx_fraction_sum[7:0];
+      tx_register <= {1'b1, tx_register[9:1]};
+      tx_bit_counter <= tx_bit_counter - 1;
+    end
+    else if (tx_bit_counter != 0) begin
+      tx_cycle_counter <= tx_cycle_counter - 1;
+    end
+  end
+
+  always @(posedge clock) begin
+    if (reset_internal) begin
+      tx_fifo_count <= 0;
+      tx_read_index <= 0;
+      tx_write_index <= 0;
+    end
     else begin
-      if (tx_cycle_counter < CYCLES_PER_BAUD) begin
-        tx_cycle_counter <= tx_cycle_counter + 1;
-        tx_register <= tx_register;
-        tx_bit_counter <= tx_bit_counter;
-      end
-      else begin
-        tx_cycle_counter <= 0;
-        tx_register <= {1'b1, tx_register[9:1]};
-        tx_bit_counter <= tx_bit_counter > 0 ? tx_bit_counter - 1 : 0;
+      if (tx_push) begin
+        tx_fifo[tx_write_index] <= write_data[7:0];
+        tx_write_index <= tx_write_index == TX_LAST_INDEX ?
+                          {TX_INDEX_WIDTH{1'b0}} : tx_write_index + TX_NEXT_INDEX;
       end
+      if (tx_load)
+        tx_read_index <= tx_read_index == TX_LAST_INDEX ?
+                         {TX_INDEX_WIDTH{1'b0}} : tx_read_index + TX_NEXT_INDEX;
+      tx_fifo_count <= tx_fifo_count + {7'b0, tx_push} - {7'b0, tx_load};
     end
   end
 
+  // Receiver
+
+  // A frame starts after half a bit period of low line
+  assign rx_start =
+    rx_bit_counter == 0 &&
+    uart_rx == 1'b0 &&
+    rx_cycle_counter >= DIVIDER_INTEGER / 2;
+
+  // The data bits and the stop bit are sampled in their middle
+  assign rx_sample = rx_bit_counter != 0 && rx_cycle_counter == 0;
+
+  assign rx_push = rx_sample && rx_bit_counter == 1;
+
+  assign rx_pop =
+    rw_address == REG_RDATA &&
+    read_access &&
+    rx_fifo_count != 0;
+
+  // Bytes received while the FIFO is full are dropped
+  assign rx_write = rx_push && (rx_fifo_count != RX_FULL || rx_pop);
+
   always @(posedge clock) begin
     if (reset_internal) begin
       rx_cycle_counter <= 0;
+      rx_fraction <= 0;
       rx_register <= 8'h00;
-      rx_data <= 8'h00;
       rx_bit_counter <= 0;
-      uart_irq <= 1'b0;
-      rx_active <= 1'b0;
     end
-    else if (uart_irq == 1'b1) begin
-      if (uart_irq_response == 1'b1 || 
-          (rw_address == REG_RDATA &&
-           read_request == 1'b1)) begin
+    else if (rx_bit_counter == 0) begin
+      if (uart_rx == 1'b1) begin
         rx_cycle_counter <= 0;
-        rx_register <= 8'h00;
-        rx_data <= rx_data;
-        rx_bit_counter <= 0;
-        uart_irq <= 1'b0;
-        rx_active <= 1'b0;
+      end
+      else if (rx_start) begin
+        rx_cycle_counter <= DIVIDER_INTEGER - 1 + {31'b0, rx_fraction_sum[8]};
+        rx_fraction <= rx_fraction_sum[7:0];
+        rx_bit_counter <= 9;
       end
       else begin
-        rx_cycle_counter <= 0;
-        rx_register <= 8'h00;
-        rx_data <= rx_data;
-        rx_bit_counter <= 0;
-        uart_irq <= 1'b1;
-        rx_active <= 1'b0;
+        rx_cycle_counter <= rx_cycle_counter + 1;
       end
     end
-    else if (rx_bit_counter == 0 && rx_active == 1'b0) begin
-      if (uart_rx == 1'b1) begin
-        rx_cycle_counter <= 0;
-        rx_register <= 8'h00;
-        rx_data <= rx_data;
-        rx_bit_counter <= 0;
-        uart_irq <= 1'b0;
-        rx_active <= 1'b0;
-      end
-      else if (uart_rx == 1'b0) begin
-        if (rx_cycle_counter < CYCLES_PER_BAUD / 2) begin
-          rx_cycle_counter <= rx_cycle_counter + 1;
-          rx_register <= 8'h00;
-          rx_data <= rx_data;
-          rx_bit_counter <= 0;
-          uart_irq <= 1'b0;
-          rx_active <= 1'b0;
-        end
-        else begin
-          rx_cycle_counter <= 0;
-          rx_register <= 8'h00;
-          rx_data <= rx_data;
-          rx_bit_counter <= 8;
-          uart_irq <= 1'b0;
-          rx_active <= 1'b1;
-        end
-      end
+    else if (rx_sample) begin
+      rx_cycle_counter <= rx_bit_counter == 1 ? 0 :
+                          DIVIDER_INTEGER - 1 + {31'b0, rx_fraction_sum[8]};
+      rx_fraction <= rx_bit_counter == 1 ? 8'b0 : rx_fraction_sum[7:0];
+      rx_register <= rx_bit_counter == 1 ? rx_register : {uart_rx, rx_register[7:1]};
+      rx_bit_counter <= rx_bit_counter - 1;
     end
     else begin
-      if (rx_cycle_counter < CYCLES_PER_BAUD) begin
-        rx_cycle_counter <= rx_cycle_counter + 1;
-        rx_register <= rx_register;
-        rx_data <= rx_data;
-        rx_bit_counter <= rx_bit_counter;
-        uart_irq <= 1'b0;
-        rx_active <= 1'b1;
-      end
-      else begin
-        rx_cycle_counter <= 0;
-        rx_register <= {uart_rx, rx_register[7:1]};
-        rx_data <= (rx_bit_counter == 0) ? rx_register : rx_data;
-        rx_bit_counter <= rx_bit_counter > 0 ? rx_bit_counter - 1 : 0;
-        uart_irq <= (rx_bit_counter == 0) ? 1'b1 : 1'b0;
-        rx_active <= 1'b1;
+      rx_cycle_counter <= rx_cycle_counter - 1;
+    end
+  end
+
+  always @(posedge clock) begin
+    if (reset_internal) begin
+      rx_fifo_count <= 0;
+      rx_read_index <= 0;
+      rx_write_index <= 0;
+      rx_overrun <= 1'b0;
+      rx_timeout_counter <= 0;
+    end
+    else begin
+      if (rx_write) begin
+        rx_fifo[rx_write_index] <= rx_register;
+        rx_write_index <= rx_write_index == RX_LAST_INDEX ?
+                          {RX_INDEX_WIDTH{1'b0}} : rx_write_index + RX_NEXT_INDEX;
       end
+      if (rx_pop)
+        rx_read_index <= rx_read_index == RX_LAST_INDEX ?
+                         {RX_INDEX_WIDTH{1'b0}} : rx_read_index + RX_NEXT_INDEX;
+      rx_fifo_count <= rx_fifo_count + {7'b0, rx_write} - {7'b0, rx_pop};
+      // Sticky until REG_STATUS is read
+      if (rx_push && !rx_write)
+        rx_overrun <= 1'b1;
+      else if (rw_address == REG_STATUS && read_access)
+        rx_overrun <= 1'b0;
+      // Counts while the FIFO holds bytes and nothing is received or read
+      if (rx_fifo_count == 0 || rx_push || rx_pop)
+        rx_timeout_counter <= 0;
+      else if (rx_timeout_counter != RX_TIMEOUT_CYCLES)
+        rx_timeout_counter <= rx_timeout_counter + 1;
+    end
+  end
+
+  // Interrupts and registers
+
+  assign rx_full = rx_fifo_count == RX_FULL;
+  assign tx_full = tx_fifo_count == TX_FULL;
+  assign tx_empty = tx_fifo_count == 0 && tx_bit_counter == 0;
+
+  // A watermark of 0 counts as 1
+  assign irq_pending[IRQ_RX_WATERMARK] =
+    rx_fifo_count != 0 && rx_fifo_count >= rx_watermark;
+
+  assign irq_pending[IRQ_RX_TIMEOUT] = rx_timeout_counter == RX_TIMEOUT_CYCLES;
+
+  assign irq_pending[IRQ_TX_EMPTY] = tx_empty;
+
+  assign irq_pending[IRQ_TX_LOW] = tx_fifo_count <= tx_threshold;
+
+  assign irq_active = irq_enable & irq_pending;
+
+  // A condition that becomes active, or a byte received, read or written
+  assign irq_event = |(irq_active & ~irq_active_reg) || rx_write || rx_pop || tx_push;
+
+  // Once taken by the core, the interrupt stays low until the next event, so a handler that does
+  // not access the FIFOs runs once per byte received, as with the UART without FIFOs
+  assign uart_irq = |irq_active && !irq_taken;
+
+  always @(posedge clock) begin
+    if (reset_internal) begin
+      irq_active_reg <= 4'b0;
+      irq_taken <= 1'b0;
+    end
+    else begin
+      irq_active_reg <= irq_active;
+      if (irq_event)
+        irq_taken <= 1'b0;
+      else if (uart_irq_response)
+        irq_taken <= 1'b1;
+    end
+  end
+
+  always @(posedge clock) begin
+    if (reset_internal) begin
+      irq_enable <= 4'b0001;
+      rx_watermark <= 8'd1;
+      tx_threshold <= 8'd0;
+    end
+    else if (rw_address == REG_IRQ_ENABLE && write_access) begin
+      irq_enable <= write_data[3:0];
+    end
+    else if (rw_address == REG_WATERMARK && write_access) begin
+      rx_watermark <= write_data[7:0];
+      tx_threshold <= write_data[15:8];
     end
   end
 
@@ -180,12 +363,23 @@ module rvx_uart #(
   always @(posedge clock) begin
     if (reset_internal)
       read_data <= 32'h00000000;
+    else if (read_request == 1'b1 && read_repeated)
+      read_data <= read_data;
     else if (rw_address == REG_RDATA && read_request == 1'b1)
-      read_data <= {24'b0, rx_data};
+      read_data <= {24'b0, rx_fifo_count != 0 ? rx_fifo[rx_read_index] : 8'h00};
     else if (rw_address == REG_READY && read_request == 1'b1)
-      read_data <= {31'b0, tx_bit_counter == 0};
+      read_data <= {31'b0, !tx_full};
     else if (rw_address == REG_RXSTATUS && read_request == 1'b1)
-      read_data <= {31'b0, uart_irq};
+      read_data <= {31'b0, rx_fifo_count != 0};
+    else if (rw_address == REG_STATUS && read_request == 1'b1)
+      read_data <= {20'b0, irq_pending, 3'b0, rx_overrun, tx_full, tx_empty, rx_full,
+                    rx_fifo_count != 0};
+    else if (rw_address == REG_LEVEL && read_request == 1'b1)
+      read_data <= {16'b0, tx_fifo_count, rx_fifo_count};
+    else if (rw_address == REG_IRQ_ENABLE && read_request == 1'b1)
+      read_data <= {28'b0, irq_enable};
+    else if (rw_address == REG_WATERMARK && read_request == 1'b1)
+      read_data <= {16'b0, tx_threshold, rx_watermark};
     else
       read_data <= 32'h00000000;
   end
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+// rvx_bus with the RAM, MTIMER and GPIO of rvx.v at the same addresses. The ports are those of the
+// manager interface, named like the device interface so that the BusMaster of
+// hardware/tests/common can drive them.
+
+module bus_latency_tb (
+
+  input   wire          clock         ,
+  input   wire          reset         ,
+  input   wire  [31:0]  rw_address    ,
+  output  wire  [31:0]  read_data     ,
+  input   wire          read_request  ,
+  output  wire          read_response ,
+  input   wire  [31:0]  write_data    ,
+  input   wire  [3:0 ]  write_strobe  ,
+  input   wire          write_request ,
+  output  wire          write_response,
+  input   wire  [7:0 ]  gpio_input    ,
+  output  wire  [7:0 ]  gpio_output
+
+  );
+
+  localparam NUM_DEVICES    = 3;
+  localparam D0_RAM         = 0;
+  localparam D1_MTIMER      = 1;
+  localparam D2_GPIO        = 2;
+
+  wire  [NUM_DEVICES*32-1:0] device_start_address;
+  wire  [NUM_DEVICES*32-1:0] device_region_size;
+
+  assign device_start_address [32*D0_RAM      +: 32]  = 32'h0000_0000;
+  assign device_region_size   [32*D0_RAM      +: 32]  = 4096;
+
+  assign device_start_address [32*D1_MTIMER   +: 32]  = 32'h8001_0000;
+  assign device_region_size   [32*D1_MTIMER   +: 32]  = 32;
+
+  assign device_start_address [32*D2_GPIO     +: 32]  = 32'h8002_0000;
+  assign device_region_size   [32*D2_GPIO     +: 32]  = 32;
+
+  wire  [31:0]                device_rw_address       ;
+  wire  [NUM_DEVICES*32-1:0]  device_read_data        ;
+  wire  [NUM_DEVICES-1:0]     device_read_request     ;
+  wire  [NUM_DEVICES-1:0]     device_read_response    ;
+  wire  [31:0]                device_write_data       ;
+  wire  [3:0]                 device_write_strobe     ;
+  wire  [NUM_DEVICES-1:0]     device_write_request    ;
+  wire  [NUM_DEVICES-1:0]     device_write_response   ;
+
+  wire  [31:0]                instruction_read_data   ;
+  wire                        instruction_read_response;
+  wire                        irq_timer               ;
+  wire  [7:0]                 gpio_oe                 ;
+
+  rvx_bus #(
+
+    .NUM_DEVICES(NUM_DEVICES)
+
+  ) rvx_bus_instance (
+
+    .clock                          (clock                              ),
+    .reset                          (reset                              ),
+    .manager_rw_address             (rw_address                         ),
+    .manager_read_data              (read_data                          ),
+    .manager_read_request           (read_request                       ),
+    .manager_read_response          (read_response                      ),
+    .manager_write_data             (write_data                         ),
+    .manager_write_strobe           (write_strobe                       ),
+    .manager_write_request          (write_request                      ),
+    .manager_write_response         (write_response                     ),
+    .device_rw_address              (device_rw_address                  ),
+    .device_read_data               (device_read_data                   ),
+    .device_read_request            (device_read_request                ),
+    .device_read_response           (device_read_response               ),
+    .device_write_data              (device_write_data                  ),
+    .device_write_strobe            (device_write_strobe                ),
+    .device_write_request           (device_write_request               ),
+    .device_write_response          (device_write_response              ),
+    .device_start_address           (device_start_address               ),
+    .device_region_size             (device_region_size                 )
+
+  );
+
+  rvx_ram #(
+
+    .MEMORY_SIZE                    (4096                               )
+
+  ) rvx_ram_instance (
+
+    .clock                          (clock                              ),
+    .reset                          (reset                              ),
+    .rw_address                     (device_rw_address                  ),
+    .read_data                      (device_read_data[32*D0_RAM +: 32]  ),
+    .read_request                   (device_read_request[D0_RAM]        ),
+    .read_response                  (device_read_response[D0_RAM]       ),
+    .write_data                     (device_write_data                  ),
+    .write_strobe                   (device_write_strobe                ),
+    .write_request                  (device_write_request[D0_RAM]       ),
+    .write_response                 (device_write_response[D0_RAM]      ),
+    .instruction_read_address       (32'h00000000                       ),
+    .instruction_read_data          (instruction_read_data              ),
+    .instruction_read_request       (1'b0                               ),
+    .instruction_read_response      (instruction_read_response          )
+
+  );
+
+  rvx_mtimer
+  rvx_mtimer_instance (
+
+    .clock                          (clock                                  ),
+    .reset                          (reset                                  ),
+    .rw_address                     (device_rw_address[4:0]                 ),
+    .read_data                      (device_read_data[32*D1_MTIMER +: 32]   ),
+    .read_request                   (device_read_request[D1_MTIMER]         ),
+    .read_response                  (device_read_response[D1_MTIMER]        ),
+    .write_data                     (device_write_data                      ),
+    .write_strobe                   (device_write_strobe                    ),
+    .write_request                  (device_write_request[D1_MTIMER]        ),
+    .write_response                 (device_write_response[D1_MTIMER]       ),
+    .irq                            (irq_timer                              )
+
+  );
+
+  rvx_gpio #(
+
+    .GPIO_WIDTH                     (8                                      )
+
+  ) rvx_gpio_instance (
+
+    .clock                          (clock                                  ),
+    .reset                          (reset                                  ),
+    .rw_address                     (device_rw_address[4:0]                 ),
+    .read_data                      (device_read_data[32*D2_GPIO +: 32]     ),
+    .read_request                   (device_read_request[D2_GPIO]           ),
+    .read_response                  (device_read_response[D2_GPIO]          ),
+    .write_data                     (device_write_data[7:0]                 ),
+    .write_strobe                   (device_write_strobe                    ),
+    .write_request                  (device_write_request[D2_GPIO]          ),
+    .write_response                 (device_write_response[D2_GPIO]         ),
+    .gpio_input                     (gpio_input                             ),
+    .gpio_oe                        (gpio_oe                                ),
+    .gpio_output                    (gpio_output                            )
+
+  );
+
+  // Avoid warnings about intentionally unused pins/wires
+  wire unused_ok =
+    &{1'b0,
+    instruction_read_data,
+    instruction_read_response,
+    irq_timer,
+    gpio_oe,
+    1'b0};
+
+endmodule
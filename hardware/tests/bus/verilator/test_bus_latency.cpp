@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+// Latency of rvx_bus for the RAM and the peripherals
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Vbus_latency_tb.h"
+#include "bus_master.h"
+#include "test_runner.h"
+
+using Dut = Vbus_latency_tb;
+
+static constexpr uint32_t RAM = 0x00000000;
+static constexpr uint32_t MTIMER_MTIMECMP = 0x8001000c;
+static constexpr uint32_t GPIO_OUT = 0x80020008;
+static constexpr uint32_t UNMAPPED = 0x40000000;
+
+struct Bench
+{
+  std::unique_ptr<Dut> dut{new Dut};
+  BusMaster<Dut> bus{dut.get()};
+
+  Bench()
+  {
+    bus.reset();
+  }
+
+  // Cycles from the request to the response, 1 for a device without wait states. The BusMaster
+  // releases the request for one cycle after the response, which is not counted.
+  uint64_t read_latency(uint32_t address, uint32_t *data = nullptr)
+  {
+    uint64_t start = bus.cycles();
+    uint32_t value = bus.read_request(address);
+    if (data)
+    {
+      *data = value;
+    }
+    return bus.cycles() - start - 1;
+  }
+
+  uint64_t write_latency(uint32_t address, uint32_t data)
+  {
+    uint64_t start = bus.cycles();
+    bus.write_request(address, data);
+    return bus.cycles() - start - 1;
+  }
+
+  // Requests the addresses in consecutive cycles, without releasing the request in between. As
+  // with the core, the address of the next request is already on the bus in the cycle where the
+  // data of the previous one is sampled.
+  void back_to_back_reads(const std::vector<std::pair<uint32_t, uint32_t>> &expected)
+  {
+    dut->read_request = 1;
+    dut->rw_address = expected.front().first;
+    for (size_t k = 0; k < expected.size(); k++)
+    {
+      bus.tick();
+      if (k + 1 < expected.size())
+      {
+        dut->rw_address = expected[k + 1].first;
+      }
+      else
+      {
+        dut->read_request = 0;
+      }
+      dut->eval();
+      CHECK(dut->read_response);
+      CHECK_EQ(expected[k].second, dut->read_data);
+    }
+    bus.tick();
+  }
+};
+
+static void test_ram_zero_wait_states()
+{
+  Bench b;
+
+  for (uint32_t i = 0; i < 4; i++)
+  {
+    uint32_t data = 0;
+    CHECK_EQ(1, b.write_latency(RAM + 4 * i, 0x01020304 * (i + 1)));
+    CHECK_EQ(1, b.read_latency(RAM + 4 * i, &data));
+    CHECK_EQ(0x01020304 * (i + 1), data);
+  }
+}
+
+static void test_peripheral_latency()
+{
+  Bench b;
+  uint32_t data = 0;
+
+  CHECK_EQ(1, b.write_latency(GPIO_OUT, 0x5a));
+  CHECK_EQ(1, b.read_latency(GPIO_OUT, &data));
+  CHECK_EQ(0x5a, data);
+  CHECK_EQ(0x5a, b.dut->gpio_output);
+
+  CHECK_EQ(1, b.write_latency(MTIMER_MTIMECMP, 0x12345678));
+  CHECK_EQ(1, b.read_latency(MTIMER_MTIMECMP, &data));
+  CHECK_EQ(0x12345678, data);
+}
+
+static void test_unmapped_address()
+{
+  Bench b;
+  uint32_t data = 0xffffffff;
+
+  // Nothing is selected: the bus responds by itself with zero
+  CHECK_EQ(1, b.read_latency(UNMAPPED, &data));
+  CHECK_EQ(0, data);
+  CHECK_EQ(1, b.write_latency(UNMAPPED, 0));
+}
+
+static void test_back_to_back()
+{
+  Bench b;
+
+  b.bus.write_request(RAM + 0, 0xaaaa0000);
+  b.bus.write_request(RAM + 4, 0xbbbb0004);
+  b.bus.write_request(GPIO_OUT, 0x3c);
+  b.bus.write_request(MTIMER_MTIMECMP, 0x0badcafe);
+
+  // The return path switches between the RAM and the peripherals every cycle
+  b.back_to_back_reads({{RAM + 0, 0xaaaa0000},
+                        {GPIO_OUT, 0x3c},
+                        {RAM + 4, 0xbbbb0004},
+                        {MTIMER_MTIMECMP, 0x0badcafe},
+                        {RAM + 0, 0xaaaa0000},
+                        {UNMAPPED, 0},
+                        {RAM + 4, 0xbbbb0004}});
+}
+
+// Prints the timing of the bus, it only fails if the RAM has wait states
+static void test_report()
+{
+  Bench b;
+  const struct
+  {
+    const char *name;
+    uint32_t address;
+  } devices[] = {
+      {"ram", RAM + 0x100},
+      {"mtimer", MTIMER_MTIMECMP},
+      {"gpio", GPIO_OUT},
+      {"unmapped", UNMAPPED},
+  };
+
+  std::printf("%-10s %12s %12s %12s\n", "Device", "Read", "Write", "Wait states");
+  for (const auto &device : devices)
+  {
+    uint64_t write = b.write_latency(device.address, 0);
+    uint64_t read = b.read_latency(device.address);
+    std::printf("%-10s %12llu %12llu %12llu\n", device.name, (unsigned long long)read,
+                (unsigned long long)write, (unsigned long long)(read > write ? read : write) - 1);
+  }
+
+  CHECK_EQ(1, b.read_latency(RAM));
+  CHECK_EQ(1, b.write_latency(RAM, 0));
+}
+
+int main(int argc, char *argv[])
+{
+  return run_tests(
+      {
+          {"test_ram_zero_wait_states", test_ram_zero_wait_states},
+          {"test_peripheral_latency", test_peripheral_latency},
+          {"test_unmapped_address", test_unmapped_address},
+          {"test_back_to_back", test_back_to_back},
+          {"test_report", test_report},
+      },
+      argc, argv);
+}
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef BUS_MASTER_H
+#define BUS_MASTER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Transaction-level driver for the device side of rvx_bus (rw_address, read_data, read_request,
+// read_response, write_data, write_strobe, write_request, write_response). It works with any
+// Verilated peripheral that has these ports; write_strobe is optional (rvx_uart has none).
+//
+// The handshake is the same as the one of the cocotb tests: the request is held until the
+// response is sampled high, then released for one cycle.
+template <typename Dut> class BusMaster
+{
+public:
+  explicit BusMaster(Dut *dut, uint32_t timeout_cycles = 1000)
+      : dut(dut), timeout_cycles(timeout_cycles)
+  {
+  }
+
+  // One clock period. Inputs set before the call are sampled at its rising edge.
+  void tick()
+  {
+    dut->clock = 0;
+    dut->eval();
+    dut->clock = 1;
+    dut->eval();
+    cycle++;
+    if (on_tick)
+    {
+      on_tick();
+    }
+  }
+
+  void wait(uint64_t cycles)
+  {
+    while (cycles--)
+    {
+      tick();
+    }
+  }
+
+  void reset(uint64_t cycles = 10)
+  {
+    dut->read_request = 0;
+    dut->write_request = 0;
+    dut->reset = 1;
+    wait(cycles);
+    dut->reset = 0;
+    wait(cycles);
+  }
+
+  void write_request(uint32_t address, uint32_t data, uint8_t strobe = 0xf)
+  {
+    dut->rw_address = address;
+    dut->write_data = data;
+    set_write_strobe(dut, strobe, 0);
+    dut->write_request = 1;
+    wait_response([this]() { return dut->write_response; }, "write", address);
+    dut->write_request = 0;
+    tick();
+  }
+
+  uint32_t read_request(uint32_t address)
+  {
+    dut->rw_address = address;
+    dut->read_request = 1;
+    wait_response([this]() { return dut->read_response; }, "read", address);
+    uint32_t data = dut->read_data;
+    dut->read_request = 0;
+    tick();
+    return data;
+  }
+
+  uint64_t cycles() const
+  {
+    return cycle;
+  }
+
+  // Called after each clock period, including those of the bus transactions, for example to
+  // sample an output pin
+  std::function<void()> on_tick;
+
+private:
+  Dut *dut;
+  uint32_t timeout_cycles;
+  uint64_t cycle{0};
+
+  template <typename T>
+  static auto set_write_strobe(T *dut, uint8_t strobe, int) -> decltype(dut->write_strobe, void())
+  {
+    dut->write_strobe = strobe;
+  }
+
+  template <typename T> static void set_write_strobe(T *, uint8_t, long)
+  {
+  }
+
+  template <typename Response>
+  void wait_response(Response response, const char *kind, uint32_t address)
+  {
+    for (uint32_t i = 0; i < timeout_cycles; i++)
+    {
+      tick();
+      if (response())
+      {
+        return;
+      }
+    }
+
+    char message[64];
+    std::snprintf(message, sizeof(message), "no %s response at 0x%08x", kind, address);
+    throw std::runtime_error(message);
+  }
+};
+
+#endif // BUS_MASTER_H
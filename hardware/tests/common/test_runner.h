@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef TEST_RUNNER_H
+#define TEST_RUNNER_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Minimal test runner for the peripheral test benches. Each test builds its own model, so tests do
+// not depend on each other. A test fails on the first CHECK that does not hold or on a bus timeout.
+
+struct TestCase
+{
+  const char *name;
+  std::function<void()> body;
+};
+
+class TestFailure : public std::runtime_error
+{
+public:
+  using std::runtime_error::runtime_error;
+};
+
+#define CHECK(expr)                                                                                \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(expr))                                                                                   \
+    {                                                                                              \
+      throw TestFailure(std::string(__FILE__) + ":" + std::to_string(__LINE__) + ": " + #expr);   \
+    }                                                                                              \
+  } while (0)
+
+#define CHECK_EQ(expected, actual)                                                                 \
+  do                                                                                               \
+  {                                                                                                \
+    unsigned long long expected_value = (expected);                                                \
+    unsigned long long actual_value = (actual);                                                    \
+    if (expected_value != actual_value)                                                            \
+    {                                                                                              \
+      char message[128];                                                                           \
+      std::snprintf(message, sizeof(message), "expected 0x%llx, got 0x%llx", expected_value,       \
+                    actual_value);                                                                 \
+      throw TestFailure(std::string(__FILE__) + ":" + std::to_string(__LINE__) + ": " + #actual +  \
+                        ": " + message);                                                           \
+    }                                                                                              \
+  } while (0)
+
+// Runs the tests whose name contains the first argument (all of them without arguments) and
+// returns the exit status of the program
+inline int run_tests(const std::vector<TestCase> &tests, int argc, char *argv[])
+{
+  const char *filter = argc > 1 ? argv[1] : "";
+  int passed = 0;
+  int failed = 0;
+
+  for (const TestCase &test : tests)
+  {
+    if (!std::strstr(test.name, filter))
+    {
+      continue;
+    }
+
+    try
+    {
+      test.body();
+      std::printf("PASS %s\n", test.name);
+      passed++;
+    }
+    catch (const std::exception &e)
+    {
+      std::printf("FAIL %s: %s\n", test.name, e.what());
+      failed++;
+    }
+  }
+
+  std::printf("%d passed, %d failed\n", passed, failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif // TEST_RUNNER_H
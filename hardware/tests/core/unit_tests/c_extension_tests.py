@@ -0,0 +1,679 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2020-2025 RVX Project Contributors
+
+# Generates the unit test programs of the C extension (programs/c-<group>-01.hex) and their golden
+# references, in the layout of m_extension_tests.py. The compressed instructions are encoded here
+# and the expected results are computed from their definition in the specification, not from the
+# 32-bit instructions they expand to. The programs mix 16-bit and 32-bit instructions so that
+# 32-bit instructions start at addresses ending in 2, reached both sequentially and by jumps,
+# branches and trap returns.
+
+from pathlib import Path
+
+from m_extension_tests import MASK, SIGNATURE, HOST_WR_ADDR, hex_file, i_type, lui, r_type, s_type
+
+
+# Signature pointer (not x1, written by c.jal) and stack pointer
+SIG = 4
+SP = 2
+
+# Trap handler, below HOST_WR_ADDR and a multiple of 4 as mtvec requires
+HANDLER = 0xc00
+
+# Data read and written by the load and store tests
+DATA = 0x1800
+
+
+def signed(x: int):
+    x &= MASK
+    return x - (1 << 32) if x & 0x80000000 else x
+
+
+def bits(value: int, hi: int, lo: int, to: int):
+    return ((value >> lo) & ((1 << (hi - lo + 1)) - 1)) << to
+
+
+class Program:
+    def __init__(self):
+        # (address, size, encoder of the address and labels)
+        self.items = []
+        self.labels = {}
+        self.address = 0
+        self.signature = []
+
+    def emit(self, size: int, encode):
+        self.items.append((self.address, size, encode))
+        self.address += size
+
+    def half(self, encode):
+        self.emit(2, encode if callable(encode) else (lambda a, l, v=encode: v))
+
+    def word(self, encode):
+        self.emit(4, encode if callable(encode) else (lambda a, l, v=encode: v))
+
+    def label(self, name: str):
+        self.labels[name] = self.address
+
+    # Pads with c.nop up to an address ending in 0 or 2 (in a multiple of 4)
+    def align(self, offset: int):
+        while self.address % 4 != offset:
+            self.half(c_nop())
+
+    def org(self, address: int):
+        assert address >= self.address, 'the code overlaps the trap handler'
+        while self.address < address:
+            self.half(c_nop())
+
+    def li(self, rd: int, value: int):
+        low = value & 0xfff
+        if low & 0x800:
+            low -= 0x1000
+        self.word(lui(rd, (value - low) & MASK))
+        self.word(i_type(low, rd, 0, rd, 0x13))
+
+    # Stores x[rs] to the signature
+    def store(self, rs: int):
+        self.word(s_type(0, rs, SIG, 2))
+        self.word(i_type(4, SIG, 0, SIG, 0x13))
+
+    # Next signature word, a value or a function of the labels
+    def expect(self, expected):
+        self.signature.append(expected)
+
+    def sig(self, rs: int, expected):
+        self.store(rs)
+        self.expect(expected)
+
+    def end(self):
+        self.li(6, 1)
+        self.word(lui(7, HOST_WR_ADDR))
+        self.word(s_type(0, 6, 7, 2))
+        self.label('end_loop')
+        self.word(lambda a, l: jal(0, l['end_loop'] - a))
+
+    def image(self):
+        parcels = {}
+        for address, size, encode in self.items:
+            value = encode(address, self.labels)
+            parcels[address // 2] = value & 0xffff
+            if size == 4:
+                parcels[address // 2 + 1] = value >> 16
+        words = {}
+        for index, value in parcels.items():
+            words[index // 2] = words.get(index // 2, 0x00010001) & ~(0xffff << 16 * (index % 2))
+            words[index // 2] |= value << 16 * (index % 2)
+        assert max(words) * 4 < HOST_WR_ADDR, 'the code overlaps the host address'
+        words[0x7fe] = SIGNATURE + 4 * len(self.signature)
+        words[0x7ff] = SIGNATURE
+        return words
+
+    def reference(self):
+        return [(v(self.labels) if callable(v) else v) & MASK for v in self.signature]
+
+
+# 32-bit instructions
+
+def jal(rd: int, offset: int):
+    return (bits(offset, 20, 20, 31) | bits(offset, 10, 1, 21) | bits(offset, 11, 11, 20) |
+            bits(offset, 19, 12, 12) | rd << 7 | 0x6f)
+
+
+def branch(funct3: int, rs1: int, rs2: int, offset: int):
+    return (bits(offset, 12, 12, 31) | bits(offset, 10, 5, 25) | rs2 << 20 | rs1 << 15 |
+            funct3 << 12 | bits(offset, 4, 1, 8) | bits(offset, 11, 11, 7) | 0x63)
+
+
+def csrrw(rd: int, csr: int, rs1: int):
+    return csr << 20 | rs1 << 15 | 1 << 12 | rd << 7 | 0x73
+
+
+def csrrs(rd: int, csr: int, rs1: int):
+    return csr << 20 | rs1 << 15 | 2 << 12 | rd << 7 | 0x73
+
+
+ECALL = 0x00000073
+MRET = 0x30200073
+MISA = 0x301
+MEPC = 0x341
+MCAUSE = 0x342
+MTVAL = 0x343
+MTVEC = 0x305
+
+
+# Compressed instructions, rd' / rs1' / rs2' given as x8 to x15
+
+def short(reg: int):
+    assert 8 <= reg <= 15
+    return reg - 8
+
+
+def ci(funct3: int, imm: int, rd: int, op: int):
+    return funct3 << 13 | bits(imm, 5, 5, 12) | rd << 7 | bits(imm, 4, 0, 2) | op
+
+
+def c_nop():
+    return ci(0, 0, 0, 1)
+
+
+def c_addi(rd, imm):
+    return ci(0, imm, rd, 1)
+
+
+def c_li(rd, imm):
+    return ci(2, imm, rd, 1)
+
+
+def c_lui(rd, imm):
+    # rd = imm << 12, imm a 6-bit signed value
+    return ci(3, imm, rd, 1)
+
+
+def c_addi16sp(imm):
+    return (3 << 13 | bits(imm, 9, 9, 12) | SP << 7 | bits(imm, 4, 4, 6) | bits(imm, 6, 6, 5) |
+            bits(imm, 8, 7, 3) | bits(imm, 5, 5, 2) | 1)
+
+
+def c_addi4spn(rd, imm):
+    return (bits(imm, 5, 4, 11) | bits(imm, 9, 6, 7) | bits(imm, 2, 2, 6) | bits(imm, 3, 3, 5) |
+            short(rd) << 2)
+
+
+def c_shift_andi(funct2, rd, imm):
+    return 4 << 13 | bits(imm, 5, 5, 12) | funct2 << 10 | short(rd) << 7 | bits(imm, 4, 0, 2) | 1
+
+
+def c_srli(rd, shamt):
+    return c_shift_andi(0, rd, shamt)
+
+
+def c_srai(rd, shamt):
+    return c_shift_andi(1, rd, shamt)
+
+
+def c_andi(rd, imm):
+    return c_shift_andi(2, rd, imm)
+
+
+def c_alu(funct2, rd, rs2):
+    return 0x23 << 10 | short(rd) << 7 | funct2 << 5 | short(rs2) << 2 | 1
+
+
+def c_slli(rd, shamt):
+    return ci(0, shamt, rd, 2)
+
+
+def c_mv(rd, rs2):
+    return 0x8 << 12 | rd << 7 | rs2 << 2 | 2
+
+
+def c_add(rd, rs2):
+    return 0x9 << 12 | rd << 7 | rs2 << 2 | 2
+
+
+def c_jr(rs1):
+    return 0x8 << 12 | rs1 << 7 | 2
+
+
+def c_jalr(rs1):
+    return 0x9 << 12 | rs1 << 7 | 2
+
+
+C_EBREAK = 0x9002
+
+
+def c_lw(rd, rs1, imm):
+    return (2 << 13 | bits(imm, 5, 3, 10) | short(rs1) << 7 | bits(imm, 2, 2, 6) |
+            bits(imm, 6, 6, 5) | short(rd) << 2)
+
+
+def c_sw(rs2, rs1, imm):
+    return (6 << 13 | bits(imm, 5, 3, 10) | short(rs1) << 7 | bits(imm, 2, 2, 6) |
+            bits(imm, 6, 6, 5) | short(rs2) << 2)
+
+
+def c_lwsp(rd, imm):
+    return 2 << 13 | bits(imm, 5, 5, 12) | rd << 7 | bits(imm, 4, 2, 4) | bits(imm, 7, 6, 2) | 2
+
+
+def c_swsp(rs2, imm):
+    return 6 << 13 | bits(imm, 5, 2, 9) | bits(imm, 7, 6, 7) | rs2 << 2 | 2
+
+
+def c_jump(funct3, offset):
+    return (funct3 << 13 | bits(offset, 11, 11, 12) | bits(offset, 4, 4, 11) |
+            bits(offset, 9, 8, 9) | bits(offset, 10, 10, 8) | bits(offset, 6, 6, 7) |
+            bits(offset, 7, 7, 6) | bits(offset, 3, 1, 3) | bits(offset, 5, 5, 2) | 1)
+
+
+def c_branch(funct3, rs1, offset):
+    return (funct3 << 13 | bits(offset, 8, 8, 12) | bits(offset, 4, 3, 10) | short(rs1) << 7 |
+            bits(offset, 7, 6, 5) | bits(offset, 2, 1, 3) | bits(offset, 5, 5, 2) | 1)
+
+
+# Relative to a label
+def to(label, encode):
+    return lambda a, l: encode(l[label] - a)
+
+
+def start(p: Program):
+    p.li(SIG, SIGNATURE)
+    p.li(SP, DATA + 0x100)
+
+
+def alu_test():
+    p = Program()
+    start(p)
+
+    # Register and immediate values, each written with the compressed instruction under test
+    p.half(c_li(8, 31))
+    p.sig(8, 31)
+    p.half(c_li(9, -32))
+    p.sig(9, -32)
+    p.half(c_lui(10, 0x1f))
+    p.sig(10, 0x1f << 12)
+    p.half(c_lui(11, -1))
+    p.sig(11, -1 << 12)
+    p.half(c_lui(31, -32))
+    p.sig(31, -32 << 12)
+    p.half(c_addi(8, -7))
+    p.sig(8, 24)
+    p.half(c_li(20, 0))
+    p.half(c_addi(20, 5))
+    p.half(c_addi(20, 31))
+    p.sig(20, 36)
+    p.half(c_addi16sp(-512))
+    p.sig(SP, DATA + 0x100 - 512)
+    p.half(c_addi16sp(496))
+    p.sig(SP, DATA + 0x100 - 16)
+    p.half(c_addi16sp(16))
+    p.half(c_addi4spn(12, 1020))
+    p.sig(12, DATA + 0x100 + 1020)
+    p.half(c_addi4spn(13, 4))
+    p.sig(13, DATA + 0x104)
+
+    # Shifts and logic operations on x8 to x15
+    p.li(14, 0x80f0_1234)
+    p.half(c_srli(14, 4))
+    p.sig(14, 0x80f0_1234 >> 4)
+    p.li(14, 0x80f0_1234)
+    p.half(c_srai(14, 31))
+    p.sig(14, -1)
+    p.li(15, 0x80f0_1234)
+    p.half(c_srai(15, 1))
+    p.sig(15, signed(0x80f0_1234) >> 1)
+    p.li(15, 0x80f0_1234)
+    p.half(c_slli(15, 16))
+    p.sig(15, 0x80f0_1234 << 16)
+    p.li(9, 0x5555_aaaa)
+    p.half(c_andi(9, -16))
+    p.sig(9, 0x5555_aaaa & ~0xf)
+    p.li(9, 0x5555_aaaa)
+    p.half(c_andi(9, 0x1f))
+    p.sig(9, 0x5555_aaaa & 0x1f)
+
+    a, b = 0x1234_5678, 0x8765_4321
+    for funct2, result in ((0, a - b), (1, a ^ b), (2, a | b), (3, a & b)):
+        p.li(10, a)
+        p.li(11, b)
+        p.half(c_alu(funct2, 10, 11))
+        p.sig(10, result)
+
+    # Full register numbers
+    p.li(25, 0xcafe_f00d)
+    p.half(c_mv(26, 25))
+    p.sig(26, 0xcafe_f00d)
+    p.li(27, 0x1111_1111)
+    p.half(c_add(27, 25))
+    p.sig(27, 0xcafe_f00d + 0x1111_1111)
+    p.half(c_add(27, 27))
+    p.sig(27, 2 * (0xcafe_f00d + 0x1111_1111))
+
+    # The C bit of misa
+    p.word(csrrs(28, MISA, 0))
+    p.half(c_li(29, 4))
+    p.word(r_type(0, 29, 28, 7, 28, 0x33))
+    p.sig(28, 4)
+
+    p.end()
+    return p
+
+
+def load_store_test():
+    p = Program()
+    start(p)
+    values = [0x0123_4567, 0x89ab_cdef, 0xdead_beef, 0x0bad_f00d]
+
+    # c.swsp and c.lwsp with the largest offsets too
+    for i, value in enumerate(values):
+        p.li(20 + i, value)
+    p.half(c_swsp(20, 0))
+    p.half(c_swsp(21, 4))
+    p.half(c_swsp(22, 128))
+    p.half(c_swsp(23, 252))
+    p.half(c_lwsp(24, 252))
+    p.sig(24, values[3])
+    p.half(c_lwsp(25, 128))
+    p.sig(25, values[2])
+    p.half(c_lwsp(26, 4))
+    p.sig(26, values[1])
+    p.half(c_lwsp(27, 0))
+    p.sig(27, values[0])
+
+    # c.sw and c.lw, base in x8 to x15
+    p.li(8, DATA)
+    for i, value in enumerate(values):
+        p.li(9 + i, value ^ 0xffff_ffff)
+    p.half(c_sw(9, 8, 0))
+    p.half(c_sw(10, 8, 4))
+    p.half(c_sw(11, 8, 64))
+    p.half(c_sw(12, 8, 124))
+    p.half(c_lw(13, 8, 124))
+    p.sig(13, values[3] ^ 0xffff_ffff)
+    p.half(c_lw(14, 8, 64))
+    p.sig(14, values[2] ^ 0xffff_ffff)
+    p.half(c_lw(15, 8, 4))
+    p.sig(15, values[1] ^ 0xffff_ffff)
+    p.half(c_lw(8, 8, 0))
+    p.sig(8, values[0] ^ 0xffff_ffff)
+
+    # What c.swsp wrote, read back with c.lw
+    p.li(9, DATA + 0x100)
+    p.half(c_lw(10, 9, 4))
+    p.sig(10, values[1])
+
+    # Loads and stores back to back, at both alignments
+    p.li(9, DATA)
+    p.li(10, 0x7777_0000)
+    for i in range(6):
+        p.half(c_addi(10, i))
+        p.half(c_sw(10, 9, 4 * i))
+        p.half(c_lw(11, 9, 4 * i))
+        p.word(r_type(0, 11, 0, 0, 12, 0x33))
+        p.sig(12, 0x7777_0000 + sum(range(i + 1)))
+
+    p.end()
+    return p
+
+
+def jump_test():
+    p = Program()
+    start(p)
+    p.li(6, HANDLER)
+    p.word(csrrw(0, MTVEC, 6))
+
+    # c.j over an instruction
+    p.half(c_li(8, 1))
+    p.half(to('j1', lambda o: c_jump(5, o)))
+    p.half(c_li(8, 2))
+    p.label('j1')
+    p.sig(8, 1)
+
+    # c.j forwards and backwards, to 32-bit instructions at addresses ending in 0 and 2
+    p.half(c_li(9, 0))
+    p.half(to('j2', lambda o: c_jump(5, o)))
+    p.align(2)
+    p.label('j3')
+    p.word(i_type(0x40, 9, 0, 9, 0x13))
+    p.half(to('j4', lambda o: c_jump(5, o)))
+    p.label('j2')
+    p.word(i_type(0x100, 9, 0, 9, 0x13))
+    p.half(to('j3', lambda o: c_jump(5, o)))
+    p.label('j4')
+    p.sig(9, 0x140)
+
+    # c.jal and c.jr, the return address is 2 bytes after c.jal
+    p.half(to('sub1', lambda o: c_jump(1, o)))
+    p.label('ret1')
+    p.half(to('after_sub1', lambda o: c_jump(5, o)))
+    p.label('sub1')
+    p.word(i_type(0, 1, 0, 10, 0x13))
+    p.half(c_jr(1))
+    p.label('after_sub1')
+    p.word(lambda a, l: i_type(l['ret1'], 0, 0, 11, 0x13))
+    p.word(r_type(0x20, 11, 10, 0, 10, 0x33))
+    p.sig(10, 0)
+
+    # c.jalr to a compressed instruction at an address ending in 2
+    p.word(lambda a, l: i_type(l['sub2'], 0, 0, 12, 0x13))
+    p.half(c_jalr(12))
+    p.label('ret2')
+    p.half(to('after_sub2', lambda o: c_jump(5, o)))
+    p.align(2)
+    p.label('sub2')
+    p.half(c_mv(13, 1))
+    p.half(c_jr(1))
+    p.label('after_sub2')
+    p.word(lambda a, l: i_type(-l['ret2'], 13, 0, 13, 0x13))
+    p.sig(13, 0)
+
+    # 32-bit jal and jalr to 32-bit instructions at addresses ending in 2
+    p.half(c_li(14, 0))
+    p.word(to('t1', lambda o: jal(0, o)))
+    p.half(c_li(14, 1))
+    p.align(2)
+    p.label('t1')
+    p.word(i_type(0x7f, 14, 0, 14, 0x13))
+    p.word(lambda a, l: i_type(l['t2'], 0, 0, 15, 0x13))
+    p.word(i_type(0, 15, 0, 0, 0x67))
+    p.half(c_li(14, 1))
+    p.align(2)
+    p.label('t2')
+    p.word(i_type(0x80, 14, 0, 14, 0x13))
+    p.sig(14, 0xff)
+
+    # c.beqz and c.bnez, taken and not taken
+    p.half(c_li(8, 0))
+    p.half(c_li(9, 0))
+    p.half(to('b1', lambda o: c_branch(6, 8, o)))
+    p.half(c_li(9, 1))
+    p.label('b1')
+    p.half(to('b2', lambda o: c_branch(7, 8, o)))
+    p.half(c_addi(9, 2))
+    p.label('b2')
+    p.half(c_li(8, 5))
+    p.half(to('b3', lambda o: c_branch(6, 8, o)))
+    p.half(c_addi(9, 4))
+    p.label('b3')
+    p.sig(9, 6)
+
+    # Loop of 10 iterations starting at an address ending in 2, a 32-bit and a compressed load per
+    # iteration, c.bnez backwards
+    p.li(10, DATA)
+    p.li(11, 0x0101_0101)
+    p.word(s_type(0, 11, 10, 2))
+    p.half(c_li(8, 10))
+    p.half(c_li(12, 0))
+    p.align(2)
+    p.label('loop')
+    p.word(i_type(0, 10, 2, 13, 0x03))
+    p.half(c_add(12, 13))
+    p.half(c_lw(14, 10, 0))
+    p.half(c_add(12, 14))
+    p.half(c_addi(8, -1))
+    p.half(to('loop', lambda o: c_branch(7, 8, o)))
+    p.sig(12, 20 * 0x0101_0101)
+
+    # Loop of 7 iterations, its 32-bit addi and bne at addresses ending in 2
+    p.half(c_li(8, 7))
+    p.half(c_li(12, 0))
+    p.align(0)
+    p.label('loop2')
+    p.half(c_addi(12, 3))
+    p.word(i_type(-1, 8, 0, 8, 0x13))
+    p.word(to('loop2', lambda o: branch(1, 8, 0, o)))
+    p.sig(12, 21)
+
+    # Traps, x5 is the size of the trapping instruction. The handler stores mepc, mcause and mtval
+    # and returns to the next instruction, a 32-bit one at an address ending in 2.
+    p.align(0)
+    p.half(c_li(5, 4))
+    p.label('ecall')
+    p.word(ECALL)
+    p.expect(lambda l: l['ecall'])
+    p.expect(11)
+    p.expect(0)
+    p.word(i_type(0x11, 0, 0, 20, 0x13))
+    p.sig(20, 0x11)
+
+    p.align(2)
+    p.half(c_li(5, 2))
+    p.label('ebreak')
+    p.half(C_EBREAK)
+    p.expect(lambda l: l['ebreak'])
+    p.expect(3)
+    p.expect(lambda l: l['ebreak'])
+    p.word(i_type(0x22, 0, 0, 21, 0x13))
+    p.sig(21, 0x22)
+
+    p.li(22, DATA + 2)
+    p.align(0)
+    p.half(c_li(5, 4))
+    p.label('misaligned_lw')
+    p.word(i_type(0, 22, 2, 23, 0x03))
+    p.expect(lambda l: l['misaligned_lw'])
+    p.expect(4)
+    p.expect(DATA + 2)
+    p.word(i_type(0x33, 0, 0, 23, 0x13))
+    p.sig(23, 0x33)
+
+    # mepc keeps bit 1
+    p.word(lambda a, l: i_type(l['ebreak'] + 2, 0, 0, 24, 0x13))
+    p.word(csrrw(0, MEPC, 24))
+    p.word(csrrs(25, MEPC, 0))
+    p.sig(25, lambda l: l['ebreak'] + 2)
+
+    p.end()
+
+    p.org(HANDLER)
+    p.word(csrrs(6, MEPC, 0))
+    p.store(6)
+    p.word(csrrs(6, MCAUSE, 0))
+    p.store(6)
+    p.word(csrrs(6, MTVAL, 0))
+    p.store(6)
+    p.word(csrrs(6, MEPC, 0))
+    p.half(c_add(6, 5))
+    p.word(csrrw(0, MEPC, 6))
+    p.word(MRET)
+    return p
+
+
+FENCE_I = 0x0000100f
+
+
+def target_test():
+    p = Program()
+    start(p)
+
+    # Subroutines starting with a 32-bit instruction at an address ending in 2, the targets kept by
+    # a branch target buffer. The second ones are called sixteen times.
+    p.half(to('subs_end', lambda o: c_jump(5, o)))
+    for i in range(5):
+        p.align(2)
+        p.label(f'sub{i}')
+        p.word(i_type(1 << i, 9, 0, 9, 0x13))
+        p.half(c_jr(1))
+    p.label('subs_end')
+
+    # Loop of 4 iterations with c.jal to two subroutines and a 32-bit jal, whose return address is
+    # a 32-bit instruction at an address ending in 2
+    p.half(c_li(8, 4))
+    p.half(c_li(9, 0))
+    p.half(c_li(10, 0))
+    p.label('loop')
+    p.half(to('sub0', lambda o: c_jump(1, o)))
+    p.half(to('sub1', lambda o: c_jump(1, o)))
+    p.align(2)
+    p.word(to('sub2', lambda o: jal(1, o)))
+    p.word(i_type(5, 10, 0, 10, 0x13))
+    p.half(c_addi(8, -1))
+    p.half(to('loop', lambda o: c_branch(7, 8, o)))
+    p.sig(9, 4 * 7)
+    p.sig(10, 4 * 5)
+
+    # Loop of 3 iterations calling five subroutines, more targets than the entries of the buffer
+    p.half(c_li(8, 3))
+    p.half(c_li(9, 0))
+    p.label('loop2')
+    for i in range(5):
+        p.half(to(f'sub{i}', lambda o: c_jump(1, o)))
+    p.half(c_addi(8, -1))
+    p.half(to('loop2', lambda o: c_branch(7, 8, o)))
+    p.sig(9, 3 * 31)
+
+    # Backward 32-bit bne to a 32-bit instruction at an address ending in 2, 20 iterations
+    p.half(c_li(8, 20))
+    p.half(c_li(10, 0))
+    p.align(2)
+    p.label('loop3')
+    p.word(i_type(3, 10, 0, 10, 0x13))
+    p.half(c_addi(8, -1))
+    p.word(to('loop3', lambda o: branch(1, 8, 0, o)))
+    p.sig(10, 60)
+
+    # The first half of a subroutine is stored to after two calls: it writes x13 instead of x11
+    p.half(c_li(11, 0))
+    p.half(c_li(13, 0))
+    p.half(to('smc', lambda o: c_jump(1, o)))
+    p.half(to('smc', lambda o: c_jump(1, o)))
+    p.word(lambda a, l: i_type(l['smc'], 0, 0, 14, 0x13))
+    p.li(15, i_type(1, 11, 0, 13, 0x13) & 0xffff)
+    p.word(s_type(0, 15, 14, 1))
+    p.word(FENCE_I)
+    p.half(to('smc', lambda o: c_jump(1, o)))
+    p.half(to('smc', lambda o: c_jump(1, o)))
+    p.half(to('smc_end', lambda o: c_jump(5, o)))
+    p.align(2)
+    p.label('smc')
+    p.word(i_type(1, 11, 0, 11, 0x13))
+    p.half(c_jr(1))
+    p.label('smc_end')
+    p.sig(11, 2)
+    p.sig(13, 3)
+
+    # Stores to the first half of another subroutine, each followed by a call without FENCE.I: a sh
+    # makes it write x17 instead of x16, then a sb of its second byte makes it write x19
+    p.half(c_li(16, 0))
+    p.half(c_li(17, 0))
+    p.half(c_li(19, 0))
+    p.half(to('smc2', lambda o: c_jump(1, o)))
+    p.half(to('smc2', lambda o: c_jump(1, o)))
+    p.word(lambda a, l: i_type(l['smc2'], 0, 0, 14, 0x13))
+    p.li(15, i_type(1, 16, 0, 17, 0x13) & 0xffff)
+    p.word(s_type(0, 15, 14, 1))
+    p.half(to('smc2', lambda o: c_jump(1, o)))
+    p.li(15, (i_type(1, 16, 0, 19, 0x13) >> 8) & 0xff)
+    p.word(s_type(1, 15, 14, 0))
+    p.half(to('smc2', lambda o: c_jump(1, o)))
+    p.half(to('smc2_end', lambda o: c_jump(5, o)))
+    p.align(2)
+    p.label('smc2')
+    p.word(i_type(1, 16, 0, 16, 0x13))
+    p.half(c_jr(1))
+    p.label('smc2_end')
+    p.sig(16, 2)
+    p.sig(17, 3)
+    p.sig(19, 3)
+
+    p.end()
+    return p
+
+
+def main():
+    directory = Path(__file__).parent
+    tests = {'c-alu-01': alu_test(), 'c-ldst-01': load_store_test(), 'c-jump-01': jump_test(),
+             'c-target-01': target_test()}
+    # CRLF, like the RISC-V Architecture Test files
+    for name, program in tests.items():
+        words = program.image()
+        assert all(0 <= v < 0x800 for v in program.labels.values()), 'addi immediates'
+        with open(directory / 'programs' / f'{name}.hex', 'w', encoding='utf-8',
+                  newline='\r\n') as f:
+            f.write(hex_file(words))
+        with open(directory / 'references' / f'{name}.reference.hex', 'w', encoding='utf-8',
+                  newline='\r\n') as f:
+            f.write(''.join(f'{w:08x}\n' for w in program.reference()))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,173 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2020-2025 RVX Project Contributors
+
+# Generates the unit test programs of the M extension (programs/<op>-01.hex) and their golden
+# references (references/<op>-01.reference.hex). Each program computes the instruction for a set
+# of operands (the corner cases of the specification and random values), rotating the registers,
+# and stores the results as the signature, in the layout of the RISC-V Architecture Test programs:
+# the beginning and end of the signature at 0x1ffc and 0x1ff8, and the test ends with a store of
+# 1 to 0x1000. Run it again only if the operands or the instructions change.
+
+import random
+from pathlib import Path
+
+
+SIGNATURE = 0x2000
+HOST_WR_ADDR = 0x1000
+
+MASK = 0xffffffff
+
+FUNCT3 = {
+    'mul'   : 0,
+    'mulh'  : 1,
+    'mulhsu': 2,
+    'mulhu' : 3,
+    'div'   : 4,
+    'divu'  : 5,
+    'rem'   : 6,
+    'remu'  : 7,
+}
+
+CORNER = [0x00000000, 0x00000001, 0x00000002, 0x7fffffff, 0x80000000, 0x80000001, 0xffffffff,
+          0xfffffffe, 0x55555555, 0xaaaaaaaa, 0x0000ffff, 0xffff0000]
+
+
+def signed(x: int):
+    return x - (1 << 32) if x & 0x80000000 else x
+
+
+def reference(op: str, a: int, b: int):
+    sa = signed(a)
+    sb = signed(b)
+    if op == 'mul':
+        return (a * b) & MASK
+    if op == 'mulh':
+        return ((sa * sb) >> 32) & MASK
+    if op == 'mulhsu':
+        return ((sa * b) >> 32) & MASK
+    if op == 'mulhu':
+        return ((a * b) >> 32) & MASK
+    if op in ('div', 'rem'):
+        if b == 0:
+            return MASK if op == 'div' else a
+        if sa == -(1 << 31) and sb == -1:
+            return a if op == 'div' else 0
+        # Rounds toward zero
+        q = abs(sa) // abs(sb)
+        if (sa < 0) != (sb < 0):
+            q = -q
+        return (q if op == 'div' else sa - q * sb) & MASK
+    if b == 0:
+        return MASK if op == 'divu' else a
+    return a // b if op == 'divu' else a % b
+
+
+def r_type(funct7: int, rs2: int, rs1: int, funct3: int, rd: int, opcode: int):
+    return funct7 << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode
+
+
+def i_type(imm: int, rs1: int, funct3: int, rd: int, opcode: int):
+    return (imm & 0xfff) << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode
+
+
+def s_type(imm: int, rs2: int, rs1: int, funct3: int):
+    return (((imm >> 5) & 0x7f) << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | (imm & 0x1f) << 7 |
+            0x23)
+
+
+def lui(rd: int, imm: int):
+    return (imm & 0xfffff000) | rd << 7 | 0x37
+
+
+def li(rd: int, value: int):
+    # lui + addi, the addi sign-extends its immediate
+    low = value & 0xfff
+    if low & 0x800:
+        low -= 0x1000
+    return [lui(rd, (value - low) & MASK), i_type(low, rd, 0, rd, 0x13)]
+
+
+def operands(seed: int):
+    pairs = [(a, b) for a in CORNER for b in CORNER]
+    rng = random.Random(seed)
+    pairs += [(rng.getrandbits(32), rng.getrandbits(32)) for _ in range(16)]
+    # Small divisors make the quotient and remainder of the random dividends non trivial
+    pairs += [(rng.getrandbits(32), rng.getrandbits(4)) for _ in range(8)]
+    return pairs
+
+
+def generate(op: str, directory: Path):
+    code = []
+    signature = []
+
+    # x1 points to the next signature word
+    code += li(1, SIGNATURE)
+
+    for i, (a, b) in enumerate(operands(FUNCT3[op])):
+        rs1 = 2 + (i * 3) % 30
+        rs2 = 2 + (i * 7 + 1) % 30
+        rd = 2 + (i * 11 + 2) % 30
+        # rd = x0 once, its result is discarded
+        if i == 5:
+            rd = 0
+        if rs1 == rs2:
+            b = a
+        code += li(rs1, a)
+        if rs2 != rs1:
+            code += li(rs2, b)
+        code.append(r_type(0x01, rs2, rs1, FUNCT3[op], rd, 0x33))
+        code.append(s_type(0, rd, 1, 2))
+        code.append(i_type(4, 1, 0, 1, 0x13))
+        signature.append(0 if rd == 0 else reference(op, a, b))
+
+    # End of the test: store 1 to HOST_WR_ADDR, then loop
+    code += li(2, 1)
+    code.append(lui(3, HOST_WR_ADDR))
+    code.append(s_type(0, 2, 3, 2))
+    code.append(0x0000006f)
+
+    assert len(code) * 4 <= SIGNATURE - 8, f'{op}: the program overlaps the signature pointers'
+
+    words = {i: w for i, w in enumerate(code)}
+    words[0x7fe] = SIGNATURE + 4 * len(signature)
+    words[0x7ff] = SIGNATURE
+
+    # CRLF, like the RISC-V Architecture Test files
+    program = directory / 'programs' / f'{op}-01.hex'
+    with open(program, 'w', encoding='utf-8', newline='\r\n') as f:
+        f.write(hex_file(words))
+
+    reference_path = directory / 'references' / f'{op}-01.reference.hex'
+    with open(reference_path, 'w', encoding='utf-8', newline='\r\n') as f:
+        f.write(''.join(f'{w:08x}\n' for w in signature))
+
+
+def hex_file(words: dict):
+    # $readmemh format: word addresses, four words per line
+    lines = []
+    address = None
+    line = []
+    for index in sorted(words):
+        if index != address:
+            if line:
+                lines.append(' '.join(line))
+                line = []
+            lines.append(f'@{index:08X}')
+        line.append(f'{words[index]:08X}')
+        address = index + 1
+        if len(line) == 4:
+            lines.append(' '.join(line))
+            line = []
+    if line:
+        lines.append(' '.join(line))
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    directory = Path(__file__).parent
+    for op in FUNCT3:
+        generate(op, directory)
+
+
+if __name__ == "__main__":
+    main()
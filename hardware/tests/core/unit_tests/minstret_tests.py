@@ -0,0 +1,118 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2020-2025 RVX Project Contributors
+
+# Generates the unit test program of the instructions retired counter (programs/minstret-01.hex)
+# and its golden reference, in the layout of m_extension_tests.py. The program reads minstret
+# before and after short sequences of ALU instructions, loads and stores, a taken jump, ECALL and a
+# misaligned load, and stores the differences. An instruction that traps does not retire, the
+# instructions of the trap handler do. It only uses RV32I and Zicsr, so it runs on every core.
+
+from pathlib import Path
+
+from m_extension_tests import HOST_WR_ADDR, MASK, SIGNATURE, hex_file, i_type, li, lui, r_type, s_type
+
+MINSTRET = 0xb02
+MTVEC = 0x305
+MEPC = 0x341
+
+ECALL = 0x00000073
+MRET = 0x30200073
+
+# Word index of the trap handler, after the end of the test
+HANDLER = 0x200
+
+# Scratch word for the loads and stores
+SCRATCH = 0x1800
+
+
+def addi(rd: int, rs1: int, imm: int):
+    return i_type(imm, rs1, 0, rd, 0x13)
+
+
+def sub(rd: int, rs1: int, rs2: int):
+    return r_type(0x20, rs2, rs1, 0, rd, 0x33)
+
+
+def lw(rd: int, rs1: int, imm: int):
+    return i_type(imm, rs1, 2, rd, 0x03)
+
+
+def csrr(rd: int, csr: int):
+    return i_type(csr, 0, 2, rd, 0x73)
+
+
+def csrw(csr: int, rs1: int):
+    return i_type(csr, rs1, 1, 0, 0x73)
+
+
+def jal(rd: int, offset: int):
+    return (((offset >> 20) & 1) << 31 | ((offset >> 1) & 0x3ff) << 21 |
+            ((offset >> 11) & 1) << 20 | ((offset >> 12) & 0xff) << 12 | rd << 7 | 0x6f)
+
+
+def minstret_test():
+    code = []
+    signature = []
+
+    # Instructions retired from the first read of minstret to the second one, which is not counted
+    def measure(sequence: list, retired: int):
+        code.append(csrr(5, MINSTRET))
+        code.extend(sequence)
+        code.append(csrr(6, MINSTRET))
+        code.append(sub(7, 6, 5))
+        code.append(s_type(0, 7, 1, 2))
+        code.append(addi(1, 1, 4))
+        signature.append((1 + retired) & MASK)
+
+    # x1 points to the next signature word
+    code += li(1, SIGNATURE)
+    code += li(10, SCRATCH)
+    code += li(11, 4 * HANDLER)
+    code.append(csrw(MTVEC, 11))
+
+    # ALU instructions
+    measure([addi(8, 0, i) for i in range(5)], 5)
+
+    # Loads and stores hold the program counter for an extra cycle, they retire once
+    measure([s_type(0, 10, 10, 2), lw(8, 10, 0), s_type(4, 8, 10, 2)], 3)
+
+    # A taken jump over an instruction
+    measure([jal(0, 8), addi(8, 0, 1)], 1)
+
+    # ECALL and a misaligned load trap and do not retire, the four instructions of the handler do
+    measure([ECALL], 4)
+    measure([lw(8, 10, 1)], 4)
+
+    # End of the test: store 1 to HOST_WR_ADDR, then loop
+    code += li(2, 1)
+    code.append(lui(3, HOST_WR_ADDR))
+    code.append(s_type(0, 2, 3, 2))
+    code.append(0x0000006f)
+
+    assert len(code) <= HANDLER, 'the program overlaps the trap handler'
+
+    # Returns to the instruction after the one that trapped
+    handler = [csrr(20, MEPC), addi(20, 20, 4), csrw(MEPC, 20), MRET]
+
+    words = {i: w for i, w in enumerate(code)}
+    words.update({HANDLER + i: w for i, w in enumerate(handler)})
+    words[0x7fe] = SIGNATURE + 4 * len(signature)
+    words[0x7ff] = SIGNATURE
+    return words, signature
+
+
+def main():
+    directory = Path(__file__).parent
+    words, signature = minstret_test()
+
+    # CRLF, like the RISC-V Architecture Test files
+    with open(directory / 'programs' / 'minstret-01.hex', 'w', encoding='utf-8',
+              newline='\r\n') as f:
+        f.write(hex_file(words))
+    with open(directory / 'references' / 'minstret-01.reference.hex', 'w', encoding='utf-8',
+              newline='\r\n') as f:
+        f.write(''.join(f'{w:08x}\n' for w in signature))
+
+
+if __name__ == '__main__':
+    main()
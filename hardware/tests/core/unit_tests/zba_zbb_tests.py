@@ -0,0 +1,150 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2020-2025 RVX Project Contributors
+
+# Generates the unit test programs of the Zba and Zbb extensions (programs/<op>-01.hex) and their
+# golden references, in the layout of m_extension_tests.py. The results are computed here from the
+# definition of each instruction in the specification. Run it again only if the operands or the
+# instructions change.
+
+import random
+from pathlib import Path
+
+from m_extension_tests import (CORNER, HOST_WR_ADDR, MASK, SIGNATURE, hex_file, i_type, li, lui,
+                               operands, r_type, s_type, signed)
+
+
+def rotate_right(x: int, n: int):
+    n &= 31
+    return ((x >> n) | (x << (32 - n))) & MASK
+
+
+def count_leading_zeros(x: int):
+    return 32 - x.bit_length()
+
+
+def count_trailing_zeros(x: int):
+    return 32 if x == 0 else (x & -x).bit_length() - 1
+
+
+def or_combine(x: int):
+    return sum(0xff << i for i in range(0, 32, 8) if (x >> i) & 0xff)
+
+
+def sign_extend(x: int, bits: int):
+    x &= (1 << bits) - 1
+    return (x - (1 << bits) if x >> (bits - 1) else x) & MASK
+
+
+# Register-register instructions: funct7, funct3 and result
+BINARY = {
+    'sh1add': (0x10, 2, lambda a, b: (a << 1) + b),
+    'sh2add': (0x10, 4, lambda a, b: (a << 2) + b),
+    'sh3add': (0x10, 6, lambda a, b: (a << 3) + b),
+    'andn'  : (0x20, 7, lambda a, b: a & ~b),
+    'orn'   : (0x20, 6, lambda a, b: a | ~b),
+    'xnor'  : (0x20, 4, lambda a, b: ~(a ^ b)),
+    'min'   : (0x05, 4, lambda a, b: a if signed(a) < signed(b) else b),
+    'minu'  : (0x05, 5, lambda a, b: min(a, b)),
+    'max'   : (0x05, 6, lambda a, b: a if signed(a) > signed(b) else b),
+    'maxu'  : (0x05, 7, lambda a, b: max(a, b)),
+    'rol'   : (0x30, 1, lambda a, b: rotate_right(a, -b)),
+    'ror'   : (0x30, 5, lambda a, b: rotate_right(a, b)),
+}
+
+# Instructions with rs1 only: immediate (rs2 field included), opcode (zext.h is in OP), funct3
+# and result
+UNARY = {
+    'clz'   : (0x600, 0x13, 1, count_leading_zeros),
+    'ctz'   : (0x601, 0x13, 1, count_trailing_zeros),
+    'cpop'  : (0x602, 0x13, 1, lambda a: bin(a).count('1')),
+    'sext.b': (0x604, 0x13, 1, lambda a: sign_extend(a, 8)),
+    'sext.h': (0x605, 0x13, 1, lambda a: sign_extend(a, 16)),
+    'zext.h': (0x080, 0x33, 4, lambda a: a & 0xffff),
+    'orc.b' : (0x287, 0x13, 5, or_combine),
+    'rev8'  : (0x698, 0x13, 5, lambda a: int.from_bytes(a.to_bytes(4, 'little'), 'big')),
+}
+
+
+def unary_operands(seed: int):
+    values = CORNER + [1 << i for i in range(0, 32, 3)] + [0x00ff0000, 0x12003400, 0x00000080,
+                                                           0x00008000, 0x80808080, 0x01000001]
+    rng = random.Random(seed)
+    # Random values with a random number of low or high bits cleared
+    for _ in range(16):
+        value = rng.getrandbits(32)
+        shift = rng.getrandbits(5)
+        values.append(value >> shift if rng.getrandbits(1) else (value << shift) & MASK)
+    return values
+
+
+def generate(op: str, cases: list, directory: Path):
+    code = []
+    signature = []
+
+    # x1 points to the next signature word
+    code += li(1, SIGNATURE)
+
+    for i, (instruction, (a, b), result) in enumerate(cases):
+        rs1 = 2 + (i * 3) % 30
+        rs2 = 2 + (i * 7 + 1) % 30
+        rd = 2 + (i * 11 + 2) % 30
+        # rd = x0 once, its result is discarded
+        if i == 5:
+            rd = 0
+        if rs1 == rs2:
+            b = a
+        code += li(rs1, a)
+        if rs2 != rs1:
+            code += li(rs2, b)
+        code.append(instruction(rd, rs1, rs2))
+        code.append(s_type(0, rd, 1, 2))
+        code.append(i_type(4, 1, 0, 1, 0x13))
+        signature.append(0 if rd == 0 else result(a, b) & MASK)
+
+    # End of the test: store 1 to HOST_WR_ADDR, then loop
+    code += li(2, 1)
+    code.append(lui(3, HOST_WR_ADDR))
+    code.append(s_type(0, 2, 3, 2))
+    code.append(0x0000006f)
+
+    assert len(code) * 4 <= SIGNATURE - 8, f'{op}: the program overlaps the signature pointers'
+
+    words = {i: w for i, w in enumerate(code)}
+    words[0x7fe] = SIGNATURE + 4 * len(signature)
+    words[0x7ff] = SIGNATURE
+
+    # CRLF, like the RISC-V Architecture Test files
+    with open(directory / 'programs' / f'{op}-01.hex', 'w', encoding='utf-8',
+              newline='\r\n') as f:
+        f.write(hex_file(words))
+    with open(directory / 'references' / f'{op}-01.reference.hex', 'w', encoding='utf-8',
+              newline='\r\n') as f:
+        f.write(''.join(f'{w:08x}\n' for w in signature))
+
+
+def main():
+    directory = Path(__file__).parent
+
+    for seed, (op, (funct7, funct3, function)) in enumerate(BINARY.items()):
+        encode = (lambda f7, f3: lambda rd, rs1, rs2: r_type(f7, rs2, rs1, f3, rd, 0x33))
+        cases = [(encode(funct7, funct3), (a, b), lambda a, b, f=function: f(a, b))
+                 for a, b in operands(100 + seed)]
+        generate(op, cases, directory)
+
+    # rori: the shift amount is the immediate, rs2 is not read
+    cases = []
+    for i, (a, b) in enumerate(operands(200)):
+        shamt = (b + i) & 31
+        encode = (lambda s: lambda rd, rs1, rs2: i_type(0x600 | s, rs1, 5, rd, 0x13))(shamt)
+        cases.append((encode, (a, b), lambda a, b, s=shamt: rotate_right(a, s)))
+    generate('rori', cases, directory)
+
+    for seed, (op, (immediate, opcode, funct3, function)) in enumerate(UNARY.items()):
+        encode = (lambda imm, opc, f3: lambda rd, rs1, rs2: i_type(imm, rs1, f3, rd, opc))
+        cases = [(encode(immediate, opcode, funct3), (a, 0), lambda a, b, f=function: f(a))
+                 for a in unary_operands(300 + seed)]
+        generate(op, cases, directory)
+
+
+if __name__ == "__main__":
+    main()
@@ -44,6 +44,13 @@ static void close_trace()
   }
 }
 
+static void final_dut()
+{
+  // Completes the model. Builds with --prof-pgo write their profile (profile.vlt) at this point.
+  dut->final();
+  delete dut;
+}
+
 static void clk()
 {
   static vluint64_t interval = 0;
@@ -144,17 +151,28 @@ static bool is_finished(uint32_t addr)
          dut->rootp->unit_tests__DOT__write_data == 0x00000001;
 }
 
-static bool is_host_out(uint32_t addr)
+// Checked once per cycle, after the rising edge. A store is accepted when the RAM responds in the
+// next cycle, so back-to-back stores (HARVARD = 1, write_request stays high) are all printed.
+static bool is_host_out(uint32_t addr, char &c)
 {
-  static bool is_pos_edg = false;
+  static vluint64_t cycle = 0;
+  static bool pending = false;
+  static char data = 0;
+
+  if (not dut->clock or cycle == clk_cur_cycles)
+  {
+    return false;
+  }
+  cycle = clk_cur_cycles;
 
-  bool is_write = (addr != 0x0) &&
-                  (not is_pos_edg and dut->rootp->unit_tests__DOT__write_request) &&
-                  (dut->rootp->unit_tests__DOT__rw_address == addr) &&
-                  dut->rootp->unit_tests__DOT__write_request &&
-                  dut->rootp->unit_tests__DOT__write_data;
+  bool is_write = pending && dut->rootp->unit_tests__DOT__write_response;
+  c = data;
 
-  is_pos_edg = dut->rootp->unit_tests__DOT__write_request;
+  pending = (addr != 0x0) &&
+            dut->rootp->unit_tests__DOT__write_request &&
+            (dut->rootp->unit_tests__DOT__rw_address == addr) &&
+            dut->rootp->unit_tests__DOT__write_data;
+  data = (char)dut->rootp->unit_tests__DOT__write_data;
 
   return is_write;
 }
@@ -168,6 +186,7 @@ int main(int argc, char *argv[])
 {
   signal(SIGINT, exit_app);
   signal(SIGKILL, exit_app);
+  std::atexit(final_dut);
 
   // Default log level
   Log::set_level(Log::DEBUG);
@@ -219,9 +238,10 @@ int main(int argc, char *argv[])
     }
 
     // --host-out
-    if (is_host_out(args.host_out))
+    char c;
+    if (is_host_out(args.host_out, c))
     {
-      Log::host_out((char)dut->rootp->unit_tests__DOT__write_data);
+      Log::host_out(c);
     }
   }
 }
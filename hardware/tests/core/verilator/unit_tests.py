@@ -40,6 +40,7 @@ unit_test = [
     ["../unit_tests/programs/lhu-align-01.hex",       "../unit_tests/references/lhu-align-01.reference.hex",        True,   ],
     ["../unit_tests/programs/lui-01.hex",             "../unit_tests/references/lui-01.reference.hex",              True,   ],
     ["../unit_tests/programs/lw-align-01.hex",        "../unit_tests/references/lw-align-01.reference.hex",         True,   ],
+    ["../unit_tests/programs/minstret-01.hex",        "../unit_tests/references/minstret-01.reference.hex",         True,   ],
     ["../unit_tests/programs/misalign-beq-01.hex",    "../unit_tests/references/misalign-beq-01.reference.hex",     True,   ],
     ["../unit_tests/programs/misalign-bge-01.hex",    "../unit_tests/references/misalign-bge-01.reference.hex",     True,   ],
     ["../unit_tests/programs/misalign-bgeu-01.hex",   "../unit_tests/references/misalign-bgeu-01.reference.hex",    True,   ],
@@ -74,6 +75,52 @@ unit_test = [
     ["../unit_tests/programs/xori-01.hex",            "../unit_tests/references/xori-01.reference.hex",             True,   ],
 ]
 
+# Unit tests of the optional extensions, run only on the cores built with them (see --config)
+
+m_extension_test = [
+    ["../unit_tests/programs/div-01.hex",             "../unit_tests/references/div-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/divu-01.hex",            "../unit_tests/references/divu-01.reference.hex",             True,   ],
+    ["../unit_tests/programs/mul-01.hex",             "../unit_tests/references/mul-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/mulh-01.hex",            "../unit_tests/references/mulh-01.reference.hex",             True,   ],
+    ["../unit_tests/programs/mulhsu-01.hex",          "../unit_tests/references/mulhsu-01.reference.hex",           True,   ],
+    ["../unit_tests/programs/mulhu-01.hex",           "../unit_tests/references/mulhu-01.reference.hex",            True,   ],
+    ["../unit_tests/programs/rem-01.hex",             "../unit_tests/references/rem-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/remu-01.hex",            "../unit_tests/references/remu-01.reference.hex",             True,   ],
+]
+
+c_extension_test = [
+    ["../unit_tests/programs/c-alu-01.hex",           "../unit_tests/references/c-alu-01.reference.hex",            True,   ],
+    ["../unit_tests/programs/c-jump-01.hex",          "../unit_tests/references/c-jump-01.reference.hex",           True,   ],
+    ["../unit_tests/programs/c-ldst-01.hex",          "../unit_tests/references/c-ldst-01.reference.hex",           True,   ],
+    ["../unit_tests/programs/c-target-01.hex",        "../unit_tests/references/c-target-01.reference.hex",         True,   ],
+]
+
+zba_zbb_extension_test = [
+    ["../unit_tests/programs/andn-01.hex",            "../unit_tests/references/andn-01.reference.hex",             True,   ],
+    ["../unit_tests/programs/clz-01.hex",             "../unit_tests/references/clz-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/cpop-01.hex",            "../unit_tests/references/cpop-01.reference.hex",             True,   ],
+    ["../unit_tests/programs/ctz-01.hex",             "../unit_tests/references/ctz-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/max-01.hex",             "../unit_tests/references/max-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/maxu-01.hex",            "../unit_tests/references/maxu-01.reference.hex",             True,   ],
+    ["../unit_tests/programs/min-01.hex",             "../unit_tests/references/min-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/minu-01.hex",            "../unit_tests/references/minu-01.reference.hex",             True,   ],
+    ["../unit_tests/programs/orc.b-01.hex",           "../unit_tests/references/orc.b-01.reference.hex",            True,   ],
+    ["../unit_tests/programs/orn-01.hex",             "../unit_tests/references/orn-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/rev8-01.hex",            "../unit_tests/references/rev8-01.reference.hex",             True,   ],
+    ["../unit_tests/programs/rol-01.hex",             "../unit_tests/references/rol-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/ror-01.hex",             "../unit_tests/references/ror-01.reference.hex",              True,   ],
+    ["../unit_tests/programs/rori-01.hex",            "../unit_tests/references/rori-01.reference.hex",             True,   ],
+    ["../unit_tests/programs/sext.b-01.hex",          "../unit_tests/references/sext.b-01.reference.hex",           True,   ],
+    ["../unit_tests/programs/sext.h-01.hex",          "../unit_tests/references/sext.h-01.reference.hex",           True,   ],
+    ["../unit_tests/programs/sh1add-01.hex",          "../unit_tests/references/sh1add-01.reference.hex",           True,   ],
+    ["../unit_tests/programs/sh2add-01.hex",          "../unit_tests/references/sh2add-01.reference.hex",           True,   ],
+    ["../unit_tests/programs/sh3add-01.hex",          "../unit_tests/references/sh3add-01.reference.hex",           True,   ],
+    ["../unit_tests/programs/xnor-01.hex",            "../unit_tests/references/xnor-01.reference.hex",             True,   ],
+    ["../unit_tests/programs/zext.h-01.hex",          "../unit_tests/references/zext.h-01.reference.hex",           True,   ],
+]
+
+# Misaligned branch and jump targets trap on the cores without the C extension. With it, 2-byte
+# aligned targets are taken and these tests must pass.
 expected_to_fail = [
     "../unit_tests/programs/misalign-beq-01.hex"    ,
     "../unit_tests/programs/misalign-bge-01.hex"    ,
@@ -85,6 +132,18 @@ expected_to_fail = [
     "../unit_tests/programs/misalign2-jalr-01.hex"
 ]
 
+# Builds of the Makefile: simulator, unit tests run in addition to the RV32I ones and tests expected
+# to fail
+configs = {
+    "default"       : ["obj_dir/unit_tests",                [],                         expected_to_fail],
+    "fast"          : ["obj_dir_fast/unit_tests",           [],                         expected_to_fail],
+    "m"             : ["obj_dir_m/unit_tests",              m_extension_test,           expected_to_fail],
+    "c"             : ["obj_dir_c/unit_tests",              c_extension_test,           []],
+    "zb"            : ["obj_dir_zb/unit_tests",             zba_zbb_extension_test,     expected_to_fail],
+    "harvard"       : ["obj_dir_harvard/unit_tests",        [],                         expected_to_fail],
+    "btb"           : ["obj_dir_btb/unit_tests",            c_extension_test,           []],
+}
+
 def print_status(clr: scolor, text: str):
     if clr == scolor.NORMAL:
         print(f'{clr}{text}')
@@ -147,10 +206,16 @@ def main(argv=None):
     parser = argparse.ArgumentParser(description=__doc__,
                                      formatter_class=argparse.ArgumentDefaultsHelpFormatter)
 
+    parser.add_argument('--config',
+                        type=str,
+                        default='default',
+                        choices=configs.keys(),
+                        help='Build of the Makefile to test, which selects the unit tests')
+
     parser.add_argument('--sim',
                         type=str,
-                        default='obj_dir/unit_tests',
-                        help='Path to the simulator')
+                        default=None,
+                        help='Path to the simulator (default: the one of --config)')
 
     parser.add_argument('--dump',
                         type=str,
@@ -163,6 +228,12 @@ def main(argv=None):
 
     args = parser.parse_args(argv)
 
+    sim_path, extension_test, expected_fail = configs[args.config]
+    tests = unit_test + extension_test
+
+    if args.sim is None:
+        args.sim = sim_path
+
     if not check_file(args.sim):
         print_status(scolor.NORMAL, f'Please build file: {args.sim}')
         return
@@ -174,7 +245,7 @@ def main(argv=None):
     skipped = 0
     failed = 0
 
-    for item in unit_test:
+    for item in tests:
         prog_path = item[prg_index]
         ref_path = item[ref_index]
         is_run = item[run_index]
@@ -204,7 +275,7 @@ def main(argv=None):
 
         result, line, ref, dut = compare_dump(ref=ref_path, dut=dump_path)
 
-        if not result and prog_path not in expected_to_fail:
+        if not result and prog_path not in expected_fail:
             failed +=1
             print_status(scolor.FAIL, prog_path)
             print_status(scolor.NORMAL, f'-- Signature at line {line} differs from golden reference.')
@@ -215,7 +286,7 @@ def main(argv=None):
 
     print_status(scolor.NORMAL, f'Total: passed {passed}, skipped {skipped}, failed {failed}')
 
-    if passed == len(unit_test):
+    if passed == len(tests):
       print("------------------------------------------------------------------------------------------")
       print("RVX Core IP passed ALL unit tests from RISC-V Architectural Test")
       print("------------------------------------------------------------------------------------------")
@@ -5,7 +5,15 @@ module unit_tests #(
 
     // Memory size in bytes
     parameter MEMORY_SIZE   = 2097152     ,
-    parameter BOOT_ADDRESS  = 32'h00000000
+    parameter BOOT_ADDRESS  = 32'h00000000,
+    // Optional extensions (make m, make c and make zb)
+    parameter M_EXTENSION   = 0           ,
+    parameter C_EXTENSION   = 0           ,
+    parameter ZBA_ZBB_EXTENSION = 0       ,
+    // Separate instruction and data ports (make harvard)
+    parameter HARVARD       = 0           ,
+    // Jump targets kept by the core (make btb)
+    parameter BRANCH_TARGET_BUFFER = 0
 
   )(
     input   clock ,
@@ -22,6 +30,11 @@ module unit_tests #(
   wire           write_request;
   wire           write_response;
 
+  wire   [31:0]  instruction_read_address;
+  wire   [31:0]  instruction_read_data;
+  wire           instruction_read_request;
+  wire           instruction_read_response;
+
   // Real-time clock (unused)
 
   wire  [63:0]  real_time_clock;
@@ -45,7 +58,12 @@ module unit_tests #(
   wire          irq_software_response;
 
   rvx_core #(
-    .BOOT_ADDRESS(BOOT_ADDRESS)
+    .BOOT_ADDRESS(BOOT_ADDRESS),
+    .M_EXTENSION (M_EXTENSION ),
+    .C_EXTENSION (C_EXTENSION ),
+    .ZBA_ZBB_EXTENSION (ZBA_ZBB_EXTENSION),
+    .HARVARD     (HARVARD     ),
+    .BRANCH_TARGET_BUFFER (BRANCH_TARGET_BUFFER)
   ) rvx_core_instance (
 
     // Global signals
@@ -65,6 +83,13 @@ module unit_tests #(
     .write_request          (write_request        ),
     .write_response         (write_response       ),
 
+    // Instruction fetch interface
+
+    .instruction_read_address   (instruction_read_address ),
+    .instruction_read_data      (instruction_read_data    ),
+    .instruction_read_request   (instruction_read_request ),
+    .instruction_read_response  (instruction_read_response),
+
     // Interrupt request signals
 
     .irq_fast               (irq_fast             ),
@@ -84,7 +109,8 @@ module unit_tests #(
   );
 
   rvx_ram #(
-    .MEMORY_SIZE(MEMORY_SIZE)
+    .MEMORY_SIZE(MEMORY_SIZE),
+    .DUAL_PORT  (HARVARD    )
   ) rvx_ram_instance (
 
     // Global signals
@@ -101,7 +127,14 @@ module unit_tests #(
     .write_data             (write_data     ),
     .write_strobe           (write_strobe   ),
     .write_request          (write_request  ),
-    .write_response         (write_response )
+    .write_response         (write_response ),
+
+    // Instruction fetch interface
+
+    .instruction_read_address   (instruction_read_address ),
+    .instruction_read_data      (instruction_read_data    ),
+    .instruction_read_request   (instruction_read_request ),
+    .instruction_read_response  (instruction_read_response)
   );
 
   // Avoid warnings about intentionally unused pins/wires
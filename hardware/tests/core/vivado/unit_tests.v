@@ -47,6 +47,13 @@ module unit_tests();
     .write_response               (write_response &
                                    write_response_test          ),
   
+    // Instruction fetch interface (unused, HARVARD = 0)
+  
+    .instruction_read_address          (),
+    .instruction_read_data        (32'b0),
+    .instruction_read_request          (),
+    .instruction_read_response    (1'b0),
+  
     // Interrupt signals (hardwire inputs to zero if unused)
   
     .irq_external                 (1'b0),
@@ -88,7 +95,7 @@ module unit_tests();
   
   always #10 clock = !clock;
   
-  reg [167:0] unit_test_programs_array [0:53] = {
+  reg [167:0] unit_test_programs_array [0:54] = {
     "add-01.hex",
     "addi-01.hex",
     "and-01.hex",
@@ -111,6 +118,7 @@ module unit_tests();
     "lhu-align-01.hex",
     "lui-01.hex",
     "lw-align-01.hex",
+    "minstret-01.hex",
     "misalign-beq-01.hex",
     "misalign-bge-01.hex",
     "misalign-bgeu-01.hex",
@@ -145,7 +153,7 @@ module unit_tests();
     "xori-01.hex"
   };
   
-  reg [519:0] golden_reference_array [0:53] = {
+  reg [519:0] golden_reference_array [0:54] = {
     "add-01.reference.hex",
     "addi-01.reference.hex",
     "and-01.reference.hex",
@@ -168,6 +176,7 @@ module unit_tests();
     "lhu-align-01.reference.hex",
     "lui-01.reference.hex",
     "lw-align-01.reference.hex",
+    "minstret-01.reference.hex",
     "misalign-beq-01.reference.hex",
     "misalign-bge-01.reference.hex",
     "misalign-bgeu-01.reference.hex",
@@ -269,7 +278,7 @@ module unit_tests();
       
     $display("Running unit test programs from RISC-V Architectural Test Suite.");
     
-    for(k = 0; k < 54; k=k+1) begin
+    for(k = 0; k < 55; k=k+1) begin
     
       // Reset     
       reset = 1'b1;
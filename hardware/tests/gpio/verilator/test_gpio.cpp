@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+// Port of test_gpio.py to a native Verilator test bench
+
+#include <memory>
+
+#include "Vrvx_gpio.h"
+#include "bus_master.h"
+#include "test_runner.h"
+
+using Dut = Vrvx_gpio;
+
+static constexpr uint32_t REG_IN = 0 * 4;
+static constexpr uint32_t REG_OE = 1 * 4;
+static constexpr uint32_t REG_OUT = 2 * 4;
+static constexpr uint32_t REG_CLR = 3 * 4;
+static constexpr uint32_t REG_SET = 4 * 4;
+
+struct Bench
+{
+  std::unique_ptr<Dut> dut{new Dut};
+  BusMaster<Dut> bus{dut.get()};
+
+  Bench()
+  {
+    bus.reset();
+    bus.wait(10);
+  }
+};
+
+static void test_input()
+{
+  Bench b;
+
+  for (uint32_t value : {0x0, 0x3, 0x1})
+  {
+    b.dut->gpio_input = value;
+    b.bus.tick();
+    CHECK_EQ(value, b.bus.read_request(REG_IN));
+  }
+}
+
+static void test_output()
+{
+  Bench b;
+
+  for (uint32_t value : {0x0, 0x1, 0x3})
+  {
+    b.bus.write_request(REG_OUT, value);
+    CHECK_EQ(value, b.dut->gpio_output);
+    b.bus.wait(3);
+  }
+}
+
+static void test_enable()
+{
+  Bench b;
+
+  for (uint32_t value : {0x0, 0x1, 0x3})
+  {
+    b.bus.write_request(REG_OE, value);
+    CHECK_EQ(value, b.dut->gpio_oe);
+    b.bus.wait(3);
+  }
+}
+
+static void test_clear_mask()
+{
+  Bench b;
+
+  // gpio_output=0x0
+  b.bus.write_request(REG_OUT, 0x0);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+  b.bus.wait(3);
+
+  b.bus.write_request(REG_CLR, 0x0);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+  b.bus.write_request(REG_CLR, 0x1);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+  b.bus.write_request(REG_CLR, 0x3);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+
+  // gpio_output=0x1
+  b.bus.write_request(REG_OUT, 0x1);
+  CHECK_EQ(0x1, b.dut->gpio_output);
+  b.bus.wait(3);
+
+  b.bus.write_request(REG_CLR, 0x0);
+  CHECK_EQ(0x1, b.dut->gpio_output);
+  b.bus.write_request(REG_CLR, 0x2);
+  CHECK_EQ(0x1, b.dut->gpio_output);
+  b.bus.write_request(REG_CLR, 0x1);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+  b.bus.write_request(REG_CLR, 0x1);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+
+  // gpio_output=0x3
+  b.bus.write_request(REG_OUT, 0x3);
+  CHECK_EQ(0x3, b.dut->gpio_output);
+  b.bus.wait(3);
+
+  b.bus.write_request(REG_CLR, 0x0);
+  CHECK_EQ(0x3, b.dut->gpio_output);
+  b.bus.write_request(REG_CLR, 0x2);
+  CHECK_EQ(0x1, b.dut->gpio_output);
+  b.bus.write_request(REG_CLR, 0x1);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+  b.bus.write_request(REG_CLR, 0x1);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+}
+
+static void test_set_mask()
+{
+  Bench b;
+
+  // gpio_output=0x0
+  b.bus.write_request(REG_OUT, 0x0);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+  b.bus.wait(3);
+
+  b.bus.write_request(REG_SET, 0x0);
+  CHECK_EQ(0x0, b.dut->gpio_output);
+  b.bus.write_request(REG_SET, 0x1);
+  CHECK_EQ(0x1, b.dut->gpio_output);
+  b.bus.write_request(REG_SET, 0x0);
+  CHECK_EQ(0x1, b.dut->gpio_output);
+
+  // gpio_output=0x2
+  b.bus.write_request(REG_OUT, 0x2);
+  CHECK_EQ(0x2, b.dut->gpio_output);
+  b.bus.wait(3);
+
+  b.bus.write_request(REG_SET, 0x0);
+  CHECK_EQ(0x2, b.dut->gpio_output);
+  b.bus.write_request(REG_SET, 0x2);
+  CHECK_EQ(0x2, b.dut->gpio_output);
+  b.bus.write_request(REG_SET, 0x1);
+  CHECK_EQ(0x3, b.dut->gpio_output);
+}
+
+int main(int argc, char *argv[])
+{
+  return run_tests(
+      {
+          {"test_input", test_input},
+          {"test_output", test_output},
+          {"test_enable", test_enable},
+          {"test_clear_mask", test_clear_mask},
+          {"test_set_mask", test_set_mask},
+      },
+      argc, argv);
+}
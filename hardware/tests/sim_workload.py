@@ -0,0 +1,164 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2020-2025 RVX Project Contributors
+
+"""Reference workload for the Verilator simulators (mcu_sim and unit_tests).
+
+The workload is the set of RISC-V architectural test programs plus, when it has been built, the
+FreeRTOS example. It is used as the training run of the profile-guided builds (mcu_sim_fast and
+unit_tests_fast) and to measure their speedup over the default builds.
+
+  train:    runs the workload once; the merged Verilator profile (--prof-pgo) is written to
+            --profile-out, and the compiler profile (-fprofile-generate) is written by the
+            instrumented simulator itself
+  speedup:  runs the workload with two simulators and prints the wall time ratio
+"""
+
+import re
+import sys
+import time
+import argparse
+import tempfile
+import subprocess
+from pathlib import Path
+
+
+TESTS_DIR = Path(__file__).resolve().parent
+PROGRAMS_DIR = TESTS_DIR / 'core' / 'unit_tests' / 'programs'
+EXAMPLES_DIR = TESTS_DIR.parent.parent / 'examples'
+FREERTOS_BIN = EXAMPLES_DIR / 'freertos' / 'software' / 'build' / 'freertos.bin'
+
+# Common options of both simulators. Each architectural test ends by writing 1 to 0x1000.
+PROGRAM_FLAGS = ['--log-level=QUIET', '--wr-addr=0x00001000', '--cycles=500000']
+FREERTOS_FLAGS = ['--log-level=QUIET', '--cycles=2000000']
+
+
+def program_size(path: Path):
+    # Size in bytes of a memory init file in h32 format ('@' addresses are word indexes)
+    address = 0
+    end = 0
+    for token in path.read_text().split():
+        if token.startswith('@'):
+            address = int(token[1:], 16)
+        else:
+            address += 1
+            end = max(end, address)
+    return end * 4
+
+
+def workload(freertos: Path, ram_size: int):
+    runs = []
+    for program in sorted(PROGRAMS_DIR.glob('*.hex')):
+        if ram_size and program_size(program) > ram_size:
+            continue
+        runs.append([f'--ram-init-h32={program}'] + PROGRAM_FLAGS)
+
+    if freertos.is_file():
+        runs.append([f'--ram-init-bin={freertos}'] + FREERTOS_FLAGS)
+    else:
+        print(f'FreeRTOS example not found, skipped: {freertos}', file=sys.stderr)
+
+    return runs
+
+
+def run(sim: Path, runs, sim_flags, cwd=None):
+    start = time.perf_counter()
+    for flags in runs:
+        subprocess.run([str(sim)] + sim_flags + flags, cwd=cwd, check=True,
+                       stdout=subprocess.DEVNULL)
+    return time.perf_counter() - start
+
+
+def merge_profiles(paths, out: Path):
+    # Verilator writes one profile.vlt per run; the costs of the same entries are added together
+    costs = {}
+    header = []
+    for path in paths:
+        for line in path.read_text().splitlines():
+            match = re.search(r"-cost 64'd(\d+)", line)
+            if not match:
+                if line not in header:
+                    header.append(line)
+                continue
+            key = (line[:match.start()], line[match.end():])
+            costs[key] = costs.get(key, 0) + int(match.group(1))
+
+    lines = header
+    for (prefix, suffix), cost in costs.items():
+        lines.append(f"{prefix}-cost 64'd{cost}{suffix}")
+    out.write_text('\n'.join(lines) + '\n')
+
+
+def train(args):
+    runs = workload(args.freertos, args.ram_size)
+    sim = args.sim.resolve()
+    profiles = []
+
+    with tempfile.TemporaryDirectory() as tmp:
+        # Every run gets its own working directory, since profile.vlt is written to the current one
+        for i, flags in enumerate(runs):
+            cwd = Path(tmp) / str(i)
+            cwd.mkdir()
+            run(sim, [flags], args.sim_flags, cwd=cwd)
+            profile = cwd / 'profile.vlt'
+            if profile.is_file():
+                profiles.append(profile)
+
+        if args.profile_out:
+            if profiles:
+                merge_profiles(profiles, args.profile_out)
+            else:
+                # Keep the file so the optimized build can always include it
+                args.profile_out.write_text('`verilator_config\n')
+
+    print(f'Training finished: {len(runs)} runs')
+    return 0
+
+
+def speedup(args):
+    runs = workload(args.freertos, args.ram_size)
+
+    # The fastest of the repetitions is the least disturbed by other processes
+    baseline = min(run(args.baseline, runs, args.sim_flags) for _ in range(args.repeat))
+    fast = min(run(args.fast, runs, args.sim_flags) for _ in range(args.repeat))
+
+    print(f'{args.baseline}: {baseline:.3f} s')
+    print(f'{args.fast}: {fast:.3f} s')
+    print(f'Speedup: {baseline / fast:.2f}x')
+    return 0
+
+
+def main(argv=None):
+    if argv is None:
+        argv = sys.argv[1:]
+
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--freertos', type=Path, default=FREERTOS_BIN,
+                        help='FreeRTOS example binary (skipped if missing)')
+    parser.add_argument('--sim-flags', type=str, default='',
+                        help='Extra options passed to the simulators')
+    parser.add_argument('--ram-size', type=int, default=0,
+                        help='RAM size of the simulator in bytes, larger programs are skipped')
+
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    parser_train = commands.add_parser('train', help='Run the training workload')
+    parser_train.add_argument('--sim', type=Path, required=True, help='Instrumented simulator')
+    parser_train.add_argument('--profile-out', type=Path, default=None,
+                              help='Output file for the merged Verilator profile')
+
+    parser_speedup = commands.add_parser('speedup', help='Compare two simulators')
+    parser_speedup.add_argument('--baseline', type=Path, required=True, help='Default build')
+    parser_speedup.add_argument('--fast', type=Path, required=True, help='Optimized build')
+    parser_speedup.add_argument('--repeat', type=int, default=3, help='Repetitions of each run')
+
+    args = parser.parse_args(argv)
+    args.sim_flags = args.sim_flags.split()
+
+    if args.command == 'train':
+        return train(args)
+    return speedup(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -23,6 +23,8 @@ const char *help_str =
     "--cycles=<num>         Exit after processor cycles complete (default: 500000)\n"
     "                       Example: --cycles=10000\n\n"
     //    "--ecall            Exit if there is an instruction ecall\n"
+    "--wr-addr=<addr>       Exit if 1 is written to the specified address (default: 0x00000000 - off)\n"
+    "                       Example: --wr-addr=0x90000004\n\n"
 
     "--host-out=<addr>      Message output detection address (default: 0x00000000 - off)\n"
     "                       Example: --host-out=0x00000000\n"
@@ -41,6 +43,77 @@ const char *help_str =
     "--freq-ns=<name>       Clock frequency, set in (ns) (defaul: 10ns)\n"
     "Note:                  Min 2ns, Max 2^32ns\n\n"
 
+    "--stimulus=<name>      Drive uart_rx, poci and gpio_input from a time-stamped script\n"
+    "                       Example: --stimulus=uart_storm.txt\n\n"
+
+    "--serve=<socket>       Keep the model resident and take commands (load, reset, run, peek,\n"
+    "                       poke, reg) on a Unix domain socket instead of running the program\n"
+    "                       Example: --serve=/tmp/mcu_sim.sock\n\n"
+
+    "--gdb=<port>           Wait for a GDB connection on localhost:<port> (remote protocol)\n"
+    "                       Example: --gdb=3333\n\n"
+
+    "Time travel (with --serve or --gdb):\n"
+    "--checkpoint-interval=<cycles>\n"
+    "                       Snapshot the model every <cycles> cycles, enables goto and reverse\n"
+    "                       execution (default: 0, off)\n"
+    "--checkpoint-dir=<dir> Directory of the snapshots (default: a new one in /dev/shm or /tmp)\n"
+    "--checkpoint-max=<num> Snapshots kept, the oldest are dropped (default: 100)\n"
+    "--goto-cycle=<cycle>   Start the session at this cycle\n\n"
+
+    "Variants (one run to the fork point, then one child process per variant):\n"
+    "--variants=<name>      File with one variant per line: <name> [stimulus=<script>]\n"
+    "                       [cycles=<cycles after the fork>]\n"
+    "--fork-at=<cycle>      Cycle at which the variants start (default: 0, after the reset)\n"
+    "--fork-jobs=<num>      Variants run in parallel (default: number of cores)\n"
+    "--fork-report=<name>   Merged report of the variants (default: stdout)\n\n"
+
+    "Fault injection (from the --fork-at state, --fork-jobs in parallel, needs --wr-addr):\n"
+    "--fault-campaign=<num> Number of random bit flips\n"
+    "--fault-list=<name>    Scheduled bit flips, one per line: <cycle> <target> <bit>\n"
+    "--fault-targets=<list> Targets of the random flips: ram,reg,csr (default: all)\n"
+    "--fault-ram=<start>:<end>\n"
+    "                       RAM range of the random flips (default: the whole RAM)\n"
+    "--fault-signature=<start>:<end>\n"
+    "                       RAM range compared with the golden run, besides the console output\n"
+    "--fault-seed=<num>     Seed of the random flips (default: 1)\n"
+    "--fault-report=<name>  Campaign report (default: stdout)\n\n"
+
+    "System (several MCUs, one thread each, no waveform):\n"
+    "--system=<name>        Topology file: the MCUs, their programs and the pin links\n"
+    "                       Example: --system=sensor_gateway.txt\n"
+    "--quantum=<cycles>     Cycles run between two synchronizations of the MCUs, the delay of\n"
+    "                       the links (default: 100)\n\n"
+
+    "Sampled simulation (functional fast-forward, RTL measurement windows):\n"
+    "--sample-interval=<instructions>\n"
+    "                       Distance between the starts of two windows, enables the sampling.\n"
+    "                       --cycles then limits the instructions (0 = until --wr-addr)\n"
+    "                       Example: --sample-interval=1000000\n"
+    "--sample-warmup=<instructions>\n"
+    "                       Instructions run on the RTL model before a window (default: 2000)\n"
+    "--sample-window=<instructions>\n"
+    "                       Instructions measured in a window (default: 10000)\n"
+    "--sample-report=<name> CPI estimate and windows (default: stdout)\n\n"
+
+    "Profiling (reports are written when the simulation ends):\n"
+    "--bus-profile=<name>   Per-device bus transfers, bytes, wait cycles and address histogram\n"
+    "                       Example: --bus-profile=bus.txt\n"
+    "--bus-profile-bucket=<bytes>\n"
+    "                       Histogram granularity for the RAM (default: 256)\n\n"
+    "--cache-sim=<name>     Hit rates of cache configurations on the RAM accesses of the core\n"
+    "                       Example: --cache-sim=cache.txt\n"
+    "--cache-config=<kind>:<size>:<line size>:<ways>:<lru|fifo|random>\n"
+    "                       Cache to evaluate, may be repeated. Kind: i (fetches), d (loads and\n"
+    "                       stores) or u (unified). Default: i and d caches of 1K, 2K and 4K,\n"
+    "                       direct-mapped and 2-way, 16-byte lines, LRU\n"
+    "                       Example: --cache-config=i:4K:16:2:lru\n"
+    "--cache-latency=<num>  Cycles of an external memory access (default: 10)\n"
+    "--mem-trace=<name>     Write the RAM access trace (F/L/S <address> per line)\n\n"
+    "--irq-profile=<name>   Interrupt latency histograms per source and share of cycles in\n"
+    "                       interrupt handlers\n"
+    "                       Example: --irq-profile=irq.txt\n\n"
+
     "\n\n"
     "Example:\n"
     "unit_tests --ram-init-bin=add-01.bin"
@@ -57,11 +130,43 @@ enum opts
   cmd_ram_init_h32,
   cmd_ram_init_bin,
   cmd_cycles,
+  cmd_wr_addr,
   cmd_host_out,
   cmd_quiet,
   cmd_log_out,
   cmd_log_level,
   cmd_freq_ns,
+  cmd_bus_profile,
+  cmd_bus_profile_bucket,
+  cmd_cache_sim,
+  cmd_cache_config,
+  cmd_cache_latency,
+  cmd_mem_trace,
+  cmd_irq_profile,
+  cmd_stimulus,
+  cmd_serve,
+  cmd_gdb,
+  cmd_checkpoint_interval,
+  cmd_checkpoint_dir,
+  cmd_checkpoint_max,
+  cmd_goto_cycle,
+  cmd_fork_at,
+  cmd_variants,
+  cmd_fork_jobs,
+  cmd_fork_report,
+  cmd_fault_campaign,
+  cmd_fault_list,
+  cmd_fault_targets,
+  cmd_fault_ram,
+  cmd_fault_signature,
+  cmd_fault_seed,
+  cmd_fault_report,
+  cmd_system,
+  cmd_quantum,
+  cmd_sample_interval,
+  cmd_sample_warmup,
+  cmd_sample_window,
+  cmd_sample_report,
 };
 
 static constexpr option long_opts[] =
@@ -71,11 +176,43 @@ static constexpr option long_opts[] =
         {"ram-init-h32", required_argument, NULL, opts::cmd_ram_init_h32},
         {"ram-init-bin", required_argument, NULL, opts::cmd_ram_init_bin},
         {"cycles", required_argument, NULL, opts::cmd_cycles},
+        {"wr-addr", required_argument, NULL, opts::cmd_wr_addr},
         {"host-out", required_argument, NULL, opts::cmd_host_out},
         {"quiet", no_argument, NULL, opts::cmd_quiet},
         {"log-out", required_argument, NULL, opts::cmd_log_out},
         {"log-level", required_argument, NULL, opts::cmd_log_level},
         {"freq-ns", required_argument, NULL, opts::cmd_freq_ns},
+        {"bus-profile", required_argument, NULL, opts::cmd_bus_profile},
+        {"bus-profile-bucket", required_argument, NULL, opts::cmd_bus_profile_bucket},
+        {"cache-sim", required_argument, NULL, opts::cmd_cache_sim},
+        {"cache-config", required_argument, NULL, opts::cmd_cache_config},
+        {"cache-latency", required_argument, NULL, opts::cmd_cache_latency},
+        {"mem-trace", required_argument, NULL, opts::cmd_mem_trace},
+        {"irq-profile", required_argument, NULL, opts::cmd_irq_profile},
+        {"stimulus", required_argument, NULL, opts::cmd_stimulus},
+        {"serve", required_argument, NULL, opts::cmd_serve},
+        {"gdb", required_argument, NULL, opts::cmd_gdb},
+        {"checkpoint-interval", required_argument, NULL, opts::cmd_checkpoint_interval},
+        {"checkpoint-dir", required_argument, NULL, opts::cmd_checkpoint_dir},
+        {"checkpoint-max", required_argument, NULL, opts::cmd_checkpoint_max},
+        {"goto-cycle", required_argument, NULL, opts::cmd_goto_cycle},
+        {"fork-at", required_argument, NULL, opts::cmd_fork_at},
+        {"variants", required_argument, NULL, opts::cmd_variants},
+        {"fork-jobs", required_argument, NULL, opts::cmd_fork_jobs},
+        {"fork-report", required_argument, NULL, opts::cmd_fork_report},
+        {"fault-campaign", required_argument, NULL, opts::cmd_fault_campaign},
+        {"fault-list", required_argument, NULL, opts::cmd_fault_list},
+        {"fault-targets", required_argument, NULL, opts::cmd_fault_targets},
+        {"fault-ram", required_argument, NULL, opts::cmd_fault_ram},
+        {"fault-signature", required_argument, NULL, opts::cmd_fault_signature},
+        {"fault-seed", required_argument, NULL, opts::cmd_fault_seed},
+        {"fault-report", required_argument, NULL, opts::cmd_fault_report},
+        {"system", required_argument, NULL, opts::cmd_system},
+        {"quantum", required_argument, NULL, opts::cmd_quantum},
+        {"sample-interval", required_argument, NULL, opts::cmd_sample_interval},
+        {"sample-warmup", required_argument, NULL, opts::cmd_sample_warmup},
+        {"sample-window", required_argument, NULL, opts::cmd_sample_window},
+        {"sample-report", required_argument, NULL, opts::cmd_sample_report},
         {NULL, no_argument, NULL, 0}};
 
 static size_t get_int_arg(const char *arg)
@@ -84,6 +221,18 @@ static size_t get_int_arg(const char *arg)
   return strtoull(arg, &p, 0);
 }
 
+// <start>:<end> byte addresses, end excluded
+static void get_range_arg(const char *arg, uint32_t &start, uint32_t &end)
+{
+  char *p;
+  start = strtoul(arg, &p, 0);
+  if (*p != ':' || (end = strtoul(p + 1, &p, 0)) <= start || *p)
+  {
+    Log::error("Invalid range: %s", arg);
+    std::exit(EXIT_FAILURE);
+  }
+}
+
 Args parser(int argc, char *argv[])
 {
   Args args;
@@ -119,6 +268,11 @@ Args parser(int argc, char *argv[])
       Log::info("Max cycles: %u", args.max_cycles);
       break;
 
+    case opts::cmd_wr_addr:
+      args.wr_addr = get_int_arg(optarg);
+      Log::info("Write address: 0x%x", args.wr_addr);
+      break;
+
     case opts::cmd_host_out:
       args.host_out = get_int_arg(optarg);
       Log::info("Host out: 0x%x", args.host_out);
@@ -141,11 +295,161 @@ Args parser(int argc, char *argv[])
       Log::info("Clock frequency: %u(ns)", args.freq);
       break;
 
+    case opts::cmd_bus_profile:
+      args.bus_profile_path = optarg;
+      Log::info("Bus profile: %s", optarg);
+      break;
+
+    case opts::cmd_bus_profile_bucket:
+      args.bus_profile_bucket = get_int_arg(optarg);
+      if (args.bus_profile_bucket < 4 || (args.bus_profile_bucket & (args.bus_profile_bucket - 1)))
+      {
+        Log::error("Bus profile bucket must be a power of 2 not less than 4");
+        std::exit(EXIT_FAILURE);
+      }
+      break;
+
+    case opts::cmd_cache_sim:
+      args.cache_sim_path = optarg;
+      Log::info("Cache simulation: %s", optarg);
+      break;
+
+    case opts::cmd_cache_config:
+      args.cache_configs.push_back(optarg);
+      break;
+
+    case opts::cmd_cache_latency:
+      args.cache_latency = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_mem_trace:
+      args.mem_trace_path = optarg;
+      Log::info("Memory trace: %s", optarg);
+      break;
+
+    case opts::cmd_irq_profile:
+      args.irq_profile_path = optarg;
+      Log::info("Interrupt profile: %s", optarg);
+      break;
+
+    case opts::cmd_stimulus:
+      args.stimulus_path = optarg;
+      Log::info("Stimulus: %s", optarg);
+      break;
+
+    case opts::cmd_serve:
+      args.serve_path = optarg;
+      break;
+
+    case opts::cmd_gdb:
+      args.gdb_port = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_checkpoint_interval:
+      args.checkpoint_interval = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_checkpoint_dir:
+      args.checkpoint_dir = optarg;
+      break;
+
+    case opts::cmd_checkpoint_max:
+      args.checkpoint_max = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_goto_cycle:
+      args.goto_cycle = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_fork_at:
+      args.fork_at = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_variants:
+      args.variants_path = optarg;
+      Log::info("Variants: %s", optarg);
+      break;
+
+    case opts::cmd_fork_jobs:
+      args.fork_jobs = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_fork_report:
+      args.fork_report_path = optarg;
+      break;
+
+    case opts::cmd_fault_campaign:
+      args.fault_count = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_fault_list:
+      args.fault_list_path = optarg;
+      Log::info("Fault list: %s", optarg);
+      break;
+
+    case opts::cmd_fault_targets:
+      args.fault_targets = optarg;
+      break;
+
+    case opts::cmd_fault_ram:
+      get_range_arg(optarg, args.fault_ram_start, args.fault_ram_end);
+      break;
+
+    case opts::cmd_fault_signature:
+      get_range_arg(optarg, args.fault_signature_start, args.fault_signature_end);
+      break;
+
+    case opts::cmd_fault_seed:
+      args.fault_seed = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_fault_report:
+      args.fault_report_path = optarg;
+      break;
+
+    case opts::cmd_system:
+      args.system_path = optarg;
+      Log::info("System: %s", optarg);
+      break;
+
+    case opts::cmd_quantum:
+      args.quantum = get_int_arg(optarg);
+      if (!args.quantum)
+      {
+        Log::error("Invalid quantum: %s", optarg);
+        std::exit(EXIT_FAILURE);
+      }
+      break;
+
+    case opts::cmd_sample_interval:
+      args.sample_interval = get_int_arg(optarg);
+      Log::info("Sample interval: %llu", (unsigned long long)args.sample_interval);
+      break;
+
+    case opts::cmd_sample_warmup:
+      args.sample_warmup = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_sample_window:
+      args.sample_window = get_int_arg(optarg);
+      break;
+
+    case opts::cmd_sample_report:
+      args.sample_report_path = optarg;
+      break;
+
     default:
       Log::info("Please call for help: --help\n");
       std::exit(EXIT_SUCCESS);
     }
   }
 
+  if (args.sample_interval &&
+      (!args.sample_window || args.sample_warmup + args.sample_window > args.sample_interval))
+  {
+    Log::error("The sample warm-up and window must fit in --sample-interval");
+    std::exit(EXIT_FAILURE);
+  }
+
   return args;
 }
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <vector>
 
 enum RamInitVariants
 {
@@ -20,8 +21,42 @@ struct Args
   char *ram_init_path{nullptr};
   RamInitVariants ram_init_variants{NONE};
   uint32_t max_cycles{500000};
+  uint32_t wr_addr{0x00000000};
   uint32_t host_out{0x00000000};
   uint32_t freq{100};
+  char *bus_profile_path{nullptr};
+  uint32_t bus_profile_bucket{256};
+  char *cache_sim_path{nullptr};
+  std::vector<const char *> cache_configs;
+  uint32_t cache_latency{10};
+  char *mem_trace_path{nullptr};
+  char *irq_profile_path{nullptr};
+  char *stimulus_path{nullptr};
+  char *serve_path{nullptr};
+  uint16_t gdb_port{0};
+  uint64_t checkpoint_interval{0};
+  char *checkpoint_dir{nullptr};
+  uint32_t checkpoint_max{100};
+  uint64_t goto_cycle{0};
+  uint64_t fork_at{0};
+  char *variants_path{nullptr};
+  uint32_t fork_jobs{0};
+  char *fork_report_path{nullptr};
+  uint32_t fault_count{0};
+  char *fault_list_path{nullptr};
+  char *fault_targets{nullptr};
+  uint32_t fault_ram_start{0};
+  uint32_t fault_ram_end{0};
+  uint32_t fault_signature_start{0};
+  uint32_t fault_signature_end{0};
+  uint64_t fault_seed{1};
+  char *fault_report_path{nullptr};
+  char *system_path{nullptr};
+  uint64_t quantum{100};
+  uint64_t sample_interval{0};
+  uint64_t sample_warmup{2000};
+  uint64_t sample_window{10000};
+  char *sample_report_path{nullptr};
 };
 
 Args parser(int argc, char *argv[]);
@@ -0,0 +1,342 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+// Microbenchmarks for the simulation harness. They measure how much wall time goes to the harness
+// components (RAM initialization, logging, argument parsing) and how much to the Verilated model
+// itself, and export the results as JSON so that regressions in harness overhead can be tracked.
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <getopt.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <verilated_fst_c.h>
+
+#include "Vmcu_sim.h"
+#include "Vmcu_sim___024root.h"
+#include "argparse.h"
+#include "log.h"
+#include "ram_init.h"
+
+using Dut = Vmcu_sim;
+using Trace = VerilatedFstC;
+using Clock = std::chrono::steady_clock;
+
+struct BenchArgs
+{
+  const char *json_path{nullptr};
+  uint32_t image_words{4 * 1024 * 1024};
+  uint32_t log_messages{1000000};
+  uint32_t argparse_runs{100000};
+  uint64_t eval_cycles{1000000};
+  uint64_t trace_cycles{100000};
+};
+
+struct Result
+{
+  std::string name;
+  uint64_t operations;
+  double seconds;
+  const char *unit;
+};
+
+static std::vector<Result> results;
+
+static const char *help_str =
+    "Use: mcu_sim_bench [options]\n"
+    "Options:\n"
+    "--json=<file>          Output file for the results in JSON format (default: stdout)\n\n"
+    "--image-words=<num>    Size of the RAM images in 32-bit words (default: 4194304)\n\n"
+    "--log-messages=<num>   Number of log messages and host-out characters (default: 1000000)\n\n"
+    "--argparse-runs=<num>  Number of command line parsings (default: 100000)\n\n"
+    "--eval-cycles=<num>    Clock cycles of the eval loop without tracing (default: 1000000)\n\n"
+    "--trace-cycles=<num>   Clock cycles of the eval loop with tracing (default: 100000)\n\n";
+
+enum opts
+{
+  cmd_help = 0,
+
+  cmd_json,
+  cmd_image_words,
+  cmd_log_messages,
+  cmd_argparse_runs,
+  cmd_eval_cycles,
+  cmd_trace_cycles,
+};
+
+static constexpr option long_opts[] = {
+    {"help", no_argument, NULL, opts::cmd_help},
+    {"json", required_argument, NULL, opts::cmd_json},
+    {"image-words", required_argument, NULL, opts::cmd_image_words},
+    {"log-messages", required_argument, NULL, opts::cmd_log_messages},
+    {"argparse-runs", required_argument, NULL, opts::cmd_argparse_runs},
+    {"eval-cycles", required_argument, NULL, opts::cmd_eval_cycles},
+    {"trace-cycles", required_argument, NULL, opts::cmd_trace_cycles},
+    {NULL, 0, NULL, 0},
+};
+
+static BenchArgs bench_parser(int argc, char *argv[])
+{
+  BenchArgs args;
+  int opt;
+
+  while ((opt = getopt_long(argc, argv, "", long_opts, NULL)) != -1)
+  {
+    switch (opt)
+    {
+    case opts::cmd_json:
+      args.json_path = optarg;
+      break;
+
+    case opts::cmd_image_words:
+      args.image_words = strtoul(optarg, NULL, 0);
+      break;
+
+    case opts::cmd_log_messages:
+      args.log_messages = strtoul(optarg, NULL, 0);
+      break;
+
+    case opts::cmd_argparse_runs:
+      args.argparse_runs = strtoul(optarg, NULL, 0);
+      break;
+
+    case opts::cmd_eval_cycles:
+      args.eval_cycles = strtoull(optarg, NULL, 0);
+      break;
+
+    case opts::cmd_trace_cycles:
+      args.trace_cycles = strtoull(optarg, NULL, 0);
+      break;
+
+    default:
+      std::cout << help_str;
+      std::exit(EXIT_SUCCESS);
+    }
+  }
+
+  return args;
+}
+
+static void measure(const char *name, uint64_t operations, const char *unit,
+                    const std::function<void()> &body)
+{
+  auto start = Clock::now();
+  body();
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+
+  results.push_back({name, operations, elapsed.count(), unit});
+  std::fprintf(stderr, "%-24s %12.3f ms %16.1f %s/s\n", name, elapsed.count() * 1e3,
+               operations / elapsed.count(), unit);
+}
+
+static std::string temp_path(const char *suffix)
+{
+  std::string path = std::string("/tmp/mcu_sim_bench_XXXXXX") + suffix;
+  int fd = mkstemps(&path[0], strlen(suffix));
+  if (fd < 0)
+  {
+    std::perror("mkstemps");
+    std::exit(EXIT_FAILURE);
+  }
+  close(fd);
+  return path;
+}
+
+static void bench_ram_init(const BenchArgs &args)
+{
+  std::vector<uint32_t> ram(args.image_words);
+  auto write = [&ram](uint32_t i, uint32_t v) { ram[i] = v; };
+
+  // Same layout objcopy generates: an address line followed by lines of four words
+  std::string h32_path = temp_path(".hex");
+  {
+    std::ofstream file(h32_path);
+    file << "@00000000\n";
+    for (uint32_t i = 0; i < args.image_words; i++)
+    {
+      char word[10];
+      std::snprintf(word, sizeof(word), "%08X", i * 2654435761u);
+      file << word << ((i % 4 == 3) ? "\n" : " ");
+    }
+  }
+
+  std::string bin_path = temp_path(".bin");
+  {
+    std::ofstream file(bin_path, std::ios::binary);
+    for (uint32_t i = 0; i < args.image_words; i++)
+    {
+      uint32_t word = i * 2654435761u;
+      file.write(reinterpret_cast<const char *>(&word), sizeof(word));
+    }
+  }
+
+  measure("ram_init_h32", args.image_words, "words",
+          [&]() { ram_init_h32(h32_path.c_str(), args.image_words, write); });
+  measure("ram_init_bin", args.image_words, "words",
+          [&]() { ram_init_bin(bin_path.c_str(), args.image_words, write); });
+
+  std::remove(h32_path.c_str());
+  std::remove(bin_path.c_str());
+}
+
+static void bench_log(const BenchArgs &args)
+{
+  // Messages are written to a file so that terminal speed does not affect the results
+  std::string log_path = temp_path(".log");
+  Log::set_out(log_path);
+  Log::set_level(Log::DEBUG);
+
+  measure("log_message", args.log_messages, "messages", [&]() {
+    for (uint32_t i = 0; i < args.log_messages; i++)
+    {
+      Log::info("Host out: 0x%x", i);
+    }
+  });
+
+  measure("log_host_out", args.log_messages, "chars", [&]() {
+    for (uint32_t i = 0; i < args.log_messages; i++)
+    {
+      Log::host_out((char)('a' + i % 26));
+    }
+  });
+
+  Log::set_level(Log::QUIET);
+  std::remove(log_path.c_str());
+}
+
+static void bench_argparse(const BenchArgs &args)
+{
+  char arg0[] = "mcu_sim";
+  char arg1[] = "--ram-init-bin=program.bin";
+  char arg2[] = "--cycles=1000000";
+  char arg3[] = "--wr-addr=0x90000004";
+  char arg4[] = "--host-out=0x90000000";
+  char arg5[] = "--freq-ns=2";
+  char *argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, nullptr};
+  int argc = 6;
+
+  measure("argparse", args.argparse_runs, "parses", [&]() {
+    for (uint32_t i = 0; i < args.argparse_runs; i++)
+    {
+      // Restart the scanning of getopt_long
+      optind = 0;
+      parser(argc, argv);
+    }
+  });
+}
+
+static void run_cycles(Dut *dut, Trace *trace, uint64_t cycles)
+{
+  vluint64_t time = 0;
+
+  dut->reset = 1;
+  for (int i = 0; i < 10; i++)
+  {
+    dut->clock ^= 1;
+    dut->eval();
+  }
+  dut->reset = 0;
+  dut->halt = 0;
+
+  // Raw eval loop, one eval per clock edge
+  for (uint64_t i = 0; i < cycles * 2; i++)
+  {
+    dut->clock ^= 1;
+    dut->eval();
+    if (trace)
+    {
+      trace->dump(time++);
+    }
+  }
+}
+
+static void bench_eval(const BenchArgs &args)
+{
+  {
+    Dut *dut = new Dut;
+    // The RAM is filled with jal x0, 0 so the core stays busy fetching
+    for (uint32_t i = 0; i < dut->rootp->mcu_sim__DOT__rvx_instance__DOT__MEMORY_SIZE / 4; i++)
+    {
+      dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[i] = 0x0000006f;
+    }
+    measure("eval", args.eval_cycles, "cycles",
+            [&]() { run_cycles(dut, nullptr, args.eval_cycles); });
+    dut->final();
+    delete dut;
+  }
+
+  {
+    std::string wave_path = temp_path(".fst");
+    Dut *dut = new Dut;
+    Trace *trace = new Trace;
+    for (uint32_t i = 0; i < dut->rootp->mcu_sim__DOT__rvx_instance__DOT__MEMORY_SIZE / 4; i++)
+    {
+      dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[i] = 0x0000006f;
+    }
+    Verilated::traceEverOn(true);
+    dut->trace(trace, 99);
+    trace->open(wave_path.c_str());
+    measure("eval_trace", args.trace_cycles, "cycles",
+            [&]() { run_cycles(dut, trace, args.trace_cycles); });
+    trace->close();
+    dut->final();
+    delete trace;
+    delete dut;
+    std::remove(wave_path.c_str());
+  }
+}
+
+static void write_json(const char *path)
+{
+  std::ofstream file;
+  std::ostream *out = &std::cout;
+
+  if (path)
+  {
+    file.open(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+      std::fprintf(stderr, "Error file opening: %s\n", path);
+      std::exit(EXIT_FAILURE);
+    }
+    out = &file;
+  }
+
+  *out << "{\n  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    const Result &r = results[i];
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "    {\"name\": \"%s\", \"operations\": %llu, \"unit\": \"%s\", "
+                  "\"seconds\": %.6f, \"per_second\": %.1f, \"ns_per_operation\": %.3f}",
+                  r.name.c_str(), (unsigned long long)r.operations, r.unit, r.seconds,
+                  r.operations / r.seconds, r.seconds * 1e9 / r.operations);
+    *out << line << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  *out << "  ]\n}\n";
+}
+
+int main(int argc, char *argv[])
+{
+  BenchArgs args = bench_parser(argc, argv);
+
+  // Harness messages would otherwise be part of the measurements
+  Log::set_level(Log::QUIET);
+
+  bench_ram_init(args);
+  bench_log(args);
+  bench_argparse(args);
+  bench_eval(args);
+
+  write_json(args.json_path);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "bus_monitor.h"
+
+#include <cstdio>
+
+BusMonitor::BusMonitor(const std::vector<BusDevice> &devices)
+    : devices(devices), stats(devices.size() + 1)
+{
+}
+
+size_t BusMonitor::device_index(uint32_t device_sel) const
+{
+  for (size_t i = 0; i < devices.size(); i++)
+  {
+    if (device_sel & (1u << i))
+    {
+      return i;
+    }
+  }
+
+  // Unmapped address: rvx_bus responds immediately without selecting any device
+  return devices.size();
+}
+
+BusMonitor::Bucket &BusMonitor::bucket(size_t device, uint32_t address)
+{
+  uint32_t size = device < devices.size() ? devices[device].histogram_bucket : 4;
+  return stats[device].histogram[address & ~(size - 1)];
+}
+
+void BusMonitor::sample(const BusSample &s)
+{
+  cycles++;
+
+  // Response phase of the transfer requested in a previous cycle
+  if (pending)
+  {
+    DeviceStats &device = stats[pending_device];
+    bool mapped = pending_device < devices.size();
+    bool response = !mapped || (pending_write ? s.write_response : s.read_response);
+
+    if (mapped && !(s.device_sel_save & (1u << pending_device)))
+    {
+      // The core withdrew the request (e.g. a trap was taken), nothing was transferred
+      pending = false;
+    }
+    else if (!response)
+    {
+      device.wait_cycles++;
+      bucket(pending_device, pending_address).wait_cycles++;
+    }
+    else
+    {
+      if (pending_write)
+      {
+        device.writes++;
+        device.bytes_written += __builtin_popcount(pending_strobe);
+        bucket(pending_device, pending_address).writes++;
+      }
+      else
+      {
+        device.reads++;
+        device.bytes_read += 4;
+        bucket(pending_device, pending_address).reads++;
+      }
+      pending = false;
+    }
+  }
+
+  // While a transfer waits for its response, the core keeps presenting the same request
+  if (!pending && (s.read_request || s.write_request))
+  {
+    pending = true;
+    pending_write = s.write_request;
+    pending_address = s.address;
+    pending_strobe = s.write_strobe;
+    pending_device = device_index(s.device_sel);
+  }
+}
+
+void BusMonitor::report(std::ostream &out) const
+{
+  char line[256];
+
+  std::snprintf(line, sizeof(line), "Bus profile: %llu cycles\n\n", (unsigned long long)cycles);
+  out << line;
+
+  std::snprintf(line, sizeof(line), "%-10s %12s %12s %14s %14s %12s %9s\n", "Device", "Reads",
+                "Writes", "Bytes read", "Bytes written", "Wait cycles", "Bus load");
+  out << line;
+
+  for (size_t i = 0; i < stats.size(); i++)
+  {
+    const DeviceStats &d = stats[i];
+    const char *name = i < devices.size() ? devices[i].name.c_str() : "unmapped";
+    // Cycles in which the device kept the bus busy: one per transfer plus the wait cycles
+    double load = cycles ? 100.0 * (d.reads + d.writes + d.wait_cycles) / cycles : 0.0;
+    std::snprintf(line, sizeof(line), "%-10s %12llu %12llu %14llu %14llu %12llu %8.2f%%\n", name,
+                  (unsigned long long)d.reads, (unsigned long long)d.writes,
+                  (unsigned long long)d.bytes_read, (unsigned long long)d.bytes_written,
+                  (unsigned long long)d.wait_cycles, load);
+    out << line;
+  }
+
+  for (size_t i = 0; i < stats.size(); i++)
+  {
+    const DeviceStats &d = stats[i];
+    if (d.histogram.empty())
+    {
+      continue;
+    }
+
+    const char *name = i < devices.size() ? devices[i].name.c_str() : "unmapped";
+    uint32_t size = i < devices.size() ? devices[i].histogram_bucket : 4;
+    std::snprintf(line, sizeof(line), "\nAddress histogram: %s (%u-byte buckets)\n", name, size);
+    out << line;
+    std::snprintf(line, sizeof(line), "%-10s %12s %12s %12s\n", "Address", "Reads", "Writes",
+                  "Wait cycles");
+    out << line;
+
+    for (const auto &entry : d.histogram)
+    {
+      std::snprintf(line, sizeof(line), "0x%08x %12llu %12llu %12llu\n", entry.first,
+                    (unsigned long long)entry.second.reads,
+                    (unsigned long long)entry.second.writes,
+                    (unsigned long long)entry.second.wait_cycles);
+      out << line;
+    }
+  }
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef BUS_MONITOR_H
+#define BUS_MONITOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Signals of rvx_bus sampled at the rising edge of the clock, before the edge is evaluated
+struct BusSample
+{
+  uint32_t address;
+  bool read_request;
+  bool write_request;
+  uint8_t write_strobe;
+  uint32_t device_sel;
+  uint32_t device_sel_save;
+  bool read_response;
+  bool write_response;
+};
+
+struct BusDevice
+{
+  std::string name;
+  uint32_t start_address;
+  // Granularity of the address histogram in bytes (power of 2)
+  uint32_t histogram_bucket;
+};
+
+// Per-device bus profiler. A transfer starts in the cycle its request is sampled with the device
+// selected, and completes in the first following cycle in which the device (selected by
+// device_sel_save) responds. Every following cycle without a response is a wait cycle.
+class BusMonitor
+{
+public:
+  explicit BusMonitor(const std::vector<BusDevice> &devices);
+
+  void sample(const BusSample &s);
+  void report(std::ostream &out) const;
+
+private:
+  struct Bucket
+  {
+    uint64_t reads{0};
+    uint64_t writes{0};
+    uint64_t wait_cycles{0};
+  };
+
+  struct DeviceStats
+  {
+    uint64_t reads{0};
+    uint64_t writes{0};
+    uint64_t bytes_read{0};
+    uint64_t bytes_written{0};
+    uint64_t wait_cycles{0};
+    std::map<uint32_t, Bucket> histogram;
+  };
+
+  std::vector<BusDevice> devices;
+  // One entry per device plus one for unmapped addresses
+  std::vector<DeviceStats> stats;
+  uint64_t cycles{0};
+
+  // Transfer waiting for its response
+  bool pending{false};
+  bool pending_write{false};
+  uint32_t pending_address{0};
+  uint8_t pending_strobe{0};
+  size_t pending_device{0};
+
+  size_t device_index(uint32_t device_sel) const;
+  Bucket &bucket(size_t device, uint32_t address);
+};
+
+#endif // BUS_MONITOR_H
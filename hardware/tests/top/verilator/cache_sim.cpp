@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "cache_sim.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+static bool parse_size(const std::string &text, uint32_t &value)
+{
+  char *end;
+  unsigned long number = std::strtoul(text.c_str(), &end, 0);
+
+  if (end == text.c_str())
+  {
+    return false;
+  }
+
+  if (*end == 'K' || *end == 'k')
+  {
+    number *= 1024;
+    end++;
+  }
+
+  value = number;
+  return *end == '\0';
+}
+
+static bool is_power_of_2(uint32_t value)
+{
+  return value && !(value & (value - 1));
+}
+
+bool CacheConfig::parse(const std::string &description)
+{
+  std::vector<std::string> fields;
+  std::stringstream ss(description);
+  std::string field;
+
+  while (std::getline(ss, field, ':'))
+  {
+    fields.push_back(field);
+  }
+
+  if (fields.size() != 5)
+  {
+    return false;
+  }
+
+  if (fields[0] == "i")
+    kind = CacheKind::INSTRUCTION;
+  else if (fields[0] == "d")
+    kind = CacheKind::DATA;
+  else if (fields[0] == "u")
+    kind = CacheKind::UNIFIED;
+  else
+    return false;
+
+  if (!parse_size(fields[1], size) || !parse_size(fields[2], line_size) ||
+      !parse_size(fields[3], ways))
+  {
+    return false;
+  }
+
+  if (fields[4] == "lru")
+    replacement = Replacement::LRU;
+  else if (fields[4] == "fifo")
+    replacement = Replacement::FIFO;
+  else if (fields[4] == "random")
+    replacement = Replacement::RANDOM;
+  else
+    return false;
+
+  // The line size must hold at least one word and the cache at least one set
+  return is_power_of_2(size) && is_power_of_2(line_size) && is_power_of_2(ways) &&
+         line_size >= 4 && size >= line_size * ways;
+}
+
+std::string CacheConfig::name() const
+{
+  static const char *kinds[] = {"I", "D", "U"};
+  static const char *policies[] = {"lru", "fifo", "random"};
+  char text[64];
+
+  std::snprintf(text, sizeof(text), "%s %uB %uB/line %u-way %s", kinds[(int)kind], size,
+                line_size, ways, policies[(int)replacement]);
+  return text;
+}
+
+Cache::Cache(const CacheConfig &config)
+    : config(config), sets(config.size / (config.line_size * config.ways)),
+      lines(config.size / config.line_size)
+{
+}
+
+bool Cache::accepts(AccessType type) const
+{
+  switch (config.kind)
+  {
+  case CacheKind::INSTRUCTION:
+    return type == AccessType::FETCH;
+  case CacheKind::DATA:
+    return type != AccessType::FETCH;
+  default:
+    return true;
+  }
+}
+
+size_t Cache::victim(size_t first)
+{
+  size_t selected = first;
+
+  for (size_t i = first; i < first + config.ways; i++)
+  {
+    if (!lines[i].valid)
+    {
+      return i;
+    }
+  }
+
+  switch (config.replacement)
+  {
+  case Replacement::LRU:
+    for (size_t i = first; i < first + config.ways; i++)
+      if (lines[i].last_use < lines[selected].last_use)
+        selected = i;
+    break;
+
+  case Replacement::FIFO:
+    for (size_t i = first; i < first + config.ways; i++)
+      if (lines[i].inserted < lines[selected].inserted)
+        selected = i;
+    break;
+
+  case Replacement::RANDOM:
+    // xorshift32, deterministic so that runs are reproducible
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    selected = first + random_state % config.ways;
+    break;
+  }
+
+  return selected;
+}
+
+void Cache::access(uint32_t address, AccessType type)
+{
+  if (!accepts(type))
+  {
+    return;
+  }
+
+  time++;
+  accesses++;
+
+  uint32_t line_address = address / config.line_size;
+  uint32_t set = line_address % sets;
+  uint32_t tag = line_address / sets;
+  size_t first = (size_t)set * config.ways;
+
+  for (size_t i = first; i < first + config.ways; i++)
+  {
+    if (lines[i].valid && lines[i].tag == tag)
+    {
+      lines[i].last_use = time;
+      lines[i].dirty |= type == AccessType::STORE;
+      return;
+    }
+  }
+
+  misses++;
+
+  Line &line = lines[victim(first)];
+  if (line.valid && line.dirty)
+  {
+    writebacks++;
+  }
+  line.valid = true;
+  line.dirty = type == AccessType::STORE;
+  line.tag = tag;
+  line.last_use = time;
+  line.inserted = time;
+}
+
+void Cache::report(std::ostream &out, uint32_t latency) const
+{
+  // Without a cache every access pays the latency of the external memory. With it, each miss and
+  // each write-back transfers a whole line: the latency plus one cycle per additional word.
+  uint64_t line_cycles = latency + config.line_size / 4 - 1;
+  uint64_t uncached = accesses * latency;
+  uint64_t cached = (misses + writebacks) * line_cycles;
+  double hit_rate = accesses ? 100.0 * (accesses - misses) / accesses : 0.0;
+  char line[256];
+
+  std::snprintf(line, sizeof(line), "%-30s %12llu %12llu %8.2f%% %12llu %14lld\n",
+                config.name().c_str(), (unsigned long long)accesses, (unsigned long long)misses,
+                hit_rate, (unsigned long long)writebacks, (long long)uncached - (long long)cached);
+  out << line;
+}
+
+CacheMonitor::CacheMonitor(const std::vector<CacheConfig> &configs, uint32_t latency,
+                           const char *trace_path)
+    : latency(latency)
+{
+  for (const CacheConfig &config : configs)
+  {
+    caches.emplace_back(config);
+  }
+
+  if (trace_path)
+  {
+    trace.open(trace_path, std::ios::out | std::ios::trunc);
+  }
+}
+
+void CacheMonitor::access(uint32_t address, AccessType type)
+{
+  counts[(int)type]++;
+
+  if (trace.is_open())
+  {
+    static const char types[] = {'F', 'L', 'S'};
+    char line[16];
+    std::snprintf(line, sizeof(line), "%c %08x\n", types[(int)type], address);
+    trace << line;
+  }
+
+  for (Cache &cache : caches)
+  {
+    cache.access(address, type);
+  }
+}
+
+void CacheMonitor::sample(const BusSample &s, bool load_request)
+{
+  // Same handshake tracking as BusMonitor: an access is counted once, when it completes, however
+  // many cycles the core holds the request
+  if (pending)
+  {
+    bool response = pending_type == AccessType::STORE ? s.write_response : s.read_response;
+    if (response)
+    {
+      // Only RAM accesses would go through a cache, peripherals are never cached
+      if (pending_ram)
+      {
+        access(pending_address, pending_type);
+      }
+      pending = false;
+    }
+  }
+
+  if (!pending && (s.read_request || s.write_request))
+  {
+    pending = true;
+    pending_ram = s.device_sel & 0x1;
+    pending_address = s.address;
+    pending_type = s.write_request ? AccessType::STORE
+                   : load_request  ? AccessType::LOAD
+                                   : AccessType::FETCH;
+  }
+}
+
+void CacheMonitor::report(std::ostream &out) const
+{
+  char line[256];
+
+  std::snprintf(line, sizeof(line),
+                "Cache simulation: %llu fetches, %llu loads, %llu stores (RAM accesses)\n"
+                "External memory latency: %u cycles\n\n",
+                (unsigned long long)counts[0], (unsigned long long)counts[1],
+                (unsigned long long)counts[2], latency);
+  out << line;
+
+  std::snprintf(line, sizeof(line), "%-30s %12s %12s %9s %12s %14s\n", "Configuration",
+                "Accesses", "Misses", "Hit rate", "Write-backs", "Cycles saved");
+  out << line;
+
+  for (const Cache &cache : caches)
+  {
+    cache.report(out, latency);
+  }
+}
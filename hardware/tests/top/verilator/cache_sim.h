@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef CACHE_SIM_H
+#define CACHE_SIM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "bus_monitor.h"
+
+enum class AccessType
+{
+  FETCH,
+  LOAD,
+  STORE,
+};
+
+enum class CacheKind
+{
+  INSTRUCTION, // Fetches only
+  DATA,        // Loads and stores
+  UNIFIED,     // All accesses
+};
+
+enum class Replacement
+{
+  LRU,
+  FIFO,
+  RANDOM,
+};
+
+struct CacheConfig
+{
+  CacheKind kind{CacheKind::UNIFIED};
+  uint32_t size{4096};
+  uint32_t line_size{16};
+  uint32_t ways{1};
+  Replacement replacement{Replacement::LRU};
+
+  // Parses "<i|d|u>:<size>:<line size>:<ways>:<lru|fifo|random>", e.g. "i:4096:16:2:lru".
+  // Sizes accept K suffixes (e.g. "4K"). Returns false if the description is invalid.
+  bool parse(const std::string &description);
+  std::string name() const;
+};
+
+// Set-associative, write-back, write-allocate cache model
+class Cache
+{
+public:
+  explicit Cache(const CacheConfig &config);
+
+  void access(uint32_t address, AccessType type);
+  void report(std::ostream &out, uint32_t latency) const;
+
+private:
+  struct Line
+  {
+    bool valid{false};
+    bool dirty{false};
+    uint32_t tag{0};
+    uint64_t last_use{0};
+    uint64_t inserted{0};
+  };
+
+  CacheConfig config;
+  uint32_t sets;
+  std::vector<Line> lines;
+  uint64_t time{0};
+  uint32_t random_state{0x12345678};
+
+  uint64_t accesses{0};
+  uint64_t misses{0};
+  uint64_t writebacks{0};
+
+  bool accepts(AccessType type) const;
+  size_t victim(size_t first);
+};
+
+// Extracts the memory accesses of rvx_core from the bus handshakes and feeds them to a set of
+// cache models in a single pass. Optionally writes the access trace to a file.
+class CacheMonitor
+{
+public:
+  CacheMonitor(const std::vector<CacheConfig> &configs, uint32_t latency, const char *trace_path);
+
+  // load_request is the rvx_core signal that tells a load from an instruction fetch
+  void sample(const BusSample &s, bool load_request);
+  void report(std::ostream &out) const;
+
+private:
+  std::vector<Cache> caches;
+  uint32_t latency;
+  std::ofstream trace;
+
+  bool pending{false};
+  bool pending_ram{false};
+  uint32_t pending_address{0};
+  AccessType pending_type{AccessType::FETCH};
+
+  uint64_t counts[3]{0, 0, 0};
+
+  void access(uint32_t address, AccessType type);
+};
+
+#endif // CACHE_SIM_H
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "checkpoint.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+CheckpointStore::CheckpointStore(const char *directory, uint64_t interval, size_t max_count)
+    : directory(directory ? directory : ""), interval(interval),
+      max_count(max_count ? max_count : 1), next_cycle(0)
+{
+}
+
+CheckpointStore::~CheckpointStore()
+{
+  for (const Checkpoint &checkpoint : checkpoints)
+  {
+    std::remove(checkpoint.path.c_str());
+  }
+
+  if (remove_directory)
+  {
+    rmdir(directory.c_str());
+  }
+}
+
+bool CheckpointStore::open(std::string &error)
+{
+  if (directory.empty())
+  {
+    // A private directory on tmpfs keeps the snapshots in memory
+    struct stat info;
+    bool shm = stat("/dev/shm", &info) == 0 && S_ISDIR(info.st_mode);
+    std::string pattern = std::string(shm ? "/dev/shm" : "/tmp") + "/mcu_sim_checkpoints_XXXXXX";
+
+    if (!mkdtemp(&pattern[0]))
+    {
+      error = pattern + ": " + std::strerror(errno);
+      return false;
+    }
+    directory = pattern;
+    remove_directory = true;
+  }
+  else if (mkdir(directory.c_str(), 0755) < 0 && errno != EEXIST)
+  {
+    error = directory + ": " + std::strerror(errno);
+    return false;
+  }
+
+  return true;
+}
+
+const std::string &CheckpointStore::add(const HarnessState &state)
+{
+  if (checkpoints.size() >= max_count)
+  {
+    std::remove(checkpoints.front().path.c_str());
+    checkpoints.pop_front();
+  }
+
+  char name[64];
+  std::snprintf(name, sizeof(name), "/checkpoint_%06llu_%llu.bin", (unsigned long long)sequence++,
+                (unsigned long long)state.cycle);
+
+  checkpoints.push_back({state, directory + name});
+  next_cycle = state.cycle + interval;
+
+  return checkpoints.back().path;
+}
+
+const Checkpoint *CheckpointStore::at_time(uint64_t time) const
+{
+  for (auto it = checkpoints.rbegin(); it != checkpoints.rend(); ++it)
+  {
+    if (it->state.time <= time)
+    {
+      return &*it;
+    }
+  }
+  return nullptr;
+}
+
+const Checkpoint *CheckpointStore::at_cycle(uint64_t cycle) const
+{
+  for (auto it = checkpoints.rbegin(); it != checkpoints.rend(); ++it)
+  {
+    if (it->state.cycle <= cycle)
+    {
+      return &*it;
+    }
+  }
+  return nullptr;
+}
+
+void CheckpointStore::clear()
+{
+  for (const Checkpoint &checkpoint : checkpoints)
+  {
+    std::remove(checkpoint.path.c_str());
+  }
+  checkpoints.clear();
+  journal.clear();
+  next_entry = 0;
+  next_cycle = 0;
+}
+
+void CheckpointStore::restored(const HarnessState &state)
+{
+  next_cycle = checkpoints.empty() ? state.cycle : checkpoints.back().state.cycle + interval;
+
+  // Entries recorded at the time of the snapshot were made after it was taken
+  next_entry = 0;
+  while (next_entry < journal.size() && journal[next_entry].time < state.time)
+  {
+    next_entry++;
+  }
+}
+
+void CheckpointStore::record(const JournalEntry &entry)
+{
+  while (!checkpoints.empty() && checkpoints.back().state.time > entry.time)
+  {
+    std::remove(checkpoints.back().path.c_str());
+    checkpoints.pop_back();
+  }
+
+  while (!journal.empty() && journal.back().time > entry.time)
+  {
+    journal.pop_back();
+  }
+
+  journal.push_back(entry);
+  next_entry = journal.size();
+  next_cycle = checkpoints.empty() ? 0 : checkpoints.back().state.cycle + interval;
+}
+
+std::vector<JournalEntry> CheckpointStore::replay(uint64_t time)
+{
+  std::vector<JournalEntry> entries;
+
+  while (replay_due(time))
+  {
+    entries.push_back(journal[next_entry++]);
+  }
+  return entries;
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "stimulus.h"
+
+// State of the harness that is not part of the Verilated model
+struct HarnessState
+{
+  uint64_t cycle;
+  // Eval steps since the start of the simulation (trace_time), the time base of the journal
+  uint64_t time;
+  uint64_t clock_interval;
+  bool host_out_pending;
+  char host_out_data;
+  size_t stimulus_position;
+  StimulusPins stimulus_pins;
+};
+
+struct Checkpoint
+{
+  HarnessState state;
+  // File with the serialized model (VerilatedSave)
+  std::string path;
+};
+
+// Writes made to the model from outside (debugger, server) while the simulation is stopped. They
+// are replayed at the same time when the simulation goes back and runs over them again, so the
+// replay is deterministic.
+struct JournalEntry
+{
+  enum Kind
+  {
+    RAM,
+    REGISTER,
+  };
+
+  uint64_t time;
+  Kind kind;
+  uint32_t index;
+  uint32_t value;
+};
+
+// Periodic snapshots of the simulation, taken every interval cycles. Snapshot files are written to
+// a directory, by default on tmpfs (/dev/shm), and are removed when the store is destroyed. When
+// max_count is reached, the oldest snapshots are dropped.
+class CheckpointStore
+{
+public:
+  CheckpointStore(const char *directory, uint64_t interval, size_t max_count);
+  ~CheckpointStore();
+
+  bool open(std::string &error);
+
+  bool due(uint64_t cycle) const
+  {
+    return cycle >= next_cycle;
+  }
+
+  // Registers a snapshot and returns the path its model has to be saved to
+  const std::string &add(const HarnessState &state);
+
+  // Latest snapshot taken at or before the given time or cycle, nullptr if there is none
+  const Checkpoint *at_time(uint64_t time) const;
+  const Checkpoint *at_cycle(uint64_t cycle) const;
+  const Checkpoint *oldest() const
+  {
+    return checkpoints.empty() ? nullptr : &checkpoints.front();
+  }
+
+  // Drops all the snapshots and the journal (load and reset start a new history)
+  void clear();
+
+  // Called after a snapshot is restored: snapshots are taken again once the simulation passes the
+  // latest one, and the journal is replayed from the restored time
+  void restored(const HarnessState &state);
+
+  // Records an external write at the current time. The snapshots and journal entries after it
+  // belong to a timeline that no longer exists, so they are dropped.
+  void record(const JournalEntry &entry);
+
+  bool replay_due(uint64_t time) const
+  {
+    return next_entry < journal.size() && journal[next_entry].time <= time;
+  }
+
+  // Returns the entries due at the given time
+  std::vector<JournalEntry> replay(uint64_t time);
+
+  const std::string &path() const
+  {
+    return directory;
+  }
+
+private:
+  std::string directory;
+  bool remove_directory{false};
+  uint64_t interval;
+  size_t max_count;
+  uint64_t next_cycle;
+  uint64_t sequence{0};
+  std::deque<Checkpoint> checkpoints;
+  std::vector<JournalEntry> journal;
+  size_t next_entry{0};
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,347 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "fault_campaign.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <utility>
+
+static const char *target_names[] = {"ram", "reg", "csr"};
+static const char *outcome_names[] = {"masked", "sdc", "trap", "hang", "error"};
+static constexpr size_t NUM_OUTCOMES = 5;
+
+static bool parse_u64(const std::string &text, uint64_t &value)
+{
+  char *end;
+  value = std::strtoull(text.c_str(), &end, 0);
+  return !text.empty() && *end == '\0';
+}
+
+bool FaultRun::save(const std::string &path) const
+{
+  std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+
+  file << finished << " " << end_cycle << " " << exceptions << " " << signature.size() << " "
+       << console.size() << "\n";
+  for (uint32_t word : signature)
+  {
+    file << word << " ";
+  }
+  file << "\n" << console;
+
+  return file.good();
+}
+
+bool FaultRun::load(const std::string &path)
+{
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  size_t signature_size, console_size;
+
+  if (!(file >> finished >> end_cycle >> exceptions >> signature_size >> console_size))
+  {
+    return false;
+  }
+
+  signature.resize(signature_size);
+  for (uint32_t &word : signature)
+  {
+    file >> word;
+  }
+
+  // Skips the end of the signature line
+  file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  console.resize(console_size);
+  file.read(&console[0], console_size);
+
+  return (size_t)file.gcount() == console_size;
+}
+
+FaultCampaign::FaultCampaign(std::vector<FaultCsr> csrs) : csrs(std::move(csrs))
+{
+}
+
+bool FaultCampaign::set_targets(const char *text, std::string &error)
+{
+  std::stringstream list(text);
+  std::string name;
+
+  for (bool &target : targets)
+  {
+    target = false;
+  }
+
+  while (std::getline(list, name, ','))
+  {
+    bool found = false;
+    for (size_t i = 0; i < 3; i++)
+    {
+      if (name == target_names[i])
+      {
+        targets[i] = found = true;
+      }
+    }
+
+    if (!found)
+    {
+      error = "Unknown fault target: " + name + " (ram, reg or csr)";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool FaultCampaign::parse_target(const std::string &text, Fault &fault) const
+{
+  uint64_t value;
+
+  if (text.compare(0, 4, "ram:") == 0)
+  {
+    fault.target = FaultTarget::RAM;
+    if (!parse_u64(text.substr(4), value) || value > 0xffffffff)
+      return false;
+    fault.index = value & ~0x3u;
+    return true;
+  }
+
+  if (text.size() > 1 && text[0] == 'x')
+  {
+    fault.target = FaultTarget::REGISTER;
+    if (!parse_u64(text.substr(1), value) || value == 0 || value >= 32)
+      return false;
+    fault.index = value;
+    return true;
+  }
+
+  for (size_t i = 0; i < csrs.size(); i++)
+  {
+    if (text == csrs[i].name)
+    {
+      fault.target = FaultTarget::CSR;
+      fault.index = i;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool FaultCampaign::load(const char *path, std::string &error)
+{
+  std::ifstream file(path);
+  std::string line;
+  size_t line_number = 0;
+
+  if (!file.is_open())
+  {
+    error = std::string("Error file opening: ") + path;
+    return false;
+  }
+
+  while (std::getline(file, line))
+  {
+    line_number++;
+    line = line.substr(0, line.find('#'));
+
+    std::istringstream tokens(line);
+    std::string cycle, target, bit, extra;
+    if (!(tokens >> cycle))
+    {
+      continue;
+    }
+
+    Fault fault;
+    uint64_t bit_value;
+    std::string where = std::string(path) + ":" + std::to_string(line_number) + ": ";
+
+    if (!(tokens >> target >> bit) || (tokens >> extra))
+    {
+      error = where + "expected <cycle> <target> <bit>";
+      return false;
+    }
+    if (!parse_u64(cycle, fault.cycle))
+    {
+      error = where + "invalid cycle: " + cycle;
+      return false;
+    }
+    if (!parse_target(target, fault))
+    {
+      error = where + "invalid target: " + target;
+      return false;
+    }
+
+    uint32_t width = fault.target == FaultTarget::CSR ? csrs[fault.index].width : 32;
+    if (!parse_u64(bit, bit_value) || bit_value >= width)
+    {
+      error = where + "invalid bit: " + bit;
+      return false;
+    }
+    fault.bit = bit_value;
+
+    fault_list.push_back(fault);
+  }
+
+  outcomes.assign(fault_list.size(), FaultOutcome::ERROR);
+  return true;
+}
+
+void FaultCampaign::generate(size_t count, uint64_t seed, const FaultSpace &space)
+{
+  std::mt19937_64 random(seed);
+  std::vector<FaultTarget> kinds;
+  uint32_t csr_bits = 0;
+
+  for (const FaultCsr &csr : csrs)
+  {
+    csr_bits += csr.width;
+  }
+
+  if (targets[0] && space.ram_end > space.ram_start)
+    kinds.push_back(FaultTarget::RAM);
+  if (targets[1])
+    kinds.push_back(FaultTarget::REGISTER);
+  if (targets[2] && csr_bits)
+    kinds.push_back(FaultTarget::CSR);
+
+  uint64_t window = std::max<uint64_t>(space.last_cycle - space.first_cycle, 1);
+
+  for (size_t i = 0; i < count && !kinds.empty(); i++)
+  {
+    // Every kind of target gets the same share of the faults, so each has its own statistics
+    Fault fault;
+    fault.target = kinds[random() % kinds.size()];
+    fault.cycle = space.first_cycle + random() % window;
+    fault.bit = random() % 32;
+
+    switch (fault.target)
+    {
+    case FaultTarget::RAM:
+      fault.index = space.ram_start + 4 * (random() % ((space.ram_end - space.ram_start) / 4));
+      break;
+
+    case FaultTarget::REGISTER:
+      fault.index = 1 + random() % 31;
+      break;
+
+    case FaultTarget::CSR: {
+      uint32_t bit = random() % csr_bits;
+      for (fault.index = 0; bit >= csrs[fault.index].width; fault.index++)
+      {
+        bit -= csrs[fault.index].width;
+      }
+      fault.bit = bit;
+      break;
+    }
+    }
+
+    fault_list.push_back(fault);
+  }
+
+  outcomes.assign(fault_list.size(), FaultOutcome::ERROR);
+}
+
+FaultOutcome FaultCampaign::classify(const FaultRun &golden, const FaultRun &run)
+{
+  if (run.exceptions > golden.exceptions)
+  {
+    return FaultOutcome::TRAP;
+  }
+  if (!run.finished)
+  {
+    return FaultOutcome::HANG;
+  }
+  if (run.console != golden.console || run.signature != golden.signature)
+  {
+    return FaultOutcome::SDC;
+  }
+  return FaultOutcome::MASKED;
+}
+
+std::string FaultCampaign::describe(const Fault &fault) const
+{
+  char text[96];
+
+  switch (fault.target)
+  {
+  case FaultTarget::RAM:
+    std::snprintf(text, sizeof(text), "cycle %llu ram:0x%08x bit %u",
+                  (unsigned long long)fault.cycle, fault.index, fault.bit);
+    break;
+
+  case FaultTarget::REGISTER:
+    std::snprintf(text, sizeof(text), "cycle %llu x%u bit %u", (unsigned long long)fault.cycle,
+                  fault.index, fault.bit);
+    break;
+
+  case FaultTarget::CSR:
+    std::snprintf(text, sizeof(text), "cycle %llu %s bit %u", (unsigned long long)fault.cycle,
+                  csrs[fault.index].name, fault.bit);
+    break;
+  }
+  return text;
+}
+
+void FaultCampaign::report(std::ostream &out) const
+{
+  // Outcome counts per target, the last row is the total
+  size_t counts[4][NUM_OUTCOMES] = {};
+  char line[160];
+
+  for (size_t i = 0; i < fault_list.size(); i++)
+  {
+    counts[(int)fault_list[i].target][(int)outcomes[i]]++;
+    counts[3][(int)outcomes[i]]++;
+  }
+
+  out << "Fault injection campaign: " << fault_list.size() << " faults\n\n";
+  std::snprintf(line, sizeof(line), "%-8s %8s %8s %8s %8s %8s %8s   %s\n", "Target", "Faults",
+                "Masked", "SDC", "Trap", "Hang", "Error", "Sensitivity (95% interval)");
+  out << line;
+
+  for (size_t t = 0; t < 4; t++)
+  {
+    size_t total = 0;
+    for (size_t o = 0; o < NUM_OUTCOMES; o++)
+    {
+      total += counts[t][o];
+    }
+    if (!total)
+    {
+      continue;
+    }
+
+    // Share of the faults that were not masked, with the Wilson score interval. Runs that failed
+    // to complete (error) are left out.
+    double n = total - counts[t][(int)FaultOutcome::ERROR];
+    double p = n ? (n - counts[t][(int)FaultOutcome::MASKED]) / n : 0;
+    double z = 1.96;
+    double center = n ? (p + z * z / (2 * n)) / (1 + z * z / n) : 0;
+    double margin =
+        n ? z * std::sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n) : 0;
+
+    std::snprintf(line, sizeof(line),
+                  "%-8s %8zu %8zu %8zu %8zu %8zu %8zu   %5.1f%% [%.1f%%, %.1f%%]\n",
+                  t < 3 ? target_names[t] : "total", total, counts[t][0], counts[t][1],
+                  counts[t][2], counts[t][3], counts[t][4], 100 * p,
+                  100 * std::max(0.0, center - margin), 100 * std::min(1.0, center + margin));
+    out << line;
+  }
+
+  out << "\nFaults that were not masked:\n";
+  for (size_t i = 0; i < fault_list.size(); i++)
+  {
+    if (outcomes[i] != FaultOutcome::MASKED)
+    {
+      std::snprintf(line, sizeof(line), "  %-8s %s\n", outcome_names[(int)outcomes[i]],
+                    describe(fault_list[i]).c_str());
+      out << line;
+    }
+  }
+}
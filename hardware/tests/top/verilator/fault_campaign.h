@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef FAULT_CAMPAIGN_H
+#define FAULT_CAMPAIGN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class FaultTarget
+{
+  RAM,
+  REGISTER,
+  CSR,
+};
+
+// Single bit flip. index is the byte address of the word for RAM, the register number (x1-x31)
+// for REGISTER and the position in the CSR table for CSR.
+struct Fault
+{
+  uint64_t cycle;
+  FaultTarget target;
+  uint32_t index;
+  uint32_t bit;
+};
+
+// CSR, or CSR field, that can be hit
+struct FaultCsr
+{
+  const char *name;
+  uint32_t width;
+};
+
+enum class FaultOutcome
+{
+  MASKED,
+  SDC,
+  TRAP,
+  HANG,
+  ERROR,
+};
+
+// What the firmware did after the fork point, compared between the golden run and the injections
+struct FaultRun
+{
+  bool finished{false};
+  uint64_t end_cycle{0};
+  uint64_t exceptions{0};
+  std::string console;
+  std::vector<uint32_t> signature;
+
+  // The golden run is made in a child process, it is passed to the parent in a file
+  bool save(const std::string &path) const;
+  bool load(const std::string &path);
+};
+
+// Faults are drawn from this space: a random cycle in [first_cycle, last_cycle), a random target
+// among the enabled ones, and a random bit of it
+struct FaultSpace
+{
+  uint64_t first_cycle;
+  uint64_t last_cycle;
+  uint32_t ram_start;
+  uint32_t ram_end;
+};
+
+// Soft-error injection campaign. The faults are either scheduled in a file or drawn at random, each
+// of them is run from the same warm state and its outcome is classified against a golden run:
+//   masked  the program finished with the same console output (and signature)
+//   sdc     the program finished, but its output differs (silent data corruption)
+//   trap    the core took more exceptions than in the golden run
+//   hang    the program did not finish within the time limit
+//
+// Scheduled faults, one per line:
+//   # <cycle> <target> <bit>
+//   120000    ram:0x2000   5
+//   120000    x10          31
+//   150000    mepc         2
+class FaultCampaign
+{
+public:
+  explicit FaultCampaign(std::vector<FaultCsr> csrs);
+
+  // Comma separated list of ram, reg and csr
+  bool set_targets(const char *text, std::string &error);
+
+  // Returns false and sets error (with the line number) if the file is invalid
+  bool load(const char *path, std::string &error);
+
+  void generate(size_t count, uint64_t seed, const FaultSpace &space);
+
+  const std::vector<Fault> &faults() const
+  {
+    return fault_list;
+  }
+
+  static FaultOutcome classify(const FaultRun &golden, const FaultRun &run);
+
+  void set_outcome(size_t index, FaultOutcome outcome)
+  {
+    outcomes[index] = outcome;
+  }
+
+  std::string describe(const Fault &fault) const;
+
+  void report(std::ostream &out) const;
+
+private:
+  std::vector<FaultCsr> csrs;
+  bool targets[3]{true, true, true};
+  std::vector<Fault> fault_list;
+  std::vector<FaultOutcome> outcomes;
+
+  bool parse_target(const std::string &text, Fault &fault) const;
+};
+
+#endif // FAULT_CAMPAIGN_H
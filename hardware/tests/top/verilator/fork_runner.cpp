@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "fork_runner.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <dirent.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "log.h"
+
+static const char *report_separator =
+    "================================================================================\n";
+
+unsigned online_cores()
+{
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  return cores > 0 ? cores : 1;
+}
+
+void fork_parallel(size_t count, unsigned jobs, const std::function<int(size_t index)> &body,
+                   const ForkDone &done)
+{
+  struct Child
+  {
+    pid_t pid;
+    size_t index;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  std::vector<Child> children;
+
+  auto wait_child = [&]() {
+    int status;
+    pid_t pid;
+
+    do
+    {
+      pid = waitpid(-1, &status, 0);
+    } while (pid < 0 && errno == EINTR);
+
+    for (auto it = children.begin(); it != children.end(); ++it)
+    {
+      if (it->pid == pid)
+      {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - it->start;
+        bool signaled = WIFSIGNALED(status);
+        size_t index = it->index;
+        children.erase(it);
+        done(index, signaled ? 128 + WTERMSIG(status) : WEXITSTATUS(status), signaled,
+             elapsed.count());
+        return;
+      }
+    }
+  };
+
+  for (size_t i = 0; i < count; i++)
+  {
+    while (children.size() >= std::max(jobs, 1u))
+    {
+      wait_child();
+    }
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      Log::error("fork: %s", std::strerror(errno));
+      done(i, -1, false, 0);
+      continue;
+    }
+
+    if (pid == 0)
+    {
+      // The child ends here, its reports are written by the exit handlers of the simulator
+      std::exit(body(i));
+    }
+
+    children.push_back({pid, i, std::chrono::steady_clock::now()});
+  }
+
+  while (!children.empty())
+  {
+    wait_child();
+  }
+}
+
+ForkRunner::ForkRunner(unsigned jobs) : jobs(jobs ? jobs : online_cores())
+{
+}
+
+ForkRunner::~ForkRunner()
+{
+  if (directory.empty())
+  {
+    return;
+  }
+
+  // The directory is private, everything in it was written by the children
+  if (DIR *dir = opendir(directory.c_str()))
+  {
+    while (dirent *entry = readdir(dir))
+    {
+      if (std::strcmp(entry->d_name, ".") && std::strcmp(entry->d_name, ".."))
+      {
+        std::remove((directory + "/" + entry->d_name).c_str());
+      }
+    }
+    closedir(dir);
+  }
+  rmdir(directory.c_str());
+}
+
+bool ForkRunner::load(const char *path, std::string &error)
+{
+  std::ifstream file(path);
+  std::string line;
+  size_t line_number = 0;
+
+  if (!file.is_open())
+  {
+    error = std::string("Error file opening: ") + path;
+    return false;
+  }
+
+  while (std::getline(file, line))
+  {
+    line_number++;
+    line = line.substr(0, line.find('#'));
+
+    std::istringstream tokens(line);
+    std::string token;
+    Variant variant;
+
+    if (!(tokens >> variant.name))
+    {
+      continue;
+    }
+
+    std::string where = std::string(path) + ":" + std::to_string(line_number) + ": ";
+
+    // The name is part of the file names in the private directory
+    if (variant.name.find('/') != std::string::npos)
+    {
+      error = where + "invalid variant name: " + variant.name;
+      return false;
+    }
+
+    for (const Variant &other : variants)
+    {
+      if (other.name == variant.name)
+      {
+        error = where + "duplicate variant: " + variant.name;
+        return false;
+      }
+    }
+
+    while (tokens >> token)
+    {
+      if (token.compare(0, 9, "stimulus=") == 0 && token.size() > 9)
+      {
+        variant.stimulus_path = token.substr(9);
+      }
+      else if (token.compare(0, 7, "cycles=") == 0)
+      {
+        char *end;
+        variant.cycles = std::strtoull(token.c_str() + 7, &end, 0);
+        if (*end || !variant.cycles)
+        {
+          error = where + "invalid cycles: " + token;
+          return false;
+        }
+      }
+      else
+      {
+        error = where + "unknown option: " + token;
+        return false;
+      }
+    }
+
+    variants.push_back(variant);
+  }
+
+  if (variants.empty())
+  {
+    error = std::string(path) + ": no variants";
+    return false;
+  }
+
+  return true;
+}
+
+bool ForkRunner::open(std::string &error)
+{
+  char pattern[] = "/tmp/mcu_sim_variants_XXXXXX";
+
+  if (!mkdtemp(pattern))
+  {
+    error = std::string(pattern) + ": " + std::strerror(errno);
+    return false;
+  }
+  directory = pattern;
+
+  return true;
+}
+
+std::string ForkRunner::file(const Variant &variant, const char *suffix) const
+{
+  return directory + "/" + variant.name + "." + suffix;
+}
+
+void ForkRunner::run(const std::function<int(const Variant &)> &body)
+{
+  fork_parallel(
+      variants.size(), jobs, [&](size_t index) { return body(variants[index]); },
+      [this](size_t index, int status, bool signaled, double seconds) {
+        Variant &variant = variants[index];
+        variant.status = status;
+        variant.seconds = seconds;
+
+        std::ifstream result(file(variant, "result"));
+        if (!(result >> variant.reason >> variant.end_cycle))
+        {
+          variant.reason = signaled ? strsignal(status - 128) : "no result";
+        }
+
+        Log::info("Variant %s: %s at cycle %llu (%.2f s)", variant.name.c_str(),
+                  variant.reason.c_str(), (unsigned long long)variant.end_cycle, seconds);
+      });
+}
+
+void ForkRunner::report(std::ostream &out, const std::vector<VariantReport> &reports) const
+{
+  size_t width = 8;
+  for (const Variant &variant : variants)
+  {
+    width = std::max(width, variant.name.size() + 2);
+  }
+
+  out << std::left << std::setw(width) << "Variant" << std::setw(8) << "Status" << std::setw(14)
+      << "Stop" << std::setw(14) << "Cycle" << "Seconds\n";
+
+  for (const Variant &variant : variants)
+  {
+    char seconds[32];
+    std::snprintf(seconds, sizeof(seconds), "%.2f", variant.seconds);
+    out << std::setw(width) << variant.name << std::setw(8) << variant.status << std::setw(14)
+        << variant.reason << std::setw(14) << variant.end_cycle << seconds << "\n";
+  }
+
+  for (const Variant &variant : variants)
+  {
+    for (const VariantReport &report : reports)
+    {
+      std::ifstream file(this->file(variant, report.suffix));
+      if (!file.is_open() || file.peek() == std::ifstream::traits_type::eof())
+      {
+        continue;
+      }
+
+      out << "\n" << report_separator << variant.name << ": " << report.title << "\n"
+          << report_separator;
+      out << file.rdbuf();
+    }
+  }
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef FORK_RUNNER_H
+#define FORK_RUNNER_H
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Number of cores available to the children
+unsigned online_cores();
+
+using ForkDone = std::function<void(size_t index, int status, bool signaled, double seconds)>;
+
+// Runs body(index) in a child process for each index, at most jobs at a time, and calls done in the
+// parent when a child exits. status is the exit status of the child, or 128 + the signal number
+// when signaled is set. The children inherit the whole simulation copy-on-write.
+void fork_parallel(size_t count, unsigned jobs, const std::function<int(size_t index)> &body,
+                   const ForkDone &done);
+
+// Scenario run from the fork point
+//
+//   # <name> [stimulus=<script>] [cycles=<cycles after the fork>]
+//   idle
+//   uart_storm   stimulus=uart_storm.txt
+//   buttons      stimulus=buttons.txt cycles=2000000
+struct Variant
+{
+  std::string name;
+  // Replaces the --stimulus script, its times are counted from the fork point
+  std::string stimulus_path;
+  // 0 = until --cycles
+  uint64_t cycles{0};
+
+  // Filled in by the parent when the child exits
+  int status{-1};
+  std::string reason;
+  uint64_t end_cycle{0};
+  double seconds{0};
+};
+
+// Report files written by every child, merged in this order
+struct VariantReport
+{
+  const char *title;
+  const char *suffix;
+};
+
+// Runs each variant in a child process forked from the current state of the simulation, so all of
+// them share the simulated prefix copy-on-write. At most jobs children run at the same time. The
+// children write their files to a private directory, which is removed once the reports are merged.
+class ForkRunner
+{
+public:
+  explicit ForkRunner(unsigned jobs);
+  ~ForkRunner();
+
+  // Returns false and sets error (with the line number) if the file is invalid
+  bool load(const char *path, std::string &error);
+
+  bool open(std::string &error);
+
+  // File of a variant in the private directory
+  std::string file(const Variant &variant, const char *suffix) const;
+
+  // The body runs in the child and returns its exit status. It has to write the "result" file:
+  // "<stop reason> <cycle>".
+  void run(const std::function<int(const Variant &)> &body);
+
+  void report(std::ostream &out, const std::vector<VariantReport> &reports) const;
+
+  size_t size() const
+  {
+    return variants.size();
+  }
+
+  unsigned job_count() const
+  {
+    return jobs;
+  }
+
+private:
+  unsigned jobs;
+  std::string directory;
+  std::vector<Variant> variants;
+};
+
+#endif // FORK_RUNNER_H
@@ -0,0 +1,545 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "gdb_stub.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "log.h"
+
+// Registers of the 'g' packet: x0 to x31 and pc
+static constexpr uint32_t NUM_REGISTERS = 33;
+
+static const char hex_digits[] = "0123456789abcdef";
+
+static std::string hex_u32_le(uint32_t value)
+{
+  std::string text;
+  for (int i = 0; i < 4; i++)
+  {
+    uint8_t byte = value >> (8 * i);
+    text += hex_digits[byte >> 4];
+    text += hex_digits[byte & 0xf];
+  }
+  return text;
+}
+
+static int hex_value(char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+static bool parse_hex_bytes(const std::string &text, std::vector<uint8_t> &bytes)
+{
+  if (text.size() % 2)
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < text.size(); i += 2)
+  {
+    int high = hex_value(text[i]);
+    int low = hex_value(text[i + 1]);
+    if (high < 0 || low < 0)
+    {
+      return false;
+    }
+    bytes.push_back((high << 4) | low);
+  }
+  return true;
+}
+
+static uint32_t parse_hex(const std::string &text, size_t &pos)
+{
+  uint32_t value = 0;
+  int digit;
+
+  while (pos < text.size() && (digit = hex_value(text[pos])) >= 0)
+  {
+    value = (value << 4) | digit;
+    pos++;
+  }
+  return value;
+}
+
+GdbStub::GdbStub(uint16_t port, uint32_t wr_addr, SimControl control)
+    : port(port), wr_addr(wr_addr), control(std::move(control))
+{
+}
+
+GdbStub::~GdbStub()
+{
+  if (fd >= 0)
+  {
+    close(fd);
+  }
+  if (listen_fd >= 0)
+  {
+    close(listen_fd);
+  }
+}
+
+bool GdbStub::open(std::string &error)
+{
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd < 0)
+  {
+    error = std::string("socket: ") + std::strerror(errno);
+    return false;
+  }
+
+  int enable = 1;
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  // A debugger that disconnects must not terminate the simulator
+  signal(SIGPIPE, SIG_IGN);
+
+  if (bind(listen_fd, (sockaddr *)&address, sizeof(address)) < 0 || listen(listen_fd, 1) < 0)
+  {
+    error = "port " + std::to_string(port) + ": " + std::strerror(errno);
+    close(listen_fd);
+    listen_fd = -1;
+    return false;
+  }
+
+  return true;
+}
+
+bool GdbStub::read_byte(uint8_t &c)
+{
+  ssize_t n;
+
+  do
+  {
+    n = recv(fd, &c, 1, 0);
+  } while (n < 0 && errno == EINTR);
+
+  return n == 1;
+}
+
+bool GdbStub::read_packet(std::string &packet)
+{
+  uint8_t c;
+
+  while (true)
+  {
+    // Skip acknowledges and interrupts received while the target is stopped
+    do
+    {
+      if (!read_byte(c))
+        return false;
+    } while (c != '$');
+
+    packet.clear();
+    uint8_t checksum = 0;
+    while (true)
+    {
+      if (!read_byte(c))
+        return false;
+      if (c == '#')
+        break;
+      packet += (char)c;
+      checksum += c;
+    }
+
+    uint8_t high, low;
+    if (!read_byte(high) || !read_byte(low))
+    {
+      return false;
+    }
+
+    bool valid = ((hex_value(high) << 4) | hex_value(low)) == checksum;
+    send(fd, valid ? "+" : "-", 1, 0);
+    if (valid)
+    {
+      return true;
+    }
+  }
+}
+
+void GdbStub::send_packet(const std::string &packet)
+{
+  uint8_t checksum = 0;
+  for (char c : packet)
+  {
+    checksum += (uint8_t)c;
+  }
+
+  std::string frame = "$" + packet + "#" + hex_digits[checksum >> 4] + hex_digits[checksum & 0xf];
+  send(fd, frame.data(), frame.size(), 0);
+
+  // Retransmit until the debugger acknowledges the packet
+  uint8_t c;
+  while (read_byte(c) && c != '+')
+  {
+    if (c == '-')
+    {
+      send(fd, frame.data(), frame.size(), 0);
+    }
+  }
+}
+
+bool GdbStub::interrupt_pending()
+{
+  uint8_t c;
+
+  while (recv(fd, &c, 1, MSG_DONTWAIT) == 1)
+  {
+    if (c == 0x03)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void GdbStub::serve()
+{
+  // The first stop is before the boot instruction retires, so a breakpoint on it is not missed
+  RunCondition condition;
+  condition.step = true;
+  control.run(condition, [](char c) { Log::host_out(c); });
+
+  do
+  {
+    fd = accept(listen_fd, nullptr, nullptr);
+  } while (fd < 0 && errno == EINTR);
+
+  if (fd < 0)
+  {
+    return;
+  }
+
+  int enable = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+  std::string packet;
+  bool close_connection = false;
+
+  while (!close_connection && read_packet(packet))
+  {
+    std::string response = handle(packet, close_connection);
+    // A kill request has no reply
+    if (packet[0] != 'k')
+    {
+      send_packet(response);
+    }
+  }
+
+  close(fd);
+  fd = -1;
+}
+
+std::string GdbStub::handle(const std::string &packet, bool &close_connection)
+{
+  size_t pos = 1;
+
+  switch (packet[0])
+  {
+  case '?':
+    return "S05";
+
+  case 'g':
+    return read_registers();
+
+  case 'G':
+    return write_registers(packet.substr(1));
+
+  case 'p': {
+    uint32_t index = parse_hex(packet, pos);
+    uint32_t value;
+    if (!control.read_register(index, value))
+    {
+      // CSRs and other registers the model does not expose
+      return "xxxxxxxx";
+    }
+    return hex_u32_le(value);
+  }
+
+  case 'P': {
+    uint32_t index = parse_hex(packet, pos);
+    std::vector<uint8_t> bytes;
+    if (pos >= packet.size() || packet[pos] != '=' ||
+        !parse_hex_bytes(packet.substr(pos + 1), bytes) || bytes.size() != 4)
+    {
+      return "E01";
+    }
+    uint32_t value = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+    return control.write_register(index, value) ? "OK" : "E01";
+  }
+
+  case 'm': {
+    uint32_t address = parse_hex(packet, pos);
+    pos++;
+    uint32_t length = parse_hex(packet, pos);
+    return read_memory(address, length);
+  }
+
+  case 'M': {
+    uint32_t address = parse_hex(packet, pos);
+    pos++;
+    uint32_t length = parse_hex(packet, pos);
+    if (pos >= packet.size() || packet[pos] != ':')
+    {
+      return "E01";
+    }
+    return write_memory(address, length, packet.substr(pos + 1));
+  }
+
+  case 'c':
+  case 's':
+    // Resuming at another address is not supported, pc is read only
+    if (packet.size() > 1)
+    {
+      return "E01";
+    }
+    return resume(packet[0] == 's');
+
+  case 'b':
+    if (packet != "bs" && packet != "bc")
+    {
+      return "";
+    }
+    return reverse(packet[1] == 's');
+
+  case 'Z':
+  case 'z':
+    return breakpoint(packet, packet[0] == 'Z');
+
+  case 'H':
+    return "OK";
+
+  case 'D':
+    close_connection = true;
+    return "OK";
+
+  case 'k':
+    close_connection = true;
+    return "";
+
+  case 'q':
+    if (packet.compare(0, 10, "qSupported") == 0)
+      return control.reverse ? "PacketSize=4000;ReverseStep+;ReverseContinue+"
+                             : "PacketSize=4000";
+    if (packet == "qAttached")
+      return "1";
+    if (packet == "qC")
+      return "QC1";
+    if (packet == "qfThreadInfo")
+      return "m1";
+    if (packet == "qsThreadInfo")
+      return "l";
+    return "";
+
+  case 'v':
+    if (packet == "vCont?")
+      return "vCont;c;s";
+    if (packet.compare(0, 6, "vCont;") == 0 && packet.size() > 6 &&
+        (packet[6] == 'c' || packet[6] == 's'))
+      return resume(packet[6] == 's');
+    if (packet.compare(0, 5, "vKill") == 0)
+    {
+      close_connection = true;
+      return "OK";
+    }
+    return "";
+
+  default:
+    return "";
+  }
+}
+
+std::string GdbStub::resume(bool step)
+{
+  RunCondition condition;
+  condition.wr_addr = wr_addr;
+  condition.step = step;
+  condition.breakpoints = &breakpoints;
+  condition.watchpoints = &watchpoints;
+  condition.interrupted = [this]() { return interrupt_pending(); };
+
+  return stop_reply(control.run(condition, [](char c) { Log::host_out(c); }));
+}
+
+std::string GdbStub::reverse(bool step)
+{
+  if (!control.reverse)
+  {
+    // Reverse execution needs --checkpoint-interval
+    return "";
+  }
+
+  RunCondition condition;
+  condition.step = step;
+  condition.breakpoints = &breakpoints;
+  condition.watchpoints = &watchpoints;
+
+  RunResult result;
+  if (!control.reverse(condition, result))
+  {
+    return "T05replaylog:begin;";
+  }
+  return stop_reply(result);
+}
+
+std::string GdbStub::stop_reply(const RunResult &result)
+{
+  switch (result.reason)
+  {
+  case StopReason::WR_ADDR:
+    // The program has finished
+    return "W00";
+
+  case StopReason::WATCHPOINT: {
+    char reply[32];
+    std::snprintf(reply, sizeof(reply), "T05watch:%x;", result.address);
+    return reply;
+  }
+
+  case StopReason::INTERRUPTED:
+    return "S02";
+
+  default:
+    return "S05";
+  }
+}
+
+std::string GdbStub::read_registers()
+{
+  std::string text;
+  uint32_t value;
+
+  for (uint32_t i = 0; i < NUM_REGISTERS; i++)
+  {
+    text += control.read_register(i, value) ? hex_u32_le(value) : "xxxxxxxx";
+  }
+  return text;
+}
+
+std::string GdbStub::write_registers(const std::string &data)
+{
+  std::vector<uint8_t> bytes;
+
+  if (!parse_hex_bytes(data, bytes) || bytes.size() < NUM_REGISTERS * 4)
+  {
+    return "E01";
+  }
+
+  // x0 and pc are not writable, they are skipped
+  for (uint32_t i = 1; i < 32; i++)
+  {
+    const uint8_t *b = &bytes[i * 4];
+    control.write_register(i, b[0] | b[1] << 8 | b[2] << 16 | (uint32_t)b[3] << 24);
+  }
+  return "OK";
+}
+
+std::string GdbStub::read_memory(uint32_t address, uint32_t length)
+{
+  std::string text;
+  uint32_t word;
+
+  for (uint32_t i = 0; i < length; i++)
+  {
+    uint32_t byte_address = address + i;
+    if (!control.peek(byte_address & ~0x3u, word))
+    {
+      // A partial read is allowed by the protocol
+      return text.empty() ? "E01" : text;
+    }
+    uint8_t byte = word >> (8 * (byte_address & 0x3));
+    text += hex_digits[byte >> 4];
+    text += hex_digits[byte & 0xf];
+  }
+  return text;
+}
+
+std::string GdbStub::write_memory(uint32_t address, uint32_t length, const std::string &data)
+{
+  std::vector<uint8_t> bytes;
+  uint32_t word;
+
+  if (!parse_hex_bytes(data, bytes) || bytes.size() != length)
+  {
+    return "E01";
+  }
+
+  for (uint32_t i = 0; i < length; i++)
+  {
+    uint32_t byte_address = address + i;
+    uint32_t shift = 8 * (byte_address & 0x3);
+    if (!control.peek(byte_address & ~0x3u, word))
+    {
+      return "E01";
+    }
+    word = (word & ~(0xffu << shift)) | ((uint32_t)bytes[i] << shift);
+    control.poke(byte_address & ~0x3u, word);
+  }
+  return "OK";
+}
+
+std::string GdbStub::breakpoint(const std::string &packet, bool insert)
+{
+  // Z<type>,<address>,<kind>
+  size_t pos = 1;
+  uint32_t type = parse_hex(packet, pos);
+  pos++;
+  uint32_t address = parse_hex(packet, pos);
+  pos++;
+  uint32_t length = parse_hex(packet, pos);
+
+  switch (type)
+  {
+  case 0: // Software breakpoint
+  case 1: // Hardware breakpoint
+    if (insert)
+      breakpoints.insert(address);
+    else
+      breakpoints.erase(address);
+    return "OK";
+
+  case 2: // Write watchpoint
+    if (insert)
+    {
+      watchpoints.push_back({address, std::max(length, 1u)});
+    }
+    else
+    {
+      auto it = std::find_if(watchpoints.begin(), watchpoints.end(), [&](const Watchpoint &w) {
+        return w.address == address && w.length == std::max(length, 1u);
+      });
+      if (it != watchpoints.end())
+      {
+        watchpoints.erase(it);
+      }
+    }
+    return "OK";
+
+  default:
+    // Read and access watchpoints are not supported
+    return "";
+  }
+}
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef GDB_STUB_H
+#define GDB_STUB_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "sim_control.h"
+
+// GDB remote serial protocol server on localhost. It supports register and memory access, software
+// and hardware breakpoints (Z0/Z1, kept in a hash set that is only looked up when an instruction
+// retires), write watchpoints (Z2) on bus writes, single-step, continue and interrupt (Ctrl-C).
+//
+// The target is stopped between two instructions: the instruction at pc has not retired yet.
+// Connect with:
+//   riscv64-unknown-elf-gdb -ex "set architecture riscv:rv32" -ex "target remote :<port>" <elf>
+class GdbStub
+{
+public:
+  GdbStub(uint16_t port, uint32_t wr_addr, SimControl control);
+  ~GdbStub();
+
+  bool open(std::string &error);
+
+  // Serves a single debugger connection, returns when it detaches or kills the target
+  void serve();
+
+private:
+  uint16_t port;
+  uint32_t wr_addr;
+  SimControl control;
+  int listen_fd{-1};
+  int fd{-1};
+  std::unordered_set<uint32_t> breakpoints;
+  std::vector<Watchpoint> watchpoints;
+
+  bool read_byte(uint8_t &c);
+  bool read_packet(std::string &packet);
+  void send_packet(const std::string &packet);
+  bool interrupt_pending();
+
+  std::string handle(const std::string &packet, bool &close);
+  std::string resume(bool step);
+  std::string reverse(bool step);
+  std::string stop_reply(const RunResult &result);
+  std::string read_registers();
+  std::string write_registers(const std::string &data);
+  std::string read_memory(uint32_t address, uint32_t length);
+  std::string write_memory(uint32_t address, uint32_t length, const std::string &data);
+  std::string breakpoint(const std::string &packet, bool insert);
+};
+
+#endif // GDB_STUB_H
@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "irq_monitor.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+static constexpr size_t CODE_SOFTWARE = 3;
+static constexpr size_t CODE_TIMER = 7;
+static constexpr size_t CODE_EXTERNAL = 11;
+static constexpr size_t CODE_FAST = 16;
+
+const char *IrqMonitor::source_name(size_t code)
+{
+  static const char *fast_names[] = {
+      "fast0 (uart)", "fast1",  "fast2",  "fast3",  "fast4",  "fast5",  "fast6",  "fast7",
+      "fast8",        "fast9",  "fast10", "fast11", "fast12", "fast13", "fast14", "fast15",
+  };
+
+  switch (code)
+  {
+  case CODE_SOFTWARE:
+    return "software";
+  case CODE_TIMER:
+    return "timer";
+  case CODE_EXTERNAL:
+    return "external";
+  default:
+    return code >= CODE_FAST ? fast_names[code - CODE_FAST] : "unknown";
+  }
+}
+
+void IrqMonitor::update_source(size_t code, bool level)
+{
+  Source &source = sources[code];
+
+  // The latency is measured from the rising edge of the request. A request that is still high
+  // after its handler returns is not a new one.
+  if (level && !source.level && !source.raised)
+  {
+    source.raised = true;
+    source.raise_cycle = cycles;
+  }
+
+  source.level = level;
+}
+
+void IrqMonitor::sample(const IrqSample &s)
+{
+  for (size_t i = 0; i < 16; i++)
+  {
+    update_source(CODE_FAST + i, (s.irq_fast >> i) & 0x1);
+  }
+  update_source(CODE_SOFTWARE, s.irq_software);
+  update_source(CODE_TIMER, s.irq_timer);
+  update_source(CODE_EXTERNAL, s.irq_external);
+
+  // The FSM stays a single cycle in each trap state, but it may be frozen by a bus wait
+  bool state_entered = s.current_state != prev_state;
+  prev_state = s.current_state;
+
+  if (s.current_state == STATE_TRAP_TAKEN && state_entered)
+  {
+    size_t code = s.mcause_code % NUM_SOURCES;
+    handlers.push_back({s.mcause_interrupt, code, cycles});
+
+    if (s.mcause_interrupt)
+    {
+      Source &source = sources[code];
+      source.traps++;
+      if (source.raised)
+      {
+        // The first handler instruction is fetched in the next cycle
+        source.latencies.push_back(cycles + 1 - source.raise_cycle);
+        source.raised = false;
+      }
+    }
+  }
+
+  if (s.current_state == STATE_TRAP_RETURN && state_entered && !handlers.empty())
+  {
+    Handler handler = handlers.back();
+    handlers.pop_back();
+
+    if (handler.interrupt)
+    {
+      sources[handler.source].isr_cycles.push_back(cycles - handler.entry_cycle);
+    }
+  }
+
+  // Cycles inside interrupt handlers, including the exceptions they cause
+  for (const Handler &handler : handlers)
+  {
+    if (handler.interrupt)
+    {
+      isr_cycles++;
+      break;
+    }
+  }
+
+  cycles++;
+}
+
+static uint64_t percentile(std::vector<uint64_t> values, double p)
+{
+  std::sort(values.begin(), values.end());
+  size_t index = (size_t)(p * (values.size() - 1) + 0.5);
+  return values[index];
+}
+
+static void summary(std::ostream &out, const char *name, const char *what,
+                    const std::vector<uint64_t> &values)
+{
+  char line[256];
+
+  if (values.empty())
+  {
+    std::snprintf(line, sizeof(line), "%-14s %-12s %10s\n", name, what, "-");
+    out << line;
+    return;
+  }
+
+  uint64_t total = 0;
+  for (uint64_t v : values)
+  {
+    total += v;
+  }
+
+  std::snprintf(line, sizeof(line), "%-14s %-12s %10zu %10llu %10.1f %10llu %10llu\n", name, what,
+                values.size(), (unsigned long long)*std::min_element(values.begin(), values.end()),
+                (double)total / values.size(), (unsigned long long)percentile(values, 0.99),
+                (unsigned long long)*std::max_element(values.begin(), values.end()));
+  out << line;
+}
+
+void IrqMonitor::report(std::ostream &out) const
+{
+  char line[256];
+
+  std::snprintf(line, sizeof(line),
+                "Interrupt profile: %llu cycles, %llu in interrupt handlers (%.2f%%)\n\n",
+                (unsigned long long)cycles, (unsigned long long)isr_cycles,
+                cycles ? 100.0 * isr_cycles / cycles : 0.0);
+  out << line;
+
+  out << "Latency: cycles from the assertion of the request to the fetch of the first handler\n"
+         "instruction. Handler: cycles from the trap entry to the mret.\n\n";
+
+  std::snprintf(line, sizeof(line), "%-14s %-12s %10s %10s %10s %10s %10s\n", "Source", "Cycles",
+                "Count", "Min", "Mean", "P99", "Max");
+  out << line;
+
+  for (size_t code = 0; code < NUM_SOURCES; code++)
+  {
+    const Source &source = sources[code];
+    if (!source.traps)
+    {
+      continue;
+    }
+    summary(out, source_name(code), "latency", source.latencies);
+    summary(out, source_name(code), "handler", source.isr_cycles);
+  }
+
+  for (size_t code = 0; code < NUM_SOURCES; code++)
+  {
+    const Source &source = sources[code];
+    if (source.latencies.empty())
+    {
+      continue;
+    }
+
+    std::map<uint64_t, uint64_t> histogram;
+    for (uint64_t latency : source.latencies)
+    {
+      histogram[latency]++;
+    }
+
+    std::snprintf(line, sizeof(line), "\nLatency histogram: %s\n", source_name(code));
+    out << line;
+    for (const auto &entry : histogram)
+    {
+      std::snprintf(line, sizeof(line), "%10llu cycles %10llu\n", (unsigned long long)entry.first,
+                    (unsigned long long)entry.second);
+      out << line;
+    }
+  }
+}
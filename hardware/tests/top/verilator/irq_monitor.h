@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef IRQ_MONITOR_H
+#define IRQ_MONITOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// States of the M-mode FSM of rvx_core
+enum CoreState
+{
+  STATE_RESET = 0x1,
+  STATE_OPERATING = 0x2,
+  STATE_TRAP_TAKEN = 0x4,
+  STATE_TRAP_RETURN = 0x8,
+};
+
+// Signals of rvx_core sampled at the rising edge of the clock, before the edge is evaluated
+struct IrqSample
+{
+  uint16_t irq_fast;
+  bool irq_external;
+  bool irq_timer;
+  bool irq_software;
+  uint8_t current_state;
+  uint8_t mcause_code;
+  bool mcause_interrupt;
+};
+
+// Measures the latency from the assertion of each interrupt input of rvx_core to the fetch of the
+// first handler instruction (the cycle after STATE_TRAP_TAKEN), and the cycles spent between the
+// trap entry and the following mret.
+class IrqMonitor
+{
+public:
+  void sample(const IrqSample &s);
+  void report(std::ostream &out) const;
+
+private:
+  // Sources are indexed by their mcause exception code (fast interrupts are 16 to 31)
+  static constexpr size_t NUM_SOURCES = 32;
+
+  struct Source
+  {
+    bool level{false};
+    bool raised{false};
+    uint64_t raise_cycle{0};
+    uint64_t traps{0};
+    std::vector<uint64_t> latencies;
+    std::vector<uint64_t> isr_cycles;
+  };
+
+  struct Handler
+  {
+    bool interrupt;
+    size_t source;
+    uint64_t entry_cycle;
+  };
+
+  Source sources[NUM_SOURCES];
+  std::vector<Handler> handlers;
+  uint8_t prev_state{STATE_RESET};
+  uint64_t cycles{0};
+  uint64_t isr_cycles{0};
+
+  void update_source(size_t code, bool level);
+  static const char *source_name(size_t code);
+};
+
+#endif // IRQ_MONITOR_H
@@ -0,0 +1,892 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "iss.h"
+
+// Memory map of rvx.v
+static constexpr uint32_t UART_BASE = 0x80000000;
+static constexpr uint32_t MTIMER_BASE = 0x80010000;
+static constexpr uint32_t GPIO_BASE = 0x80020000;
+static constexpr uint32_t DEVICE_REGION = 0x20;
+
+static constexpr uint32_t UART_READY = 0x08;
+static constexpr uint32_t UART_STATUS = 0x10;
+// TX empty, and the TX empty and TX low interrupt conditions
+static constexpr uint32_t UART_STATUS_IDLE = 0x0c04;
+
+static constexpr uint32_t MTIMER_CR = 0x00;
+static constexpr uint32_t MTIMER_MTIMEL = 0x04;
+static constexpr uint32_t MTIMER_MTIMEH = 0x08;
+static constexpr uint32_t MTIMER_MTIMECMPL = 0x0c;
+static constexpr uint32_t MTIMER_MTIMECMPH = 0x10;
+
+static constexpr uint32_t GPIO_IN = 0x00;
+static constexpr uint32_t GPIO_OE = 0x04;
+static constexpr uint32_t GPIO_OUT = 0x08;
+static constexpr uint32_t GPIO_CLR = 0x0c;
+static constexpr uint32_t GPIO_SET = 0x10;
+
+enum Csr : uint32_t
+{
+  MSTATUS = 0x300,
+  MISA = 0x301,
+  MIE = 0x304,
+  MTVEC = 0x305,
+  MSCRATCH = 0x340,
+  MEPC = 0x341,
+  MCAUSE = 0x342,
+  MTVAL = 0x343,
+  MIP = 0x344,
+  MCYCLE = 0xb00,
+  MINSTRET = 0xb02,
+  MCYCLEH = 0xb80,
+  MINSTRETH = 0xb82,
+  CYCLE = 0xc00,
+  INSTRET = 0xc02,
+  CYCLEH = 0xc80,
+  INSTRETH = 0xc82,
+  MARCHID = 0xf12,
+  MIMPID = 0xf13,
+};
+
+enum Cause : uint32_t
+{
+  MISALIGNED_INSTRUCTION = 0,
+  ILLEGAL_INSTRUCTION = 2,
+  BREAKPOINT = 3,
+  MISALIGNED_LOAD = 4,
+  MISALIGNED_STORE = 6,
+  ECALL = 11,
+  TIMER_INTERRUPT = 7,
+};
+
+static inline int32_t sext(uint32_t value, unsigned bits)
+{
+  return (int32_t)(value << (32 - bits)) >> (32 - bits);
+}
+
+static inline bool in_region(uint32_t address, uint32_t base)
+{
+  return address - base < DEVICE_REGION;
+}
+
+// Bits hi..lo of value, moved to bit to
+static inline uint32_t field(uint32_t value, unsigned hi, unsigned lo, unsigned to)
+{
+  return (value >> lo & ((1u << (hi - lo + 1)) - 1)) << to;
+}
+
+// 32-bit instruction a compressed one expands to, 0 (illegal) for the reserved encodings and
+// those of the F and D extensions
+static uint32_t expand(uint32_t c)
+{
+  uint32_t rd = field(c, 11, 7, 0);
+  uint32_t rs2 = field(c, 6, 2, 0);
+  // rd', rs1' and rs2' of the formats with 3-bit register fields
+  uint32_t rd_short = field(c, 4, 2, 0) + 8;
+  uint32_t rs1_short = field(c, 9, 7, 0) + 8;
+  uint32_t imm6 = sext(field(c, 12, 12, 5) | field(c, 6, 2, 0), 6);
+
+  auto i_type = [](uint32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode)
+  { return (imm & 0xfff) << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode; };
+  auto r_type = [](uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd)
+  { return funct7 << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | 0x33; };
+  auto s_type = [](uint32_t imm, uint32_t rs2, uint32_t rs1)
+  { return (imm >> 5) << 25 | rs2 << 20 | rs1 << 15 | 0x2 << 12 | (imm & 0x1f) << 7 | 0x23; };
+  auto b_type = [](uint32_t imm, uint32_t rs1, uint32_t funct3)
+  {
+    return field(imm, 12, 12, 31) | field(imm, 10, 5, 25) | rs1 << 15 | funct3 << 12 |
+           field(imm, 4, 1, 8) | field(imm, 11, 11, 7) | 0x63;
+  };
+  auto jal = [](uint32_t imm, uint32_t rd)
+  {
+    return field(imm, 20, 20, 31) | field(imm, 10, 1, 21) | field(imm, 11, 11, 20) |
+           field(imm, 19, 12, 12) | rd << 7 | 0x6f;
+  };
+
+  // c.lw and c.sw offset, c.j and c.jal offset, c.beqz and c.bnez offset
+  uint32_t word_offset = field(c, 12, 10, 3) | field(c, 6, 6, 2) | field(c, 5, 5, 6);
+  uint32_t jump_offset = sext(field(c, 12, 12, 11) | field(c, 11, 11, 4) | field(c, 10, 9, 8) |
+                                  field(c, 8, 8, 10) | field(c, 7, 7, 6) | field(c, 6, 6, 7) |
+                                  field(c, 5, 3, 1) | field(c, 2, 2, 5),
+                              12);
+  uint32_t branch_offset = sext(field(c, 12, 12, 8) | field(c, 11, 10, 3) | field(c, 6, 5, 6) |
+                                    field(c, 4, 3, 1) | field(c, 2, 2, 5),
+                                9);
+
+  switch (field(c, 15, 13, 2) | field(c, 1, 0, 0))
+  {
+  case 0x00: // c.addi4spn
+  {
+    uint32_t imm = field(c, 12, 11, 4) | field(c, 10, 7, 6) | field(c, 6, 6, 2) | field(c, 5, 5, 3);
+    return imm ? i_type(imm, 2, 0, rd_short, 0x13) : 0;
+  }
+  case 0x08: // c.lw
+    return i_type(word_offset, rs1_short, 2, rd_short, 0x03);
+  case 0x18: // c.sw
+    return s_type(word_offset, rd_short, rs1_short);
+  case 0x01: // c.addi
+    return i_type(imm6, rd, 0, rd, 0x13);
+  case 0x05: // c.jal
+    return jal(jump_offset, 1);
+  case 0x09: // c.li
+    return i_type(imm6, 0, 0, rd, 0x13);
+  case 0x0d: // c.addi16sp, c.lui
+    if (rd == 2)
+    {
+      uint32_t imm = sext(field(c, 12, 12, 9) | field(c, 6, 6, 4) | field(c, 5, 5, 6) |
+                              field(c, 4, 3, 7) | field(c, 2, 2, 5),
+                          10);
+      return imm ? i_type(imm, 2, 0, 2, 0x13) : 0;
+    }
+    return imm6 ? (imm6 << 12) | rd << 7 | 0x37 : 0;
+  case 0x11: // c.srli, c.srai, c.andi, c.sub, c.xor, c.or, c.and
+    switch (field(c, 11, 10, 0))
+    {
+    case 0:
+    case 1:
+      return field(c, 12, 12, 0) ? 0
+                                 : i_type(field(c, 11, 10, 10) | rs2, rs1_short, 5, rs1_short,
+                                          0x13);
+    case 2:
+      return i_type(imm6, rs1_short, 7, rs1_short, 0x13);
+    default:
+    {
+      static const uint32_t funct3[4] = {0, 4, 6, 7};
+      uint32_t op = field(c, 6, 5, 0);
+      return field(c, 12, 12, 0) ? 0
+                                 : r_type(op == 0 ? 0x20 : 0, rd_short, rs1_short, funct3[op],
+                                          rs1_short);
+    }
+    }
+  case 0x15: // c.j
+    return jal(jump_offset, 0);
+  case 0x19: // c.beqz
+  case 0x1d: // c.bnez
+    return b_type(branch_offset, rs1_short, field(c, 13, 13, 0));
+  case 0x02: // c.slli
+    return field(c, 12, 12, 0) ? 0 : i_type(rs2, rd, 1, rd, 0x13);
+  case 0x0a: // c.lwsp
+  {
+    uint32_t imm = field(c, 12, 12, 5) | field(c, 6, 4, 2) | field(c, 3, 2, 6);
+    return rd ? i_type(imm, 2, 2, rd, 0x03) : 0;
+  }
+  case 0x12: // c.jr, c.mv, c.ebreak, c.jalr, c.add
+    if (!field(c, 12, 12, 0))
+    {
+      if (rs2)
+      {
+        return r_type(0, rs2, 0, 0, rd);
+      }
+      return rd ? i_type(0, rd, 0, 0, 0x67) : 0;
+    }
+    if (rs2)
+    {
+      return r_type(0, rs2, rd, 0, rd);
+    }
+    return rd ? i_type(0, rd, 0, 1, 0x67) : 0x00100073;
+  case 0x1a: // c.swsp
+    return s_type(field(c, 12, 9, 2) | field(c, 8, 7, 6), rs2, 2);
+  default:
+    return 0;
+  }
+}
+
+Iss::Iss(uint32_t memory_size, uint32_t gpio_width)
+    : ram(memory_size / 4), gpio_mask(gpio_width >= 32 ? ~0u : (1u << gpio_width) - 1)
+{
+}
+
+// Division by zero and overflow give the results of the specification, there is no trap
+uint32_t Iss::muldiv(uint32_t funct3, uint32_t a, uint32_t b) const
+{
+  int64_t sa = (int32_t)a;
+  int64_t sb = (int32_t)b;
+
+  switch (funct3)
+  {
+  case 0: // mul
+    return a * b;
+  case 1: // mulh
+    return (uint64_t)(sa * sb) >> 32;
+  case 2: // mulhsu
+    return (uint64_t)(sa * (int64_t)b) >> 32;
+  case 3: // mulhu
+    return ((uint64_t)a * b) >> 32;
+  case 4: // div
+    return b == 0 ? ~0u : (uint32_t)(int32_t)(sa / sb);
+  case 5: // divu
+    return b == 0 ? ~0u : a / b;
+  case 6: // rem
+    return b == 0 ? a : (uint32_t)(int32_t)(sa % sb);
+  default: // remu
+    return b == 0 ? a : a % b;
+  }
+}
+
+bool Iss::bitmanip(uint32_t instruction, uint32_t a, uint32_t b, uint32_t &result)
+{
+  uint32_t funct3 = (instruction >> 12) & 0x7;
+  uint32_t funct7 = instruction >> 25;
+  uint32_t rs2 = (instruction >> 20) & 0x1f;
+  bool imm = (instruction & 0x7f) == 0x13;
+  auto rotate_right = [](uint32_t x, uint32_t n) { return n ? x >> n | x << (32 - n) : x; };
+
+  if (imm)
+  {
+    switch (instruction >> 20 << 3 | funct3)
+    {
+    case 0x287 << 3 | 5: // orc.b
+      result = 0;
+      for (int i = 0; i < 32; i += 8)
+      {
+        result |= (a >> i & 0xff ? 0xffu : 0u) << i;
+      }
+      return true;
+    case 0x698 << 3 | 5: // rev8
+      result = a << 24 | (a & 0xff00) << 8 | (a >> 8 & 0xff00) | a >> 24;
+      return true;
+    case 0x600 << 3 | 1: // clz
+      result = a ? __builtin_clz(a) : 32;
+      return true;
+    case 0x601 << 3 | 1: // ctz
+      result = a ? __builtin_ctz(a) : 32;
+      return true;
+    case 0x602 << 3 | 1: // cpop
+      result = __builtin_popcount(a);
+      return true;
+    case 0x604 << 3 | 1: // sext.b
+      result = (int32_t)(int8_t)a;
+      return true;
+    case 0x605 << 3 | 1: // sext.h
+      result = (int32_t)(int16_t)a;
+      return true;
+    }
+    if (funct3 == 5 && funct7 == 0x30) // rori
+    {
+      result = rotate_right(a, rs2);
+      return true;
+    }
+    return false;
+  }
+
+  switch (funct7 << 3 | funct3)
+  {
+  case 0x10 << 3 | 2: // sh1add
+  case 0x10 << 3 | 4: // sh2add
+  case 0x10 << 3 | 6: // sh3add
+    result = (a << (funct3 >> 1)) + b;
+    break;
+  case 0x20 << 3 | 7: // andn
+    result = a & ~b;
+    break;
+  case 0x20 << 3 | 6: // orn
+    result = a | ~b;
+    break;
+  case 0x20 << 3 | 4: // xnor
+    result = ~(a ^ b);
+    break;
+  case 0x05 << 3 | 4: // min
+    result = (int32_t)a < (int32_t)b ? a : b;
+    break;
+  case 0x05 << 3 | 5: // minu
+    result = a < b ? a : b;
+    break;
+  case 0x05 << 3 | 6: // max
+    result = (int32_t)a < (int32_t)b ? b : a;
+    break;
+  case 0x05 << 3 | 7: // maxu
+    result = a < b ? b : a;
+    break;
+  case 0x30 << 3 | 1: // rol
+    result = rotate_right(a, (32 - (b & 0x1f)) & 0x1f);
+    break;
+  case 0x30 << 3 | 5: // ror
+    result = rotate_right(a, b & 0x1f);
+    break;
+  case 0x04 << 3 | 4: // zext.h
+    if (rs2 != 0)
+    {
+      return false;
+    }
+    result = a & 0xffff;
+    break;
+  default:
+    return false;
+  }
+  return true;
+}
+
+uint32_t Iss::fetch(uint32_t address) const
+{
+  uint32_t word = address / 4 < ram.size() ? ram[address / 4] : 0;
+  return address & 0x2 ? word >> 16 : word & 0xffff;
+}
+
+uint64_t Iss::run(uint64_t count)
+{
+  uint64_t start = executed;
+
+  while (!done && executed - start < count)
+  {
+    step();
+    executed++;
+    advance_time();
+  }
+
+  return executed - start;
+}
+
+void Iss::advance_time()
+{
+  cycle_fraction += cpi;
+  uint64_t cycles = (uint64_t)cycle_fraction;
+  cycle_fraction -= cycles;
+
+  state.mcycle += cycles;
+  if (state.timer_enable)
+  {
+    state.mtime += cycles;
+  }
+}
+
+void Iss::trap(uint32_t code, bool interrupt, uint32_t tval)
+{
+  state.mepc = state.pc;
+  state.mcause_code = code;
+  state.mcause_interrupt = interrupt;
+  state.mcause = (interrupt ? 0x80000000u : 0) | code;
+  state.mtval = tval;
+  state.mstatus_mpie = state.mstatus_mie;
+  state.mstatus_mie = false;
+
+  // Vectored mode only applies to interrupts
+  state.pc = state.mtvec & ~0x3u;
+  if ((state.mtvec & 0x3) == 1 && interrupt)
+  {
+    state.pc += 4 * code;
+  }
+}
+
+bool Iss::load(uint32_t address, uint32_t size, uint32_t &value)
+{
+  if (address & (size - 1))
+  {
+    trap(MISALIGNED_LOAD, false, address);
+    return false;
+  }
+
+  uint32_t word = 0;
+  uint32_t aligned = address & ~0x3u;
+  uint32_t offset = aligned & (DEVICE_REGION - 1);
+
+  if (aligned / 4 < ram.size())
+  {
+    word = ram[aligned / 4];
+  }
+  else if (in_region(aligned, UART_BASE))
+  {
+    word = offset == UART_READY ? 1 : offset == UART_STATUS ? UART_STATUS_IDLE : 0;
+  }
+  else if (in_region(aligned, MTIMER_BASE))
+  {
+    switch (offset)
+    {
+    case MTIMER_CR:
+      word = state.timer_enable;
+      break;
+    case MTIMER_MTIMEL:
+      word = (uint32_t)state.mtime;
+      break;
+    case MTIMER_MTIMEH:
+      word = state.mtime >> 32;
+      break;
+    case MTIMER_MTIMECMPL:
+      word = (uint32_t)state.mtimecmp;
+      break;
+    case MTIMER_MTIMECMPH:
+      word = state.mtimecmp >> 32;
+      break;
+    }
+  }
+  else if (in_region(aligned, GPIO_BASE))
+  {
+    switch (offset)
+    {
+    case GPIO_IN:
+      word = gpio_input & gpio_mask;
+      break;
+    case GPIO_OE:
+      word = state.gpio_oe;
+      break;
+    case GPIO_OUT:
+      word = state.gpio_out;
+      break;
+    }
+  }
+
+  value = word >> (8 * (address & 0x3));
+  return true;
+}
+
+bool Iss::store(uint32_t address, uint32_t size, uint32_t value)
+{
+  if (address & (size - 1))
+  {
+    trap(MISALIGNED_STORE, false, address);
+    return false;
+  }
+
+  if (host_out && address == host_out && console)
+  {
+    console((char)value);
+  }
+  if (wr_addr && address == wr_addr && value == 1)
+  {
+    done = true;
+  }
+
+  uint32_t aligned = address & ~0x3u;
+  uint32_t offset = aligned & (DEVICE_REGION - 1);
+
+  if (aligned / 4 < ram.size())
+  {
+    uint32_t shift = 8 * (address & 0x3);
+    uint32_t mask = (size == 4 ? ~0u : (1u << (8 * size)) - 1) << shift;
+    ram[aligned / 4] = (ram[aligned / 4] & ~mask) | ((value << shift) & mask);
+    return true;
+  }
+
+  // The peripherals only take word writes
+  if (size != 4)
+  {
+    return true;
+  }
+
+  if (in_region(aligned, MTIMER_BASE))
+  {
+    switch (offset)
+    {
+    case MTIMER_CR:
+      state.timer_enable = value & 0x1;
+      break;
+    case MTIMER_MTIMEL:
+      state.mtime = (state.mtime & ~0xffffffffull) | value;
+      break;
+    case MTIMER_MTIMEH:
+      state.mtime = (state.mtime & 0xffffffffull) | ((uint64_t)value << 32);
+      break;
+    case MTIMER_MTIMECMPL:
+      state.mtimecmp = (state.mtimecmp & ~0xffffffffull) | value;
+      break;
+    case MTIMER_MTIMECMPH:
+      state.mtimecmp = (state.mtimecmp & 0xffffffffull) | ((uint64_t)value << 32);
+      break;
+    }
+  }
+  else if (in_region(aligned, GPIO_BASE))
+  {
+    switch (offset)
+    {
+    case GPIO_OE:
+      state.gpio_oe = value & gpio_mask;
+      break;
+    case GPIO_OUT:
+      state.gpio_out = value & gpio_mask;
+      break;
+    case GPIO_CLR:
+      state.gpio_out &= ~value & gpio_mask;
+      break;
+    case GPIO_SET:
+      state.gpio_out |= value & gpio_mask;
+      break;
+    }
+  }
+  // UART transmissions and SPI transfers take no time and have no effect
+  return true;
+}
+
+uint32_t Iss::read_csr(uint32_t address) const
+{
+  const IssState &s = state;
+
+  switch (address)
+  {
+  case MARCHID:
+    return 0x00000018;
+  case MIMPID:
+    return 0x00000006;
+  case CYCLE:
+  case MCYCLE:
+    return (uint32_t)s.mcycle;
+  case CYCLEH:
+  case MCYCLEH:
+    return s.mcycle >> 32;
+  case INSTRET:
+  case MINSTRET:
+    return (uint32_t)s.minstret;
+  case INSTRETH:
+  case MINSTRETH:
+    return s.minstret >> 32;
+  case MSTATUS:
+    return (0x3 << 11) | (s.mstatus_mpie << 7) | (s.mstatus_mie << 3);
+  case MISA:
+    return 0x40000100 | (m_extension ? 0x1000 : 0) | (c_extension ? 0x4 : 0);
+  case MIE:
+    return ((uint32_t)s.mie_mfie << 16) | (s.mie_meie << 11) | (s.mie_mtie << 7) |
+           (s.mie_msie << 3);
+  case MTVEC:
+    return s.mtvec;
+  case MSCRATCH:
+    return s.mscratch;
+  case MEPC:
+    return s.mepc;
+  case MCAUSE:
+    return s.mcause;
+  case MTVAL:
+    return s.mtval;
+  case MIP:
+    return (s.mtime >= s.mtimecmp) << 7;
+  default:
+    // time and timeh included, the real time clock of rvx is not connected
+    return 0;
+  }
+}
+
+void Iss::write_csr(uint32_t address, uint32_t value)
+{
+  IssState &s = state;
+
+  switch (address)
+  {
+  case MSTATUS:
+    s.mstatus_mie = value >> 3 & 0x1;
+    s.mstatus_mpie = value >> 7 & 0x1;
+    break;
+  case MIE:
+    s.mie_mfie = value >> 16;
+    s.mie_meie = value >> 11 & 0x1;
+    s.mie_mtie = value >> 7 & 0x1;
+    s.mie_msie = value >> 3 & 0x1;
+    break;
+  case MTVEC:
+    s.mtvec = (value & ~0x3u) | (value & 0x1);
+    break;
+  case MSCRATCH:
+    s.mscratch = value;
+    break;
+  case MEPC:
+    s.mepc = value & (c_extension ? ~0x1u : ~0x3u);
+    break;
+  case MCAUSE:
+    s.mcause = value;
+    break;
+  case MTVAL:
+    s.mtval = value;
+    break;
+  case MCYCLE:
+    s.mcycle = (s.mcycle & ~0xffffffffull) | value;
+    break;
+  case MCYCLEH:
+    s.mcycle = (s.mcycle & 0xffffffffull) | ((uint64_t)value << 32);
+    break;
+  case MINSTRET:
+    s.minstret = (s.minstret & ~0xffffffffull) | value;
+    break;
+  case MINSTRETH:
+    s.minstret = (s.minstret & 0xffffffffull) | ((uint64_t)value << 32);
+    break;
+  }
+}
+
+void Iss::step()
+{
+  IssState &s = state;
+  uint32_t *x = s.x;
+
+  // The RTL takes a pending interrupt instead of executing the next instruction
+  if (s.mstatus_mie && s.mie_mtie && s.mtime >= s.mtimecmp)
+  {
+    trap(TIMER_INTERRUPT, true, 0);
+    return;
+  }
+
+  // Parcels of 16 bits, the PC is only 2-byte aligned with the C extension
+  uint32_t instruction = fetch(s.pc);
+  uint32_t size = 4;
+  if (c_extension && (instruction & 0x3) != 0x3)
+  {
+    instruction = expand(instruction);
+    size = 2;
+  }
+  else
+  {
+    instruction |= fetch(s.pc + 2) << 16;
+  }
+
+  uint32_t opcode = instruction & 0x7f;
+  uint32_t rd = instruction >> 7 & 0x1f;
+  uint32_t funct3 = instruction >> 12 & 0x7;
+  uint32_t rs1 = instruction >> 15 & 0x1f;
+  uint32_t rs2 = instruction >> 20 & 0x1f;
+  uint32_t funct7 = instruction >> 25;
+
+  int32_t imm_i = (int32_t)instruction >> 20;
+  int32_t imm_s = sext((funct7 << 5) | rd, 12);
+  int32_t imm_b = sext(((instruction >> 31) << 12) | ((instruction >> 7 & 0x1) << 11) |
+                           ((instruction >> 25 & 0x3f) << 5) | ((instruction >> 8 & 0xf) << 1),
+                       13);
+  int32_t imm_j = sext(((instruction >> 31) << 20) | ((instruction >> 12 & 0xff) << 12) |
+                           ((instruction >> 20 & 0x1) << 11) | ((instruction >> 21 & 0x3ff) << 1),
+                       21);
+
+  uint32_t a = x[rs1];
+  uint32_t b = x[rs2];
+  uint32_t next_pc = s.pc + size;
+  uint32_t result = 0;
+  bool write_rd = false;
+
+  switch (opcode)
+  {
+  case 0x37: // lui
+    result = instruction & 0xfffff000;
+    write_rd = true;
+    break;
+
+  case 0x17: // auipc
+    result = s.pc + (instruction & 0xfffff000);
+    write_rd = true;
+    break;
+
+  case 0x6f: // jal
+  case 0x67: // jalr
+  case 0x63: // branches
+  {
+    uint32_t target;
+    bool taken = true;
+
+    if (opcode == 0x6f)
+    {
+      target = s.pc + imm_j;
+    }
+    else if (opcode == 0x67)
+    {
+      if (funct3 != 0)
+      {
+        trap(ILLEGAL_INSTRUCTION, false, 0);
+        return;
+      }
+      target = (a + imm_i) & ~0x1u;
+    }
+    else
+    {
+      target = s.pc + imm_b;
+      switch (funct3)
+      {
+      case 0:
+        taken = a == b;
+        break;
+      case 1:
+        taken = a != b;
+        break;
+      case 4:
+        taken = (int32_t)a < (int32_t)b;
+        break;
+      case 5:
+        taken = (int32_t)a >= (int32_t)b;
+        break;
+      case 6:
+        taken = a < b;
+        break;
+      case 7:
+        taken = a >= b;
+        break;
+      default:
+        trap(ILLEGAL_INSTRUCTION, false, 0);
+        return;
+      }
+    }
+
+    if (taken)
+    {
+      if ((target & 0x2) && !c_extension)
+      {
+        trap(MISALIGNED_INSTRUCTION, false, target);
+        return;
+      }
+      next_pc = target;
+    }
+    result = s.pc + size;
+    write_rd = opcode != 0x63;
+    break;
+  }
+
+  case 0x03: // loads
+  {
+    static const uint32_t sizes[8] = {1, 2, 4, 0, 1, 2, 0, 0};
+    uint32_t size = sizes[funct3];
+    uint32_t value;
+
+    if (!size)
+    {
+      trap(ILLEGAL_INSTRUCTION, false, 0);
+      return;
+    }
+    if (!load(a + imm_i, size, value))
+    {
+      return;
+    }
+
+    switch (funct3)
+    {
+    case 0:
+      result = sext(value & 0xff, 8);
+      break;
+    case 1:
+      result = sext(value & 0xffff, 16);
+      break;
+    case 4:
+      result = value & 0xff;
+      break;
+    case 5:
+      result = value & 0xffff;
+      break;
+    default:
+      result = value;
+      break;
+    }
+    write_rd = true;
+    break;
+  }
+
+  case 0x23: // stores
+  {
+    if (funct3 > 2)
+    {
+      trap(ILLEGAL_INSTRUCTION, false, 0);
+      return;
+    }
+
+    if (!store(a + imm_s, 1u << funct3, b))
+    {
+      return;
+    }
+    break;
+  }
+
+  case 0x13: // op-imm
+  case 0x33: // op
+  {
+    bool imm = opcode == 0x13;
+    if (!imm && funct7 == 0x01 && m_extension)
+    {
+      result = muldiv(funct3, a, b);
+      write_rd = true;
+      break;
+    }
+    if (zba_zbb && bitmanip(instruction, a, b, result))
+    {
+      write_rd = true;
+      break;
+    }
+
+    uint32_t operand = imm ? (uint32_t)imm_i : b;
+    uint32_t shamt = operand & 0x1f;
+
+    // funct7 selects sub and sra, the op-imm instructions other than the shifts have none
+    bool has_funct7 = !imm || funct3 == 1 || funct3 == 5;
+    bool alternate = has_funct7 && funct7 == 0x20;
+    if (has_funct7 && funct7 != 0x00 && !(alternate && (funct3 == 5 || (!imm && funct3 == 0))))
+    {
+      trap(ILLEGAL_INSTRUCTION, false, 0);
+      return;
+    }
+
+    switch (funct3)
+    {
+    case 0:
+      result = alternate ? a - operand : a + operand;
+      break;
+    case 1:
+      result = a << shamt;
+      break;
+    case 2:
+      result = (int32_t)a < (int32_t)operand;
+      break;
+    case 3:
+      result = a < operand;
+      break;
+    case 4:
+      result = a ^ operand;
+      break;
+    case 5:
+      result = alternate ? (uint32_t)((int32_t)a >> shamt) : a >> shamt;
+      break;
+    case 6:
+      result = a | operand;
+      break;
+    case 7:
+      result = a & operand;
+      break;
+    }
+    write_rd = true;
+    break;
+  }
+
+  case 0x0f: // fence, fence.i
+    break;
+
+  case 0x73: // system
+    if (funct3 == 0 && rs1 == 0 && rd == 0)
+    {
+      switch (instruction >> 20)
+      {
+      case 0x000:
+        trap(ECALL, false, 0);
+        return;
+      case 0x001:
+        trap(BREAKPOINT, false, s.pc);
+        return;
+      case 0x302:
+        s.mstatus_mie = s.mstatus_mpie;
+        s.mstatus_mpie = true;
+        next_pc = s.mepc;
+        break;
+      default:
+        trap(ILLEGAL_INSTRUCTION, false, 0);
+        return;
+      }
+    }
+    else if (funct3 == 0 || funct3 == 4)
+    {
+      trap(ILLEGAL_INSTRUCTION, false, 0);
+      return;
+    }
+    else
+    {
+      // The RTL writes the CSR for every csrxxx instruction, even when the value is unchanged
+      uint32_t csr = instruction >> 20;
+      uint32_t mask = funct3 & 0x4 ? rs1 : a;
+      uint32_t old = read_csr(csr);
+      uint32_t value = (funct3 & 0x3) == 1 ? mask : (funct3 & 0x3) == 2 ? old | mask : old & ~mask;
+
+      write_csr(csr, value);
+      result = old;
+      write_rd = true;
+    }
+    break;
+
+  default:
+    trap(ILLEGAL_INSTRUCTION, false, 0);
+    return;
+  }
+
+  if (write_rd && rd)
+  {
+    x[rd] = result;
+  }
+
+  // A write to minstret or mcycle is followed by the increment of the instruction, like in the RTL
+  s.minstret++;
+  s.pc = next_pc;
+}
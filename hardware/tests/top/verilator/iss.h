@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef ISS_H
+#define ISS_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Architectural state of the MCU, in the fields of the RTL model it is copied to
+struct IssState
+{
+  uint32_t pc{0};
+  uint32_t x[32]{};
+
+  bool mstatus_mie{false};
+  bool mstatus_mpie{true};
+  bool mie_meie{false};
+  bool mie_mtie{false};
+  bool mie_msie{false};
+  uint16_t mie_mfie{0};
+  uint32_t mepc{0};
+  uint32_t mtvec{0};
+  uint32_t mscratch{0};
+  uint32_t mtval{0};
+  uint32_t mcause{0};
+  uint32_t mcause_code{0};
+  bool mcause_interrupt{false};
+  uint64_t mcycle{0};
+  uint64_t minstret{0};
+
+  // rvx_mtimer
+  bool timer_enable{false};
+  uint64_t mtime{0};
+  uint64_t mtimecmp{~0ull};
+
+  // rvx_gpio
+  uint32_t gpio_oe{0};
+  uint32_t gpio_out{0};
+};
+
+// Instruction set simulator of the RVX core (RV32I[M][C] and Zicsr, M-mode only), used to fast-forward
+// a program between the measurement windows of a sampled simulation. It follows the RTL where the
+// specification leaves a choice: unknown CSRs read as 0, misaligned accesses trap, mtvec vectored
+// mode only applies to interrupts.
+//
+// There is no notion of time besides the instruction count: mcycle and mtime advance by cpi
+// cycles per instruction. The peripherals are reduced to what keeps a program running: the
+// timer and its interrupt, the GPIO registers (inputs read as gpio_input), a UART that is always
+// ready to transmit and never receives, and an SPI controller that is never busy.
+class Iss
+{
+public:
+  Iss(uint32_t memory_size, uint32_t gpio_width);
+
+  IssState state;
+  std::vector<uint32_t> ram;
+  uint32_t gpio_input{0};
+
+  // Cycles per instruction of mcycle and mtime
+  double cpi{1.0};
+
+  // Core built with M_EXTENSION, C_EXTENSION and ZBA_ZBB_EXTENSION
+  bool m_extension{false};
+  bool c_extension{false};
+  bool zba_zbb{false};
+
+  // Stores to host_out are passed to console, a store of 1 to wr_addr ends the program
+  uint32_t host_out{0};
+  uint32_t wr_addr{0};
+  std::function<void(char)> console;
+
+  bool finished() const
+  {
+    return done;
+  }
+
+  uint64_t instructions() const
+  {
+    return executed;
+  }
+
+  // Executes up to count instructions, returns how many were executed. A trap counts as one.
+  uint64_t run(uint64_t count);
+
+private:
+  uint32_t gpio_mask;
+  bool done{false};
+  uint64_t executed{0};
+  double cycle_fraction{0};
+
+  void step();
+  void trap(uint32_t code, bool interrupt, uint32_t tval);
+  bool load(uint32_t address, uint32_t size, uint32_t &value);
+  bool store(uint32_t address, uint32_t size, uint32_t value);
+  uint32_t read_csr(uint32_t address) const;
+  void write_csr(uint32_t address, uint32_t value);
+  void advance_time();
+  uint32_t muldiv(uint32_t funct3, uint32_t a, uint32_t b) const;
+  // Zba/Zbb instruction with operands a (rs1) and b (rs2), false if it is not one of them
+  static bool bitmanip(uint32_t instruction, uint32_t a, uint32_t b, uint32_t &result);
+  uint32_t fetch(uint32_t address) const;
+};
+
+#endif // ISS_H
@@ -65,6 +65,10 @@ class Log
     static void set_out(const std::string& filename)
     {
       Log &log = get_instance();
+      if (log.fileout.is_open())
+      {
+        log.fileout.close();
+      }
       log.fileout.open(filename, std::ios::out | std::ios::trunc);
 
       if (log.fileout.is_open())
@@ -73,6 +77,12 @@ class Log
       }
     }
 
+    // Called before fork(), so the buffered output is not written twice
+    static void flush()
+    {
+      get_instance().log_stream->flush();
+    }
+
     template<typename... Targs>
     static void debug(const char* format, Targs... Fargs)
     {
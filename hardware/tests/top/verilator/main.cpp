@@ -3,28 +3,61 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <signal.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <verilated_fst_c.h>
+#include <verilated_save.h>
 
 #include "Vmcu_sim.h"
 #include "Vmcu_sim___024root.h"
 #include "argparse.h"
+#include "bus_monitor.h"
+#include "cache_sim.h"
+#include "checkpoint.h"
+#include "fault_campaign.h"
+#include "fork_runner.h"
+#include "gdb_stub.h"
+#include "irq_monitor.h"
+#include "iss.h"
 #include "log.h"
 #include "ram_init.h"
+#include "sampling.h"
+#include "server.h"
+#include "stimulus.h"
+#include "system_sim.h"
+#include "tlm_peripherals.h"
 
 using Dut = Vmcu_sim;
 using Trace = VerilatedFstC;
 
 vluint64_t trace_time = 0;
+vluint64_t trace_end = 0;
 vluint64_t clk_cur_cycles = 0;
 vluint64_t clk_half_cycles = 2;
+vluint64_t clk_interval = 0;
+// Store to --host-out presented in the last cycle, printed when the device responds
+bool host_out_pending = false;
+char host_out_data = 0;
 Dut *dut = new Dut;
 Trace *trace = new Trace;
 Args args;
+BusMonitor *bus_monitor = nullptr;
+CacheMonitor *cache_monitor = nullptr;
+IrqMonitor *irq_monitor = nullptr;
+Stimulus *stimulus = nullptr;
+StimulusPins stimulus_pins;
+CheckpointStore *checkpoints = nullptr;
+FaultCampaign *fault_campaign = nullptr;
+uint64_t fault_exceptions = 0;
+uint8_t fault_core_state = 0;
 
 static void open_trace(const char *out_wave_path)
 {
@@ -39,35 +72,263 @@ static void close_trace()
 {
   if (trace->isOpen())
   {
-    trace->dump(trace_time);
+    if (trace_time >= trace_end)
+    {
+      trace->dump(trace_time);
+    }
     trace->close();
   }
 }
 
-static void clk()
+static void final_dut()
 {
-  static vluint64_t interval = 0;
+  // Completes the model. Builds with --prof-pgo write their profile (profile.vlt) at this point.
+  dut->final();
+  delete dut;
+}
 
-  if (trace_time >= interval)
+static bool clk()
+{
+  if (trace_time >= clk_interval)
   {
     dut->clock ^= 1;
-    interval = trace_time + clk_half_cycles;
+    clk_interval = trace_time + clk_half_cycles;
     clk_cur_cycles += dut->clock & 0x1;
+    return dut->clock & 0x1;
+  }
+
+  return false;
+}
+
+static void sample_monitors()
+{
+#ifdef MCU_SIM_INTROSPECTION
+  // Called at each rising edge of the clock, before it is evaluated, so the signals still hold the
+  // values of the cycle that is ending
+  if (dut->reset)
+  {
+    return;
+  }
+
+  if (bus_monitor || cache_monitor)
+  {
+    BusSample s;
+    s.address = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__rw_address;
+    s.read_request =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__read_request;
+    s.write_request =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_request;
+    s.write_strobe =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_strobe;
+    s.device_sel = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_bus_instance__DOT__device_sel;
+    s.device_sel_save =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_bus_instance__DOT__device_sel_save;
+    s.read_response =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_bus_instance__DOT__manager_read_response;
+    s.write_response =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_bus_instance__DOT__manager_write_response;
+
+    if (bus_monitor)
+    {
+      bus_monitor->sample(s);
+    }
+
+    if (cache_monitor)
+    {
+      cache_monitor->sample(
+          s, dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__load_request);
+    }
+  }
+
+  if (irq_monitor)
+  {
+    IrqSample s;
+    s.irq_fast = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__irq_fast;
+    s.irq_external =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__irq_external;
+    s.irq_timer = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__irq_timer;
+    s.irq_software =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__irq_software;
+    s.current_state =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__current_state;
+    s.mcause_code =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mcause_code;
+    s.mcause_interrupt =
+        dut->rootp
+            ->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mcause_interrupt_flag;
+    irq_monitor->sample(s);
+  }
+
+  // --fault-campaign: exceptions taken, interrupts are not counted
+  if (fault_campaign)
+  {
+    uint8_t state =
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__current_state;
+    if (state == STATE_TRAP_TAKEN && fault_core_state != STATE_TRAP_TAKEN &&
+        !dut->rootp
+             ->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mcause_interrupt_flag)
+    {
+      fault_exceptions++;
+    }
+    fault_core_state = state;
+  }
+#endif
+}
+
+static void write_report(const char *path, const std::function<void(std::ostream &)> &report)
+{
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+  if (!file.is_open())
+  {
+    Log::error("Error file opening: %s", path);
+    return;
+  }
+
+  report(file);
+  Log::info("Report saved: %s", path);
+}
+
+static void write_reports()
+{
+  if (bus_monitor)
+  {
+    write_report(args.bus_profile_path, [](std::ostream &out) { bus_monitor->report(out); });
+  }
+
+  if (cache_monitor && args.cache_sim_path)
+  {
+    write_report(args.cache_sim_path, [](std::ostream &out) { cache_monitor->report(out); });
+  }
+
+  if (irq_monitor)
+  {
+    write_report(args.irq_profile_path, [](std::ostream &out) { irq_monitor->report(out); });
+  }
+}
+
+static void open_monitors()
+{
+  if (args.bus_profile_path)
+  {
+    // Memory map of rvx.v
+    bus_monitor = new BusMonitor({
+        {"RAM", 0x00000000, args.bus_profile_bucket},
+        {"UART", 0x80000000, 4},
+        {"MTIMER", 0x80010000, 4},
+        {"GPIO", 0x80020000, 4},
+        {"SPI", 0x80030000, 4},
+    });
+  }
+
+  if (args.cache_sim_path || args.mem_trace_path)
+  {
+    std::vector<CacheConfig> configs;
+
+    for (const char *description : args.cache_configs)
+    {
+      CacheConfig config;
+      if (!config.parse(description))
+      {
+        Log::error("Invalid cache configuration: %s", description);
+        std::exit(EXIT_FAILURE);
+      }
+      configs.push_back(config);
+    }
+
+    if (configs.empty())
+    {
+      for (CacheKind kind : {CacheKind::INSTRUCTION, CacheKind::DATA})
+        for (uint32_t size : {1024, 2048, 4096})
+          for (uint32_t ways : {1, 2})
+            configs.push_back({kind, size, 16, ways, Replacement::LRU});
+    }
+
+    cache_monitor = new CacheMonitor(configs, args.cache_latency, args.mem_trace_path);
+  }
+
+  if (args.irq_profile_path)
+  {
+    irq_monitor = new IrqMonitor;
+  }
+
+  std::atexit(write_reports);
+}
+
+static void load_stimulus(const char *path, uint64_t start_cycle)
+{
+  StimulusTiming timing;
+  timing.clock_period_ns = clk_half_cycles * 2;
+  timing.clock_frequency = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__CLOCK_FREQUENCY;
+  timing.uart_baud_rate = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__UART_BAUD_RATE;
+  timing.gpio_width = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__GPIO_WIDTH;
+  timing.start_cycle = start_cycle;
+
+  std::string error;
+  delete stimulus;
+  stimulus = new Stimulus(timing);
+  if (!stimulus->load(path, error))
+  {
+    Log::error("%s", error.c_str());
+    std::exit(EXIT_FAILURE);
+  }
+
+  Log::info("Stimulus: %zu pin changes", stimulus->size());
+}
+
+static void open_stimulus()
+{
+  if (args.stimulus_path)
+  {
+    load_stimulus(args.stimulus_path, 0);
   }
 }
 
-static void eval(vluint64_t cycles_cnt = 1)
+static void drive_stimulus()
 {
+  // The inputs are changed before the rising edge is evaluated, so they are sampled at this edge
+  if (stimulus && stimulus->due(clk_cur_cycles))
+  {
+    stimulus->apply(clk_cur_cycles, stimulus_pins);
+    dut->uart_rx = stimulus_pins.uart_rx;
+    dut->poci = stimulus_pins.poci;
+    dut->gpio_input = stimulus_pins.gpio_input;
+  }
+}
+
+// Returns true if the last step was a rising edge of the clock
+static bool eval(vluint64_t cycles_cnt = 1)
+{
+  bool rising_edge = false;
+
   while (cycles_cnt--)
   {
-    clk();
+    rising_edge = clk();
+    if (rising_edge)
+    {
+      sample_monitors();
+      drive_stimulus();
+    }
     dut->eval();
-    trace->dump(trace_time++);
+
+    // After going back to a checkpoint, the steps already in the waveform are not dumped again
+    if (trace_time >= trace_end)
+    {
+      trace->dump(trace_time);
+      trace_end = trace_time + 1;
+    }
+    trace_time++;
   }
+
+  return rising_edge;
 }
 
 static void reset_dut()
 {
+  // The UART line idles high, otherwise the receiver sees a stream of 0x00 bytes
+  dut->uart_rx = stimulus_pins.uart_rx;
+  dut->poci = stimulus_pins.poci;
+  dut->gpio_input = stimulus_pins.gpio_input;
   dut->reset = 1;
   eval(100);
   dut->reset = 0;
@@ -102,11 +363,11 @@ static void ram_init(const char *path, RamInitVariants variants)
 
   uint32_t ram_size = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__MEMORY_SIZE;
 
-  switch (args.ram_init_variants)
+  switch (variants)
   {
   case RamInitVariants::H32:
     ram_init_h32(
-        args.ram_init_path, ram_size / 4,
+        path, ram_size / 4,
         [](uint32_t i, uint32_t v) {
           dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[i] = v;
         });
@@ -114,7 +375,7 @@ static void ram_init(const char *path, RamInitVariants variants)
 
   case RamInitVariants::BIN:
     ram_init_bin(
-        args.ram_init_path, ram_size / 4,
+        path, ram_size / 4,
         [](uint32_t i, uint32_t v) {
           dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[i] = v;
         });
@@ -122,28 +383,1067 @@ static void ram_init(const char *path, RamInitVariants variants)
   }
 }
 
-static bool is_host_out(uint32_t addr)
+static bool is_finished(uint32_t addr)
 {
-  static bool is_pos_edg = false;
+  // The program signals the end of its execution by writing 1 to the address given by --wr-addr
+  return (addr != 0x0) &&
+         dut->rootp
+             ->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_request &&
+         (dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__rw_address ==
+          addr) &&
+         (dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_data ==
+          0x00000001);
+}
 
+// Called once per cycle, after the rising edge. A store is accepted when the device responds in
+// the next cycle: a request held while the device waits is printed once, and back-to-back stores
+// (HARVARD = 1, write_request stays high) are all printed.
+static bool is_host_out(uint32_t addr, char &c)
+{
   bool is_write =
+      host_out_pending &&
+      dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_response;
+  c = host_out_data;
+
+  host_out_pending =
       (addr != 0x0) &&
-      (not is_pos_edg and
-       dut->rootp
-           ->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_request) &&
+      dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_request &&
       (dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__rw_address ==
        addr);
-
-  is_pos_edg =
-      dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_request;
+  host_out_data =
+      (char)dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_data;
 
   return is_write;
 }
 
+#ifdef MCU_SIM_INTROSPECTION
+static bool is_watched(const std::vector<Watchpoint> &watchpoints, uint32_t &address)
+{
+  if (!dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_request)
+  {
+    return false;
+  }
+
+  address = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__rw_address;
+  for (const Watchpoint &watchpoint : watchpoints)
+  {
+    if (address - watchpoint.address < watchpoint.length)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static HarnessState harness_state()
+{
+  HarnessState state;
+  state.cycle = clk_cur_cycles;
+  state.time = trace_time;
+  state.clock_interval = clk_interval;
+  state.host_out_pending = host_out_pending;
+  state.host_out_data = host_out_data;
+  state.stimulus_position = stimulus ? stimulus->position() : 0;
+  state.stimulus_pins = stimulus_pins;
+  return state;
+}
+
+static void take_checkpoint()
+{
+#ifndef MCU_SIM_TLM
+  VerilatedSave os;
+  os.open(checkpoints->add(harness_state()).c_str());
+  os << *dut;
+  os.close();
+#endif
+}
+
+static void apply_write(const JournalEntry &entry)
+{
+  if (entry.kind == JournalEntry::RAM)
+  {
+    dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[entry.index] =
+        entry.value;
+  }
+  else
+  {
+    dut->rootp
+        ->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__integer_file[entry.index - 1] =
+        entry.value;
+  }
+}
+
+static void replay_journal()
+{
+  for (const JournalEntry &entry : checkpoints->replay(trace_time))
+  {
+    apply_write(entry);
+  }
+}
+
+static void restore_checkpoint(const Checkpoint &checkpoint)
+{
+  // The waveform already has the steps that are replayed, they are not dumped twice
+  trace_end = std::max(trace_end, trace_time + 1);
+
+#ifndef MCU_SIM_TLM
+  VerilatedRestore os;
+  os.open(checkpoint.path.c_str());
+  os >> *dut;
+  os.close();
+#endif
+
+  clk_cur_cycles = checkpoint.state.cycle;
+  trace_time = checkpoint.state.time;
+  clk_interval = checkpoint.state.clock_interval;
+  host_out_pending = checkpoint.state.host_out_pending;
+  host_out_data = checkpoint.state.host_out_data;
+  if (stimulus)
+  {
+    stimulus->seek(checkpoint.state.stimulus_position);
+  }
+  stimulus_pins = checkpoint.state.stimulus_pins;
+
+  checkpoints->restored(checkpoint.state);
+  replay_journal();
+}
+#endif
+
+// Runs until one of the conditions holds. The conditions are checked once per clock cycle, after
+// the rising edge.
+static RunResult run(const RunCondition &condition, const std::function<void(char)> &console)
+{
+  vluint64_t end_cycle = clk_cur_cycles + condition.cycles;
+#ifdef MCU_SIM_INTROSPECTION
+  bool debug = condition.step || condition.breakpoints || condition.watchpoints;
+  uint32_t watch_address = 0;
+  int watch_hit = 0;
+#endif
+  uint32_t poll = 0;
+
+  while (true)
+  {
+    bool rising_edge = eval();
+
+#ifdef MCU_SIM_INTROSPECTION
+    if (checkpoints)
+    {
+      if (checkpoints->replay_due(trace_time))
+      {
+        replay_journal();
+      }
+
+      // Checkpoints are taken after a falling edge, so they never coincide with a stop
+      if (!rising_edge && checkpoints->due(clk_cur_cycles))
+      {
+        take_checkpoint();
+      }
+    }
+#endif
+
+    if (rising_edge)
+    {
+      // --host-out, before the stops so that the character is not lost or printed twice when the
+      // run resumes
+      char c;
+      if (is_host_out(args.host_out, c))
+      {
+        console(c);
+      }
+
+      if (condition.until_time && trace_time >= condition.until_time)
+      {
+        return {StopReason::TIME};
+      }
+
+      if (condition.cycles && clk_cur_cycles >= end_cycle)
+      {
+        return {StopReason::CYCLES};
+      }
+
+      if (is_finished(condition.wr_addr))
+      {
+        return {StopReason::WR_ADDR};
+      }
+
+#ifdef MCU_SIM_INTROSPECTION
+      if (condition.has_pc &&
+          dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__program_counter ==
+              condition.pc)
+      {
+        return {StopReason::PC};
+      }
+
+      if (debug)
+      {
+        if (!watch_hit && condition.watchpoints &&
+            is_watched(*condition.watchpoints, watch_address))
+        {
+          watch_hit = 1;
+        }
+
+        // The instruction at program_counter retires at the next rising edge. The debugger stops
+        // here, so the registers do not include its result yet.
+        if (dut->rootp
+                ->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__instruction_retired &&
+            dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__clock_enable)
+        {
+          uint32_t pc =
+              dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__program_counter;
+
+          if (condition.step)
+          {
+            return {StopReason::STEP};
+          }
+
+          // The store that hit the watchpoint retires first, the stop is before the next one
+          if (watch_hit && watch_hit++ > 1)
+          {
+            return {StopReason::WATCHPOINT, watch_address};
+          }
+
+          if (condition.breakpoints && condition.breakpoints->count(pc))
+          {
+            return {StopReason::BREAKPOINT};
+          }
+        }
+      }
+#endif
+
+      if (condition.interrupted && (++poll % 4096) == 0 && condition.interrupted())
+      {
+        return {StopReason::INTERRUPTED};
+      }
+    }
+
+  }
+}
+
+#ifdef MCU_SIM_INTROSPECTION
+// Goes to the given cycle, back through the latest checkpoint before it if needed. Console output
+// is discarded on the way.
+static bool goto_cycle(uint64_t cycle)
+{
+  if (cycle < clk_cur_cycles)
+  {
+    const Checkpoint *checkpoint = checkpoints ? checkpoints->at_cycle(cycle) : nullptr;
+    if (!checkpoint)
+    {
+      return false;
+    }
+    restore_checkpoint(*checkpoint);
+  }
+
+  if (cycle > clk_cur_cycles)
+  {
+    RunCondition condition;
+    condition.cycles = cycle - clk_cur_cycles;
+    run(condition, [](char) {});
+  }
+
+  return true;
+}
+
+// Goes back to the last stop of the condition before the current time. The checkpoints are searched
+// from the latest one: each window between two checkpoints is replayed once to find the time of its
+// last stop, then again up to that time.
+static bool reverse(const RunCondition &condition, RunResult &result)
+{
+  uint64_t window_end = trace_time;
+  const Checkpoint *latest = trace_time ? checkpoints->at_time(trace_time - 1) : nullptr;
+
+  RunCondition search = condition;
+  search.cycles = 0;
+  search.wr_addr = 0;
+  search.has_pc = false;
+  search.interrupted = nullptr;
+
+  while (latest)
+  {
+    Checkpoint checkpoint = *latest;
+    restore_checkpoint(checkpoint);
+
+    bool found = false;
+    uint64_t stop_time = 0;
+    RunResult stop;
+    search.until_time = window_end;
+
+    while (true)
+    {
+      RunResult r = run(search, [](char) {});
+      if (r.reason == StopReason::TIME)
+      {
+        break;
+      }
+      found = true;
+      stop_time = trace_time;
+      stop = r;
+    }
+
+    if (found)
+    {
+      restore_checkpoint(checkpoint);
+      RunCondition replay;
+      replay.until_time = stop_time;
+      run(replay, [](char) {});
+      result = stop;
+      return true;
+    }
+
+    window_end = checkpoint.state.time;
+    latest = window_end ? checkpoints->at_time(window_end - 1) : nullptr;
+  }
+
+  // No stop in the history: go to its beginning
+  if (checkpoints->oldest())
+  {
+    restore_checkpoint(*checkpoints->oldest());
+  }
+  result = {StopReason::TIME};
+  return false;
+}
+
+// Operations used by --serve and --gdb
+static SimControl sim_control()
+{
+  uint32_t ram_size = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__MEMORY_SIZE;
+  SimControl control;
+
+  control.load = [](const char *image, bool bin, std::string &error) {
+    // ram_init exits on errors, so a missing file is checked here
+    std::ifstream file(image);
+    if (!file.is_open())
+    {
+      error = std::string("Error file opening: ") + image;
+      return false;
+    }
+    if (checkpoints)
+    {
+      checkpoints->clear();
+    }
+    ram_init(image, bin ? RamInitVariants::BIN : RamInitVariants::H32);
+    return true;
+  };
+
+  control.reset = []() {
+    if (checkpoints)
+    {
+      checkpoints->clear();
+    }
+    reset_dut();
+  };
+
+  control.run = [](const RunCondition &condition, const std::function<void(char)> &console) {
+    return run(condition, console);
+  };
+
+  control.peek = [ram_size](uint32_t address, uint32_t &value) {
+    if (address >= ram_size || address % 4)
+    {
+      return false;
+    }
+    value = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[address / 4];
+    return true;
+  };
+
+  control.poke = [ram_size](uint32_t address, uint32_t value) {
+    if (address >= ram_size || address % 4)
+    {
+      return false;
+    }
+    JournalEntry entry{trace_time, JournalEntry::RAM, address / 4, value};
+    apply_write(entry);
+    if (checkpoints)
+    {
+      checkpoints->record(entry);
+    }
+    return true;
+  };
+
+  // The integer file is declared [31:1], so x1 is at index 0
+  control.read_register = [](uint32_t index, uint32_t &value) {
+    if (index == 0)
+      value = 0;
+    else if (index < 32)
+      value =
+          dut->rootp
+              ->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__integer_file[index - 1];
+    else
+      value = dut->rootp
+                  ->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__program_counter;
+    return true;
+  };
+
+  control.write_register = [](uint32_t index, uint32_t value) {
+    if (index == 0 || index >= 32)
+    {
+      return false;
+    }
+    JournalEntry entry{trace_time, JournalEntry::REGISTER, index, value};
+    apply_write(entry);
+    if (checkpoints)
+    {
+      checkpoints->record(entry);
+    }
+    return true;
+  };
+
+  control.cycles = []() { return (uint64_t)clk_cur_cycles; };
+
+  if (checkpoints)
+  {
+    control.goto_cycle = goto_cycle;
+    control.reverse = reverse;
+  }
+
+  return control;
+}
+
+static void open_checkpoints()
+{
+  if (!args.checkpoint_interval)
+  {
+    return;
+  }
+
+  if (!args.serve_path && !args.gdb_port)
+  {
+    Log::warning("Checkpoints are only used with --serve or --gdb, ignored");
+    return;
+  }
+
+#ifdef MCU_SIM_TLM
+  // The state of the peripheral models is not in the saved model
+  Log::error("--checkpoint-interval is not supported by mcu_sim_tlm");
+  std::exit(EXIT_FAILURE);
+#endif
+
+  checkpoints =
+      new CheckpointStore(args.checkpoint_dir, args.checkpoint_interval, args.checkpoint_max);
+  std::string error;
+  if (!checkpoints->open(error))
+  {
+    Log::error("Checkpoints: %s", error.c_str());
+    std::exit(EXIT_FAILURE);
+  }
+  Log::info("Checkpoints: every %llu cycles in %s", (unsigned long long)args.checkpoint_interval,
+            checkpoints->path().c_str());
+}
+
+static void close_checkpoints()
+{
+  // Removes the snapshot files
+  delete checkpoints;
+  checkpoints = nullptr;
+}
+
+static void serve(const char *path)
+{
+  Server server(path, sim_control());
+  std::string error;
+
+  if (!server.open(error))
+  {
+    Log::error("%s", error.c_str());
+    std::exit(EXIT_FAILURE);
+  }
+
+  Log::info("Serving on %s", path);
+  server.serve();
+  Log::info("Exit: shutdown");
+}
+
+static void gdb(uint16_t port)
+{
+  GdbStub stub(port, args.wr_addr, sim_control());
+  std::string error;
+
+  if (!stub.open(error))
+  {
+    Log::error("%s", error.c_str());
+    std::exit(EXIT_FAILURE);
+  }
+
+  Log::info("Waiting for GDB on localhost:%u", port);
+  stub.serve();
+  Log::info("Exit: debugger detached");
+}
+#endif
+
+// Runs a variant in the child forked by fork_variants
+static int run_variant(const ForkRunner &runner, const Variant &variant)
+{
+  // The file names are kept alive until the reports are written at exit
+  static std::string bus_path, cache_path, irq_path;
+
+  Log::set_out(runner.file(variant, "log"));
+  if (args.bus_profile_path)
+  {
+    bus_path = runner.file(variant, "bus");
+    args.bus_profile_path = &bus_path[0];
+  }
+  if (args.cache_sim_path)
+  {
+    cache_path = runner.file(variant, "cache");
+    args.cache_sim_path = &cache_path[0];
+  }
+  if (args.irq_profile_path)
+  {
+    irq_path = runner.file(variant, "irq");
+    args.irq_profile_path = &irq_path[0];
+  }
+
+  if (!variant.stimulus_path.empty())
+  {
+    load_stimulus(variant.stimulus_path.c_str(), clk_cur_cycles);
+  }
+
+  RunCondition condition;
+  condition.wr_addr = args.wr_addr;
+  if (variant.cycles)
+  {
+    condition.cycles = variant.cycles;
+  }
+  else if (args.max_cycles)
+  {
+    condition.cycles = args.max_cycles > clk_cur_cycles ? args.max_cycles - clk_cur_cycles : 1;
+  }
+
+  RunResult result = run(condition, [](char c) { Log::host_out(c); });
+
+  std::ofstream file(runner.file(variant, "result"));
+  file << stop_reason_name(result.reason) << " " << clk_cur_cycles << "\n";
+  return file.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Runs the prefix shared by --variants and --fault-campaign
+static void run_to_fork_point()
+{
+  if (args.fork_at > clk_cur_cycles)
+  {
+    RunCondition condition;
+    condition.cycles = args.fork_at - clk_cur_cycles;
+    condition.wr_addr = args.wr_addr;
+    if (run(condition, [](char c) { Log::host_out(c); }).reason != StopReason::CYCLES)
+    {
+      Log::error("The program finished before the fork point, cycle %llu",
+                 (unsigned long long)clk_cur_cycles);
+      std::exit(EXIT_FAILURE);
+    }
+  }
+}
+
+// Runs to the fork point once, then each variant in its own process from there
+static void fork_variants()
+{
+  ForkRunner runner(args.fork_jobs);
+  std::string error;
+
+  if (!runner.load(args.variants_path, error) || !runner.open(error))
+  {
+    Log::error("%s", error.c_str());
+    std::exit(EXIT_FAILURE);
+  }
+
+  run_to_fork_point();
+
+  Log::info("Fork at cycle %llu: %zu variants, %u jobs", (unsigned long long)clk_cur_cycles,
+            runner.size(), runner.job_count());
+  Log::flush();
+  std::cout.flush();
+
+  runner.run([&runner](const Variant &variant) { return run_variant(runner, variant); });
+
+  // The prefix alone is not reported, the reports of the variants are merged instead
+  delete bus_monitor;
+  delete cache_monitor;
+  delete irq_monitor;
+  bus_monitor = nullptr;
+  cache_monitor = nullptr;
+  irq_monitor = nullptr;
+
+  std::vector<VariantReport> reports = {{"log", "log"}};
+  if (args.bus_profile_path)
+  {
+    reports.push_back({"bus profile", "bus"});
+  }
+  if (args.cache_sim_path)
+  {
+    reports.push_back({"cache simulation", "cache"});
+  }
+  if (args.irq_profile_path)
+  {
+    reports.push_back({"interrupt profile", "irq"});
+  }
+
+  if (!args.fork_report_path)
+  {
+    runner.report(std::cout, reports);
+    return;
+  }
+
+  write_report(args.fork_report_path,
+               [&](std::ostream &out) { runner.report(out, reports); });
+}
+
+#ifdef MCU_SIM_INTROSPECTION
+// CSRs hit by --fault-campaign. mstatus and mie only implement the fields below.
+struct FaultCsrField
+{
+  FaultCsr csr;
+  std::function<void(uint32_t bit)> flip;
+};
+
+template <typename T> static void flip_bit(T &value, uint32_t bit)
+{
+  value ^= (T)(1ull << bit);
+}
+
+static std::vector<FaultCsrField> fault_csr_fields()
+{
+  auto *core = dut->rootp;
+  return {
+      {{"mstatus.mie", 1},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mstatus_mie,
+                  bit);
+       }},
+      {{"mstatus.mpie", 1},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mstatus_mpie,
+                  bit);
+       }},
+      {{"mie.meie", 1},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mie_meie, bit);
+       }},
+      {{"mie.mtie", 1},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mie_mtie, bit);
+       }},
+      {{"mie.msie", 1},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mie_msie, bit);
+       }},
+      {{"mie.mfie", 16},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mie_mfie, bit);
+       }},
+      {{"mepc", 32},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mepc, bit);
+       }},
+      {{"mtvec", 32},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mtvec, bit);
+       }},
+      {{"mscratch", 32},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mscratch,
+                  bit);
+       }},
+      {{"mtval", 32},
+       [core](uint32_t bit) {
+         flip_bit(core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mtval, bit);
+       }},
+  };
+}
+
+static void inject_fault(const Fault &fault, const std::vector<FaultCsrField> &csrs)
+{
+  switch (fault.target)
+  {
+  case FaultTarget::RAM:
+    flip_bit(
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[fault.index / 4],
+        fault.bit);
+    break;
+
+  case FaultTarget::REGISTER:
+    flip_bit(dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__integer_file
+                 [fault.index - 1],
+             fault.bit);
+    break;
+
+  case FaultTarget::CSR:
+    csrs[fault.index].flip(fault.bit);
+    break;
+  }
+}
+
+// Runs until --wr-addr or the end cycle and records what the firmware did
+static void run_fault(uint64_t end_cycle, FaultRun &result)
+{
+  RunCondition condition;
+  condition.wr_addr = args.wr_addr;
+  condition.cycles = end_cycle > clk_cur_cycles ? end_cycle - clk_cur_cycles : 1;
+
+  RunResult stop = run(condition, [&result](char c) { result.console += c; });
+
+  result.finished = stop.reason == StopReason::WR_ADDR;
+  result.end_cycle = clk_cur_cycles;
+  result.exceptions = fault_exceptions;
+  for (uint32_t address = args.fault_signature_start; address < args.fault_signature_end;
+       address += 4)
+  {
+    result.signature.push_back(
+        dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[address / 4]);
+  }
+}
+
+// Runs to the fork point once, makes the golden run from there, then each fault in its own process
+static void run_fault_campaign()
+{
+  std::vector<FaultCsrField> csrs = fault_csr_fields();
+  std::vector<FaultCsr> csr_names;
+  for (const FaultCsrField &field : csrs)
+  {
+    csr_names.push_back(field.csr);
+  }
+
+  FaultCampaign campaign(csr_names);
+  std::string error;
+  uint32_t ram_size = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__MEMORY_SIZE;
+
+  if ((args.fault_targets && !campaign.set_targets(args.fault_targets, error)) ||
+      (args.fault_list_path && !campaign.load(args.fault_list_path, error)))
+  {
+    Log::error("%s", error.c_str());
+    std::exit(EXIT_FAILURE);
+  }
+
+  if (args.fault_signature_end > ram_size || args.fault_ram_end > ram_size)
+  {
+    Log::error("Fault ranges must be within the RAM (%u bytes)", ram_size);
+    std::exit(EXIT_FAILURE);
+  }
+
+  // The monitors would report the prefix only
+  delete bus_monitor;
+  delete cache_monitor;
+  delete irq_monitor;
+  bus_monitor = nullptr;
+  cache_monitor = nullptr;
+  irq_monitor = nullptr;
+
+  run_to_fork_point();
+  fault_campaign = &campaign;
+  fault_exceptions = 0;
+
+  char golden_path[] = "/tmp/mcu_sim_golden_XXXXXX";
+  int fd = mkstemp(golden_path);
+  if (fd < 0)
+  {
+    Log::error("mkstemp: %s", strerror(errno));
+    std::exit(EXIT_FAILURE);
+  }
+  close(fd);
+
+  // The golden run is made in a child so the warm state is kept for the faults
+  uint64_t fork_cycle = clk_cur_cycles;
+  uint64_t max_cycles = args.max_cycles > fork_cycle ? args.max_cycles : UINT64_MAX;
+  FaultRun golden;
+  Log::flush();
+  std::cout.flush();
+  fork_parallel(
+      1, 1,
+      [&](size_t) {
+        FaultRun result;
+        run_fault(max_cycles, result);
+        return result.save(golden_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+      },
+      [](size_t, int, bool, double) {});
+  bool loaded = golden.load(golden_path);
+  std::remove(golden_path);
+
+  if (!loaded || !golden.finished)
+  {
+    Log::error("The golden run did not finish (--wr-addr) within --cycles");
+    std::exit(EXIT_FAILURE);
+  }
+
+  // A fault that makes the program take twice as long as the golden run is a hang
+  uint64_t end_cycle = golden.end_cycle + (golden.end_cycle - fork_cycle) + 1000;
+
+  if (args.fault_count)
+  {
+    FaultSpace space;
+    space.first_cycle = fork_cycle;
+    space.last_cycle = golden.end_cycle;
+    space.ram_start = args.fault_ram_end ? args.fault_ram_start : 0;
+    space.ram_end = args.fault_ram_end ? args.fault_ram_end : ram_size;
+    campaign.generate(args.fault_count, args.fault_seed, space);
+  }
+
+  unsigned jobs = args.fork_jobs ? args.fork_jobs : online_cores();
+  size_t count = campaign.faults().size();
+  size_t done = 0;
+  Log::info("Golden run: cycles %llu to %llu, %zu console bytes", (unsigned long long)fork_cycle,
+            (unsigned long long)golden.end_cycle, golden.console.size());
+  Log::info("Injecting %zu faults, %u jobs", count, jobs);
+  Log::flush();
+  std::cout.flush();
+
+  fork_parallel(
+      count, jobs,
+      [&](size_t index) {
+        const Fault &fault = campaign.faults()[index];
+        FaultRun result;
+
+        if (fault.cycle > clk_cur_cycles)
+        {
+          run_fault(fault.cycle, result);
+          result.signature.clear();
+          if (result.finished)
+          {
+            // The fault comes after the end of the program
+            return (int)FaultOutcome::MASKED;
+          }
+        }
+
+        inject_fault(fault, csrs);
+        run_fault(end_cycle, result);
+        return (int)FaultCampaign::classify(golden, result);
+      },
+      [&](size_t index, int status, bool signaled, double) {
+        bool valid = !signaled && status >= 0 && status <= (int)FaultOutcome::HANG;
+        campaign.set_outcome(index, valid ? (FaultOutcome)status : FaultOutcome::ERROR);
+        if (++done % 100 == 0)
+        {
+          Log::info("%zu/%zu faults", done, count);
+        }
+      });
+
+  fault_campaign = nullptr;
+
+  if (!args.fault_report_path)
+  {
+    campaign.report(std::cout);
+    return;
+  }
+
+  write_report(args.fault_report_path, [&](std::ostream &out) { campaign.report(out); });
+}
+#endif
+
+// Runs the MCUs of the --system topology instead of the single one of dut
+static void run_system()
+{
+  SystemTopology topology;
+  std::string error;
+
+  if (!topology.load(args.system_path, args.host_out, args.wr_addr, error))
+  {
+    Log::error("%s", error.c_str());
+    std::exit(EXIT_FAILURE);
+  }
+
+  SystemSim system(topology, args.quantum);
+  if (!system.open(error))
+  {
+    Log::error("%s", error.c_str());
+    std::exit(EXIT_FAILURE);
+  }
+
+  system.run(args.max_cycles);
+}
+
+#ifdef MCU_SIM_INTROSPECTION
+// Copies the architectural state of the functional model into the RTL model. The core is reset,
+// then put in STATE_TRAP_RETURN with mepc on the next instruction, so the next rising edge fetches
+// it like an mret would, with an empty pipeline.
+static void inject_state(const Iss &iss)
+{
+  const IssState &state = iss.state;
+  auto *root = dut->rootp;
+
+  reset_dut();
+
+  // The core leaves the reset at the next rising edge
+  while (!eval())
+  {
+  }
+  while (dut->clock)
+  {
+    eval();
+  }
+
+  for (size_t i = 0; i < iss.ram.size(); i++)
+  {
+    root->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[i] = iss.ram[i];
+  }
+  for (size_t i = 1; i < 32; i++)
+  {
+    root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__integer_file[i - 1] =
+        state.x[i];
+  }
+
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mie_meie = state.mie_meie;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mie_mtie = state.mie_mtie;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mie_msie = state.mie_msie;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mie_mfie = state.mie_mfie;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mtvec = state.mtvec;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mscratch = state.mscratch;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mtval = state.mtval;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mcause = state.mcause;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mcause_code =
+      state.mcause_code;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mcause_interrupt_flag =
+      state.mcause_interrupt;
+
+#ifdef MCU_SIM_TLM
+  // The models are called again at the next edge, whatever they asked for
+  std::string scope = std::string(dut->name()) + ".mcu_sim.rvx_instance.";
+  static_cast<TlmTimer *>(tlm_find(scope + "rvx_mtimer_instance"))
+      ->load(state.timer_enable, state.mtime, state.mtimecmp);
+  static_cast<TlmGpio *>(tlm_find(scope + "rvx_gpio_instance"))
+      ->load(state.gpio_oe, state.gpio_out);
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_mtimer_instance__DOT__next_event = 0;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_gpio_instance__DOT__next_event = 0;
+#else
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_mtimer_instance__DOT__cr_en = state.timer_enable;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_mtimer_instance__DOT__mtime = state.mtime;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_mtimer_instance__DOT__mtimecmp = state.mtimecmp;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_gpio_instance__DOT__oe = state.gpio_oe;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_gpio_instance__DOT__out = state.gpio_out;
+#endif
+
+  // The trap return sets mstatus.mie from mstatus.mpie, mie is kept clear so no interrupt is
+  // taken on the way
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mepc = state.pc;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mstatus_mie = 0;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mstatus_mpie =
+      state.mstatus_mie;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__current_state =
+      STATE_TRAP_RETURN;
+  dut->eval();
+
+  while (!eval())
+  {
+  }
+  while (dut->clock)
+  {
+    eval();
+  }
+
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mepc = state.mepc;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mstatus_mpie =
+      state.mstatus_mpie;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_mcycle = state.mcycle;
+  root->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__csr_minstret = state.minstret;
+  dut->eval();
+}
+
+// Runs warmup + window instructions on the RTL model and counts the cycles of the window. Returns
+// false if they do not retire in time, or the program ends on the way.
+static bool measure_window(uint64_t warmup, uint64_t window, uint64_t &cycles)
+{
+  auto *core = dut->rootp;
+  uint64_t retired = 0;
+  uint64_t start = clk_cur_cycles;
+  uint64_t limit = clk_cur_cycles + 100 * (warmup + window);
+
+  while (retired < warmup + window)
+  {
+    if (!eval())
+    {
+      continue;
+    }
+    if (clk_cur_cycles >= limit || is_finished(args.wr_addr))
+    {
+      return false;
+    }
+
+    // The instruction at program_counter retires at the next rising edge
+    if (core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__instruction_retired &&
+        core->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__clock_enable &&
+        ++retired == warmup)
+    {
+      start = clk_cur_cycles;
+    }
+  }
+
+  cycles = clk_cur_cycles - start;
+  return true;
+}
+
+// Fast-forwards the program on the functional model and, once every --sample-interval
+// instructions, measures a window on the RTL model. --cycles limits the instructions.
+static void run_sampled()
+{
+  uint64_t warmup = args.sample_warmup;
+  uint64_t window = args.sample_window;
+  uint64_t fast_forward = args.sample_interval - warmup - window;
+  uint64_t limit = args.max_cycles ? args.max_cycles : std::numeric_limits<uint64_t>::max();
+
+  Iss iss(dut->rootp->mcu_sim__DOT__rvx_instance__DOT__MEMORY_SIZE,
+          dut->rootp->mcu_sim__DOT__rvx_instance__DOT__GPIO_WIDTH);
+  for (size_t i = 0; i < iss.ram.size(); i++)
+  {
+    iss.ram[i] = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[i];
+  }
+  iss.m_extension = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__M_EXTENSION != 0;
+  iss.c_extension = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__C_EXTENSION != 0;
+  iss.zba_zbb = dut->rootp->mcu_sim__DOT__rvx_instance__DOT__ZBA_ZBB_EXTENSION != 0;
+  iss.host_out = args.host_out;
+  iss.wr_addr = args.wr_addr;
+  iss.console = [](char c) { Log::host_out(c); };
+  iss.gpio_input = stimulus_pins.gpio_input;
+
+  SampleStats stats(args.sample_interval, warmup, window);
+
+  while (!iss.finished() && iss.instructions() < limit)
+  {
+    // No room for another window before the limit
+    if (limit - iss.instructions() < args.sample_interval)
+    {
+      iss.run(limit - iss.instructions());
+      break;
+    }
+
+    iss.run(fast_forward);
+    if (iss.finished())
+    {
+      break;
+    }
+
+    inject_state(iss);
+    uint64_t cycles;
+    if (measure_window(warmup, window, cycles))
+    {
+      stats.add({iss.instructions() + warmup, window, cycles});
+      // The timer of the functional model follows the CPI measured so far
+      iss.cpi = stats.mean_cpi();
+    }
+    else
+    {
+      Log::warning("Window at instruction %llu dropped, it did not complete",
+                   (unsigned long long)iss.instructions());
+    }
+
+    iss.run(warmup + window);
+  }
+
+  Log::info("Exit: %s after %llu instructions, %zu windows",
+            iss.finished() ? "wr-addr" : "end cycles", (unsigned long long)iss.instructions(),
+            stats.size());
+
+  if (!args.sample_report_path)
+  {
+    stats.report(std::cout, iss.instructions());
+    return;
+  }
+
+  write_report(args.sample_report_path,
+               [&](std::ostream &out) { stats.report(out, iss.instructions()); });
+}
+#endif
+
 int main(int argc, char *argv[])
 {
   signal(SIGINT, exit_app);
   signal(SIGKILL, exit_app);
+  std::atexit(final_dut);
 
   // Default log level
   Log::set_level(Log::DEBUG);
@@ -151,36 +1451,142 @@ int main(int argc, char *argv[])
 
   set_clock_frequency(dut, args.freq);
 
+#ifndef MCU_SIM_INTROSPECTION
+  // The internal signals they use are only public in the builds with INTROSPECTION=ON
+  if (args.bus_profile_path || args.cache_sim_path || args.mem_trace_path ||
+      args.irq_profile_path || args.serve_path || args.gdb_port || args.checkpoint_interval ||
+      args.goto_cycle || args.fault_count || args.fault_list_path || args.sample_interval)
+  {
+    Log::error("--bus-profile, --cache-sim, --mem-trace, --irq-profile, --serve, --gdb, "
+               "--checkpoint-interval, --goto-cycle, --fault-campaign, --fault-list and "
+               "--sample-interval need a build with INTROSPECTION=ON (make build)");
+    std::exit(EXIT_FAILURE);
+  }
+#endif
+
+  // The children of --variants and --fault-campaign would write to the same files
+  if ((args.variants_path || args.fault_count || args.fault_list_path) &&
+      (args.out_wave_path || args.mem_trace_path))
+  {
+    Log::error("--out-wave and --mem-trace cannot be used with --variants or --fault-campaign");
+    std::exit(EXIT_FAILURE);
+  }
+
+  // --sample-interval
+  if (args.sample_interval &&
+      (args.stimulus_path || args.serve_path || args.gdb_port || args.variants_path ||
+       args.fault_count || args.fault_list_path || args.system_path))
+  {
+    Log::error("--sample-interval cannot be used with --stimulus, --serve, --gdb, --variants, "
+               "--fault-campaign or --system");
+    std::exit(EXIT_FAILURE);
+  }
+
+  // --system
+  if (args.system_path)
+  {
+    if (args.out_wave_path || args.serve_path || args.gdb_port)
+    {
+      Log::error("--out-wave, --serve and --gdb cannot be used with --system");
+      std::exit(EXIT_FAILURE);
+    }
+    run_system();
+    return EXIT_SUCCESS;
+  }
+
   if (args.out_wave_path)
   {
     open_trace(args.out_wave_path);
   }
 
+  open_monitors();
+
+  open_stimulus();
+
+#ifdef MCU_SIM_INTROSPECTION
+  open_checkpoints();
+  std::atexit(close_checkpoints);
+#endif
+
   reset_dut();
 
   ram_init(args.ram_init_path, args.ram_init_variants);
 
-  while (true)
+#ifdef MCU_SIM_INTROSPECTION
+  // --goto-cycle
+  if (args.goto_cycle && (args.serve_path || args.gdb_port))
   {
-    eval();
+    goto_cycle(args.goto_cycle);
+    Log::info("Session starts at cycle %llu", (unsigned long long)clk_cur_cycles);
+  }
+  else if (args.goto_cycle)
+  {
+    Log::warning("--goto-cycle is only used with --serve or --gdb, ignored");
+  }
 
-    // --cycles
-    if (args.max_cycles)
-    {
-      if (clk_cur_cycles >= args.max_cycles)
-      {
-        Log::info("Exit: end cycles");
-        close_trace();
-        std::exit(EXIT_SUCCESS);
-      }
-    }
+  // --serve
+  if (args.serve_path)
+  {
+    serve(args.serve_path);
+    close_trace();
+    return EXIT_SUCCESS;
+  }
 
-    // --host-out
-    if (is_host_out(args.host_out))
-    {
-      Log::host_out(
-          (char)dut->rootp
-              ->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_data);
-    }
+  // --gdb
+  if (args.gdb_port)
+  {
+    gdb(args.gdb_port);
+    close_trace();
+    return EXIT_SUCCESS;
+  }
+
+  // --fault-campaign, --fault-list
+  if (args.fault_count || args.fault_list_path)
+  {
+    run_fault_campaign();
+    return EXIT_SUCCESS;
   }
+#endif
+
+  // --fork-at, --variants
+  if (args.variants_path)
+  {
+    fork_variants();
+    return EXIT_SUCCESS;
+  }
+
+#ifdef MCU_SIM_INTROSPECTION
+  // --sample-interval
+  if (args.sample_interval)
+  {
+    run_sampled();
+    close_trace();
+    return EXIT_SUCCESS;
+  }
+#endif
+
+  // --cycles counts from the start of the simulation, reset included
+  RunCondition condition;
+  condition.wr_addr = args.wr_addr;
+  if (args.max_cycles)
+  {
+    condition.cycles = args.max_cycles > clk_cur_cycles ? args.max_cycles - clk_cur_cycles : 1;
+  }
+
+  switch (run(condition, [](char c) { Log::host_out(c); }).reason)
+  {
+  case StopReason::CYCLES:
+    Log::info("Exit: end cycles");
+    break;
+
+  case StopReason::WR_ADDR:
+    Log::info("Exit: wr-addr");
+    break;
+
+  default:
+    break;
+  }
+
+  close_trace();
+  return EXIT_SUCCESS;
 }
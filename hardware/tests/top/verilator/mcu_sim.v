@@ -6,7 +6,16 @@ module mcu_sim #(
     // Number of available I/O ports
     parameter GPIO_WIDTH    = 2,
     // Number of CS (Chip Select) pins for the SPI controller
-    parameter SPI_NUM_CHIP_SELECT  = 1
+    parameter SPI_NUM_CHIP_SELECT  = 1,
+    // Optional extensions of the core (set with -GM_EXTENSION=1, -GC_EXTENSION=1 and
+    // -GZBA_ZBB_EXTENSION=1, see CMakeLists.txt)
+    parameter M_EXTENSION   = 0,
+    parameter C_EXTENSION   = 0,
+    parameter ZBA_ZBB_EXTENSION = 0,
+    // Separate instruction and data ports (set with -GHARVARD=1)
+    parameter HARVARD       = 0,
+    // Jump targets kept by the core (set with -GBRANCH_TARGET_BUFFER=<n>, needs C_EXTENSION = 1)
+    parameter BRANCH_TARGET_BUFFER = 0
 
   ) (
 
@@ -24,14 +33,24 @@ module mcu_sim #(
     output  wire  [SPI_NUM_CHIP_SELECT-1:0] cs
   );
 
+`ifdef RVX_TLM
+  // mcu_sim_tlm build: peripherals modeled in C++
+  rvx_tlm #(
+`else
   rvx #(
+`endif
 
     .CLOCK_FREQUENCY          (50000000           ),
     .UART_BAUD_RATE           (9600               ),
     .MEMORY_SIZE              (32768              ),
     .MEMORY_INIT_FILE         (""                 ),
     .BOOT_ADDRESS             (32'h00000000       ),
-    .GPIO_WIDTH               (GPIO_WIDTH         )
+    .GPIO_WIDTH               (GPIO_WIDTH         ),
+    .M_EXTENSION              (M_EXTENSION        ),
+    .C_EXTENSION              (C_EXTENSION        ),
+    .ZBA_ZBB_EXTENSION        (ZBA_ZBB_EXTENSION  ),
+    .HARVARD                  (HARVARD            ),
+    .BRANCH_TARGET_BUFFER     (BRANCH_TARGET_BUFFER)
 
   ) rvx_instance (
 
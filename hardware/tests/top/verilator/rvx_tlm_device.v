@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+// Bus shell of a peripheral modeled in C++ (tlm_peripherals.cpp). The model is only called at the
+// rising edges with a bus access, an interrupt response or a change of device_input, and at the
+// edge it asked for the last time it was called. It catches up with the other edges by itself.
+
+`begin_keywords "1800-2017"
+
+module rvx_tlm_device #(
+
+  // Model (TlmDeviceKind in tlm_peripherals.h): 1 UART, 2 MTIMER, 3 GPIO, 4 SPI
+  parameter DEVICE        = 1,
+  // Bit period in cycles with 8 fractional bits (UART), GPIO_WIDTH (GPIO) or SPI_NUM_CHIP_SELECT
+  // (SPI)
+  parameter CONFIG        = 0,
+  // RX_FIFO_DEPTH | TX_FIFO_DEPTH << 8 (UART)
+  parameter CONFIG_EXTRA  = 0,
+  parameter INPUT_WIDTH   = 1,
+  parameter OUTPUT_WIDTH  = 1,
+  // As in rvx_uart: a request still high after its response is the same access repeated, the
+  // model does not see it and read_data keeps its value
+  parameter REPEATED_REQUESTS = 0
+
+  ) (
+
+  // Global signals
+
+  input   wire                      clock           ,
+  input   wire                      reset           ,
+
+  // IO interface
+
+  input   wire  [4:0 ]              rw_address      ,
+  output  reg   [31:0]              read_data       ,
+  input   wire                      read_request    ,
+  output  reg                       read_response   ,
+  input   wire  [31:0]              write_data      ,
+  input   wire  [3:0 ]              write_strobe    ,
+  input   wire                      write_request   ,
+  output  reg                       write_response  ,
+
+  // Device pins
+
+  input   wire  [INPUT_WIDTH-1:0]   device_input    ,
+  output  wire  [OUTPUT_WIDTH-1:0]  device_output   ,
+
+  // Interrupt signaling
+
+  output  reg                       irq             ,
+  input   wire                      irq_response
+
+  );
+
+  import "DPI-C" context function chandle rvx_tlm_open(
+    input int device,
+    input int config,
+    input int config_extra
+  );
+
+  import "DPI-C" function void rvx_tlm_reset(
+    input   chandle           model,
+    input   longint unsigned  cycle,
+    output  int unsigned      outputs
+  );
+
+  import "DPI-C" function longint unsigned rvx_tlm_edge(
+    input   chandle           model,
+    input   longint unsigned  cycle,
+    input   bit               read,
+    input   bit               write,
+    input   int unsigned      address,
+    input   int unsigned      data,
+    input   int unsigned      strobe,
+    input   int unsigned      device_input,
+    input   bit               irq_response,
+    output  int unsigned      read_data,
+    output  int unsigned      outputs,
+    output  bit               irq
+  );
+
+  chandle           model;
+  longint unsigned  cycle = 0;
+  // Cycle of the next edge the model has to see, written by the harness after it loads a model
+  longint unsigned  next_event = 0;
+
+  reg   [INPUT_WIDTH-1:0]   last_input = {INPUT_WIDTH{1'b0}};
+  reg   [31:0]              outputs = 32'b0;
+
+  // Written by the DPI calls
+  int unsigned              model_read_data;
+  int unsigned              model_outputs;
+  bit                       model_irq;
+
+  wire                      read_access;
+  wire                      write_access;
+
+  assign device_output = outputs[OUTPUT_WIDTH-1:0];
+
+  initial model = rvx_tlm_open(DEVICE, CONFIG, CONFIG_EXTRA);
+
+  assign read_access  = read_request && !(REPEATED_REQUESTS != 0 && read_response);
+  assign write_access = write_request && !(REPEATED_REQUESTS != 0 && write_response);
+
+  always @(posedge clock) begin
+    cycle <= cycle + 1;
+    last_input <= device_input;
+    if (reset) begin
+      rvx_tlm_reset(model, cycle, model_outputs);
+      outputs <= model_outputs;
+      read_response <= 1'b0;
+      write_response <= 1'b0;
+      irq <= 1'b0;
+      next_event <= 0;
+    end
+    else begin
+      read_response <= read_request;
+      write_response <= write_request;
+      if (read_request || write_request || irq_response || device_input != last_input ||
+          cycle >= next_event) begin
+        next_event <= rvx_tlm_edge(model, cycle, read_access, write_access,
+                                   {27'b0, rw_address}, write_data, {28'b0, write_strobe},
+                                   {{32-INPUT_WIDTH{1'b0}}, device_input}, irq_response,
+                                   model_read_data, model_outputs, model_irq);
+        if (read_access)
+          read_data <= model_read_data;
+        outputs <= model_outputs;
+        irq <= model_irq;
+      end
+    end
+  end
+
+endmodule
+
+`end_keywords
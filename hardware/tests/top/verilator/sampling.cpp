@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "sampling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Two-sided 95% quantiles of Student's t distribution, by degrees of freedom
+static const double t_95[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                              2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                              2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                              2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+
+// Relative error targeted by the number of windows suggested in the report
+static constexpr double TARGET_ERROR = 0.03;
+
+static double cpi(const SampleWindow &window)
+{
+  return (double)window.cycles / window.instructions;
+}
+
+SampleStats::SampleStats(uint64_t interval, uint64_t warmup, uint64_t window)
+    : interval(interval), warmup(warmup), window(window)
+{
+}
+
+void SampleStats::add(const SampleWindow &window)
+{
+  windows.push_back(window);
+}
+
+double SampleStats::mean_cpi() const
+{
+  double sum = 0;
+  for (const SampleWindow &w : windows)
+  {
+    sum += cpi(w);
+  }
+  return windows.empty() ? 0 : sum / windows.size();
+}
+
+double SampleStats::cpi_deviation() const
+{
+  if (windows.size() < 2)
+  {
+    return 0;
+  }
+
+  double mean = mean_cpi();
+  double sum = 0;
+  for (const SampleWindow &w : windows)
+  {
+    sum += (cpi(w) - mean) * (cpi(w) - mean);
+  }
+  return std::sqrt(sum / (windows.size() - 1));
+}
+
+double SampleStats::cpi_margin() const
+{
+  size_t n = windows.size();
+  if (n < 2)
+  {
+    return 0;
+  }
+
+  double t = n - 1 <= sizeof(t_95) / sizeof(t_95[0]) ? t_95[n - 2] : 1.96;
+  return t * cpi_deviation() / std::sqrt((double)n);
+}
+
+void SampleStats::report(std::ostream &out, uint64_t total_instructions) const
+{
+  char line[160];
+  double mean = mean_cpi();
+  double margin = cpi_margin();
+
+  std::snprintf(line, sizeof(line),
+                "Sampled simulation: %zu windows of %llu instructions (%llu of warm-up), one every "
+                "%llu instructions\n",
+                windows.size(), (unsigned long long)window, (unsigned long long)warmup,
+                (unsigned long long)interval);
+  out << line;
+  std::snprintf(line, sizeof(line), "Instructions: %llu\n\n",
+                (unsigned long long)total_instructions);
+  out << line;
+
+  if (windows.empty())
+  {
+    out << "No window was measured, the program is shorter than the first one\n";
+    return;
+  }
+
+  std::snprintf(line, sizeof(line),
+                "CPI:              %.4f, 95%% interval [%.4f, %.4f] (+/- %.2f%%)\n", mean,
+                mean - margin, mean + margin, mean ? 100 * margin / mean : 0);
+  out << line;
+  std::snprintf(line, sizeof(line), "Estimated cycles: %.0f, 95%% interval [%.0f, %.0f]\n",
+                mean * total_instructions, (mean - margin) * total_instructions,
+                (mean + margin) * total_instructions);
+  out << line;
+
+  // Number of windows that brings the interval to the target error, given the spread measured so
+  // far: n = (z * coefficient of variation / error)^2
+  if (windows.size() < 2)
+  {
+    out << "The confidence interval needs at least two windows\n";
+  }
+  else
+  {
+    double variation = mean ? cpi_deviation() / mean : 0;
+    double needed = std::ceil(std::pow(1.96 * variation / TARGET_ERROR, 2));
+    std::snprintf(line, sizeof(line),
+                  "Coefficient of variation: %.4f, windows for +/- %.0f%%: %.0f\n", variation,
+                  100 * TARGET_ERROR, std::max(needed, 2.0));
+    out << line;
+  }
+
+  std::snprintf(line, sizeof(line), "\n%-8s %20s %12s %8s\n", "Window", "Start instruction",
+                "Cycles", "CPI");
+  out << line;
+  for (size_t i = 0; i < windows.size(); i++)
+  {
+    std::snprintf(line, sizeof(line), "%-8zu %20llu %12llu %8.4f\n", i,
+                  (unsigned long long)windows[i].start, (unsigned long long)windows[i].cycles,
+                  cpi(windows[i]));
+    out << line;
+  }
+}
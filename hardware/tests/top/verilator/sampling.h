@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Measurement window of a sampled simulation, simulated cycle by cycle on the RTL model
+struct SampleWindow
+{
+  // Instructions executed by the program before the window (warm-up included)
+  uint64_t start;
+  uint64_t instructions;
+  uint64_t cycles;
+};
+
+// CPI measured in the windows and extrapolated to the whole program. Every window has the same
+// number of instructions, so the mean of their CPIs is the CPI of the sample and its confidence
+// interval comes from the spread between the windows (Student's t, 95%).
+class SampleStats
+{
+public:
+  SampleStats(uint64_t interval, uint64_t warmup, uint64_t window);
+
+  void add(const SampleWindow &window);
+
+  size_t size() const
+  {
+    return windows.size();
+  }
+
+  double mean_cpi() const;
+
+  // Half width of the 95% confidence interval of the mean CPI, 0 with less than two windows
+  double cpi_margin() const;
+
+  void report(std::ostream &out, uint64_t total_instructions) const;
+
+private:
+  uint64_t interval;
+  uint64_t warmup;
+  uint64_t window;
+  std::vector<SampleWindow> windows;
+
+  double cpi_deviation() const;
+};
+
+#endif // SAMPLING_H
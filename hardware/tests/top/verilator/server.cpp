@@ -0,0 +1,361 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "server.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+Server::Server(const char *path, SimControl control) : path(path), control(std::move(control))
+{
+}
+
+Server::~Server()
+{
+  if (listen_fd >= 0)
+  {
+    close(listen_fd);
+    unlink(path.c_str());
+  }
+}
+
+bool Server::open(std::string &error)
+{
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+
+  if (path.size() >= sizeof(address.sun_path))
+  {
+    error = "Socket path too long: " + path;
+    return false;
+  }
+  std::strcpy(address.sun_path, path.c_str());
+
+  listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0)
+  {
+    error = std::string("socket: ") + std::strerror(errno);
+    return false;
+  }
+
+  // A client that disconnects during a run must not terminate the simulator
+  signal(SIGPIPE, SIG_IGN);
+
+  // A socket file left by a previous run would make bind fail
+  unlink(path.c_str());
+
+  if (bind(listen_fd, (sockaddr *)&address, sizeof(address)) < 0 || listen(listen_fd, 1) < 0)
+  {
+    error = path + ": " + std::strerror(errno);
+    close(listen_fd);
+    listen_fd = -1;
+    return false;
+  }
+
+  return true;
+}
+
+void Server::serve()
+{
+  while (!shutdown)
+  {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return;
+    }
+    session(fd);
+  }
+}
+
+void Server::session(int fd)
+{
+  FILE *in = fdopen(fd, "r");
+  out = fdopen(dup(fd), "w");
+
+  if (!in || !out)
+  {
+    if (in)
+      fclose(in);
+    else
+      close(fd);
+    if (out)
+      fclose(out);
+    out = nullptr;
+    return;
+  }
+
+  char *line = nullptr;
+  size_t capacity = 0;
+
+  while (getline(&line, &capacity, in) > 0)
+  {
+    std::istringstream ss(line);
+    std::vector<std::string> tokens;
+    std::string token;
+
+    while (ss >> token)
+    {
+      tokens.push_back(token);
+    }
+
+    if (tokens.empty())
+    {
+      continue;
+    }
+
+    if (!command(tokens) || shutdown)
+    {
+      break;
+    }
+  }
+
+  std::free(line);
+  fclose(in);
+  fclose(out);
+  out = nullptr;
+}
+
+void Server::reply(const char *format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  std::vfprintf(out, format, va);
+  va_end(va);
+  std::fputc('\n', out);
+  std::fflush(out);
+}
+
+void Server::console(const std::string &text)
+{
+  std::string line = "out ";
+  char hex[3];
+
+  for (unsigned char c : text)
+  {
+    std::snprintf(hex, sizeof(hex), "%02x", c);
+    line += hex;
+  }
+  reply("%s", line.c_str());
+}
+
+static bool parse_u64(const std::string &text, uint64_t &value)
+{
+  char *end;
+  value = std::strtoull(text.c_str(), &end, 0);
+  return !text.empty() && *end == '\0';
+}
+
+static bool parse_u32(const std::string &text, uint32_t &value)
+{
+  uint64_t number;
+  bool valid = parse_u64(text, number) && number <= 0xffffffffull;
+  value = (uint32_t)number;
+  return valid;
+}
+
+static bool parse_register(const std::string &text, uint32_t &index)
+{
+  if (text == "pc")
+  {
+    index = 32;
+    return true;
+  }
+  return text.size() > 1 && text[0] == 'x' && parse_u32(text.substr(1), index) && index < 32;
+}
+
+static bool parse_run(const std::vector<std::string> &tokens, RunCondition &condition)
+{
+  if (tokens.size() < 2 || !parse_u64(tokens[1], condition.cycles))
+  {
+    return false;
+  }
+
+  for (size_t i = 2; i < tokens.size(); i++)
+  {
+    const std::string &token = tokens[i];
+
+    if (token.compare(0, 8, "wr-addr=") == 0)
+    {
+      if (!parse_u32(token.substr(8), condition.wr_addr))
+        return false;
+    }
+    else if (token.compare(0, 3, "pc=") == 0)
+    {
+      if (!parse_u32(token.substr(3), condition.pc))
+        return false;
+      condition.has_pc = true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Returns false when the connection has to be closed
+bool Server::command(const std::vector<std::string> &tokens)
+{
+  const std::string &name = tokens[0];
+
+  if (name == "load")
+  {
+    std::string error;
+    if (tokens.size() != 3 || (tokens[1] != "bin" && tokens[1] != "h32"))
+      reply("error usage: load <bin|h32> <path>");
+    else if (!control.load(tokens[2].c_str(), tokens[1] == "bin", error))
+      reply("error %s", error.c_str());
+    else
+      reply("ok");
+  }
+  else if (name == "reset")
+  {
+    control.reset();
+    reply("ok");
+  }
+  else if (name == "run")
+  {
+    RunCondition condition;
+    if (!parse_run(tokens, condition))
+    {
+      reply("error usage: run <cycles> [wr-addr=<address>] [pc=<address>]");
+      return true;
+    }
+
+    // Console output is sent line by line, or in chunks for long lines
+    std::string text;
+    uint64_t start = control.cycles();
+    RunResult result = control.run(condition, [this, &text](char c) {
+      text += c;
+      if (c == '\n' || text.size() >= 256)
+      {
+        console(text);
+        text.clear();
+      }
+    });
+    if (!text.empty())
+    {
+      console(text);
+    }
+
+    reply("ok %llu %s", (unsigned long long)(control.cycles() - start),
+          stop_reason_name(result.reason));
+  }
+  else if (name == "peek")
+  {
+    uint32_t address;
+    uint32_t count = 1;
+    uint32_t value;
+
+    if ((tokens.size() != 2 && tokens.size() != 3) || !parse_u32(tokens[1], address) ||
+        (tokens.size() == 3 && !parse_u32(tokens[2], count)))
+    {
+      reply("error usage: peek <address> [<count>]");
+      return true;
+    }
+
+    std::string values = "ok";
+    char word[12];
+    for (uint32_t i = 0; i < count; i++)
+    {
+      if (!control.peek(address + i * 4, value))
+      {
+        reply("error invalid address: 0x%08x", address + i * 4);
+        return true;
+      }
+      std::snprintf(word, sizeof(word), " %08x", value);
+      values += word;
+    }
+    reply("%s", values.c_str());
+  }
+  else if (name == "poke")
+  {
+    uint32_t address;
+    uint32_t value;
+
+    if (tokens.size() < 3 || !parse_u32(tokens[1], address))
+    {
+      reply("error usage: poke <address> <value>...");
+      return true;
+    }
+
+    for (size_t i = 2; i < tokens.size(); i++)
+    {
+      uint32_t word_address = address + (i - 2) * 4;
+      if (!parse_u32(tokens[i], value))
+      {
+        reply("error invalid value: %s", tokens[i].c_str());
+        return true;
+      }
+      if (!control.poke(word_address, value))
+      {
+        reply("error invalid address: 0x%08x", word_address);
+        return true;
+      }
+    }
+    reply("ok");
+  }
+  else if (name == "reg")
+  {
+    uint32_t index;
+    uint32_t value;
+
+    if ((tokens.size() != 2 && tokens.size() != 3) || !parse_register(tokens[1], index))
+      reply("error usage: reg <x0..x31|pc> [<value>]");
+    else if (tokens.size() == 2 && control.read_register(index, value))
+      reply("ok %08x", value);
+    else if (tokens.size() == 3 && parse_u32(tokens[2], value) &&
+             control.write_register(index, value))
+      reply("ok");
+    else
+      reply("error invalid register access: %s", tokens[1].c_str());
+  }
+  else if (name == "goto")
+  {
+    uint64_t cycle;
+    if (tokens.size() != 2 || !parse_u64(tokens[1], cycle))
+      reply("error usage: goto <cycle>");
+    else if (!control.goto_cycle)
+      reply("error time travel needs --checkpoint-interval");
+    else if (!control.goto_cycle(cycle))
+      reply("error cycle %llu is before the first checkpoint", (unsigned long long)cycle);
+    else
+      reply("ok %llu", (unsigned long long)control.cycles());
+  }
+  else if (name == "cycles")
+  {
+    reply("ok %llu", (unsigned long long)control.cycles());
+  }
+  else if (name == "quit")
+  {
+    reply("ok");
+    return false;
+  }
+  else if (name == "shutdown")
+  {
+    reply("ok");
+    shutdown = true;
+    return false;
+  }
+  else
+  {
+    reply("error unknown command: %s", name.c_str());
+  }
+
+  return true;
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "sim_control.h"
+
+// Line based control protocol on a Unix domain socket. The model stays resident between commands,
+// so a client can load, reset and run firmware repeatedly without restarting the simulator.
+// Clients are served one at a time. Each command is answered with "ok [values]" or
+// "error <message>"; console output (--host-out) is streamed during run as "out <hex bytes>".
+//
+//   load <bin|h32> <path>                   Write an image to the RAM
+//   reset                                   Reset the MCU (the RAM keeps its contents)
+//   run <cycles> [wr-addr=<a>] [pc=<a>]     Run; answers "ok <cycles run> <cycles|wr-addr|pc>"
+//   peek <address> [<count>]                Read RAM words
+//   poke <address> <value>...               Write RAM words
+//   reg <x0..x31|pc> [<value>]              Read or write a register
+//   goto <cycle>                            Go to a cycle, back in time with --checkpoint-interval
+//   cycles                                  Cycles since the simulator started
+//   quit                                    Close the connection
+//   shutdown                                Close the connection and exit the simulator
+class Server
+{
+public:
+  Server(const char *path, SimControl control);
+  ~Server();
+
+  bool open(std::string &error);
+
+  // Accepts clients until a shutdown command
+  void serve();
+
+private:
+  std::string path;
+  SimControl control;
+  int listen_fd{-1};
+  FILE *out{nullptr};
+  bool shutdown{false};
+
+  void session(int fd);
+  bool command(const std::vector<std::string> &tokens);
+  void reply(const char *format, ...);
+  void console(const std::string &text);
+};
+
+#endif // SERVER_H
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef SIM_CONTROL_H
+#define SIM_CONTROL_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+enum class StopReason
+{
+  CYCLES,
+  WR_ADDR,
+  PC,
+  STEP,
+  BREAKPOINT,
+  WATCHPOINT,
+  INTERRUPTED,
+  TIME,
+};
+
+inline const char *stop_reason_name(StopReason reason)
+{
+  static const char *names[] = {"cycles",     "wr-addr",    "pc",          "step",
+                                "breakpoint", "watchpoint", "interrupted", "time"};
+  return names[(int)reason];
+}
+
+struct Watchpoint
+{
+  uint32_t address;
+  uint32_t length;
+};
+
+struct RunCondition
+{
+  // Number of cycles to run, 0 = no limit
+  uint64_t cycles{0};
+  // Stop when the program writes 1 to this address (as --wr-addr), 0 = off
+  uint32_t wr_addr{0};
+  // Stop when the instruction at this address is executed
+  bool has_pc{false};
+  uint32_t pc{0};
+  // Stop at the first rising edge at or after this eval step (time), 0 = off
+  uint64_t until_time{0};
+
+  // Debugger conditions, checked when an instruction is about to retire: stop before the next
+  // instruction, before an instruction whose address is a breakpoint, or after a bus write to a
+  // watched range
+  bool step{false};
+  const std::unordered_set<uint32_t> *breakpoints{nullptr};
+  const std::vector<Watchpoint> *watchpoints{nullptr};
+
+  // Polled every few thousand cycles, a true result stops the run
+  std::function<bool()> interrupted;
+};
+
+struct RunResult
+{
+  StopReason reason;
+  // Address of the bus write that hit a watchpoint
+  uint32_t address{0};
+};
+
+// Operations on the simulated MCU used by the control interfaces (--serve, --gdb). They are
+// implemented by the harness, which owns the model.
+struct SimControl
+{
+  std::function<bool(const char *path, bool bin, std::string &error)> load;
+  std::function<void()> reset;
+  std::function<RunResult(const RunCondition &condition, const std::function<void(char)> &console)>
+      run;
+  // Word aligned RAM accesses
+  std::function<bool(uint32_t address, uint32_t &value)> peek;
+  std::function<bool(uint32_t address, uint32_t value)> poke;
+  // Registers 0 to 31 of the integer file and 32 = pc (read only)
+  std::function<bool(uint32_t index, uint32_t &value)> read_register;
+  std::function<bool(uint32_t index, uint32_t value)> write_register;
+  std::function<uint64_t()> cycles;
+
+  // Time travel, only set with --checkpoint-interval. goto_cycle restores the latest checkpoint
+  // before the cycle and replays up to it. reverse goes back to the last point before the current
+  // one at which the run condition (step, breakpoints, watchpoints) stops. Both return false if the
+  // history does not go back far enough; reverse then stops at its beginning.
+  std::function<bool(uint64_t cycle)> goto_cycle;
+  std::function<bool(const RunCondition &condition, RunResult &result)> reverse;
+};
+
+#endif // SIM_CONTROL_H
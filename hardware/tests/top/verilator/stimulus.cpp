@@ -0,0 +1,392 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "stimulus.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+
+Stimulus::Stimulus(const StimulusTiming &timing) : timing(timing)
+{
+}
+
+static bool parse_number(const std::string &text, uint64_t &value)
+{
+  char *end;
+  value = std::strtoull(text.c_str(), &end, 0);
+  return !text.empty() && *end == '\0';
+}
+
+// Splits a line into whitespace separated tokens. Quoted strings are kept as a single token,
+// starting with the quote, with the escapes \n, \r, \t, \\, \" and \xHH resolved.
+static bool tokenize(const std::string &line, std::vector<std::string> &tokens)
+{
+  size_t i = 0;
+
+  while (i < line.size())
+  {
+    if (std::isspace((unsigned char)line[i]))
+    {
+      i++;
+      continue;
+    }
+
+    if (line[i] == '#')
+    {
+      break;
+    }
+
+    std::string token;
+
+    if (line[i] == '"')
+    {
+      token += line[i++];
+      while (i < line.size() && line[i] != '"')
+      {
+        char c = line[i++];
+        if (c == '\\' && i < line.size())
+        {
+          c = line[i++];
+          switch (c)
+          {
+          case 'n':
+            c = '\n';
+            break;
+          case 'r':
+            c = '\r';
+            break;
+          case 't':
+            c = '\t';
+            break;
+          case 'x':
+            if (i + 2 > line.size())
+            {
+              return false;
+            }
+            c = (char)std::strtoul(line.substr(i, 2).c_str(), nullptr, 16);
+            i += 2;
+            break;
+          default:
+            break;
+          }
+        }
+        token += c;
+      }
+
+      if (i == line.size())
+      {
+        return false;
+      }
+      i++;
+    }
+    else
+    {
+      while (i < line.size() && !std::isspace((unsigned char)line[i]))
+      {
+        token += line[i++];
+      }
+    }
+
+    tokens.push_back(token);
+  }
+
+  return true;
+}
+
+bool Stimulus::parse_time(const std::string &text, uint64_t base, uint64_t &cycle) const
+{
+  std::string number = text;
+  uint64_t scale_ns = 0;
+  uint64_t value;
+
+  if (!number.empty() && number[0] == '+')
+  {
+    number = number.substr(1);
+  }
+  else
+  {
+    base = 0;
+  }
+
+  static const struct
+  {
+    const char *suffix;
+    uint64_t ns;
+  } units[] = {{"ns", 1}, {"us", 1000}, {"ms", 1000000}};
+
+  for (const auto &unit : units)
+  {
+    size_t length = std::char_traits<char>::length(unit.suffix);
+    if (number.size() > length && number.compare(number.size() - length, length, unit.suffix) == 0)
+    {
+      number = number.substr(0, number.size() - length);
+      scale_ns = unit.ns;
+      break;
+    }
+  }
+
+  if (!parse_number(number, value))
+  {
+    return false;
+  }
+
+  cycle = base + (scale_ns ? value * scale_ns / timing.clock_period_ns : value);
+  return true;
+}
+
+bool Stimulus::parse_pin(const std::string &text, Pin &pin, uint32_t &mask) const
+{
+  uint64_t bit;
+
+  mask = 1;
+
+  if (text == "uart_rx")
+  {
+    pin = Pin::UART_RX;
+    return true;
+  }
+
+  if (text == "poci")
+  {
+    pin = Pin::POCI;
+    return true;
+  }
+
+  if (text.compare(0, 4, "gpio") == 0 && parse_number(text.substr(4), bit) &&
+      bit < timing.gpio_width)
+  {
+    pin = Pin::GPIO;
+    mask = 1u << bit;
+    return true;
+  }
+
+  return false;
+}
+
+uint64_t Stimulus::add_uart(uint64_t cycle, const std::vector<uint8_t> &bytes, uint32_t baud_rate)
+{
+  // 8N1 frames, least significant bit first. The fractional part of the bit time is accumulated
+  // so that long streams do not drift from the baud rate.
+  double cycles_per_bit = (double)timing.clock_frequency / baud_rate;
+  double time = cycle;
+
+  for (uint8_t byte : bytes)
+  {
+    uint32_t frame = 0x200 | ((uint32_t)byte << 1);
+    for (int bit = 0; bit < 10; bit++)
+    {
+      changes.push_back({(uint64_t)time, Pin::UART_RX, false, 1, (frame >> bit) & 0x1});
+      time += cycles_per_bit;
+    }
+  }
+
+  return (uint64_t)time;
+}
+
+bool Stimulus::parse_line(const std::vector<std::string> &tokens, uint64_t &time,
+                          std::string &error)
+{
+  uint64_t cycle;
+  Pin pin;
+  uint32_t mask;
+  uint64_t value;
+
+  if (tokens.size() < 2)
+  {
+    error = "missing command";
+    return false;
+  }
+
+  if (!parse_time(tokens[0], time, cycle))
+  {
+    error = "invalid time: " + tokens[0];
+    return false;
+  }
+  time = cycle;
+
+  const std::string &command = tokens[1];
+
+  if (command == "gpio")
+  {
+    if (tokens.size() != 3 || !parse_number(tokens[2], value))
+    {
+      error = "expected: gpio <value>";
+      return false;
+    }
+    changes.push_back({cycle, Pin::GPIO, false, (1u << timing.gpio_width) - 1, (uint32_t)value});
+    return true;
+  }
+
+  if (command == "pin")
+  {
+    if (tokens.size() != 4 || !parse_pin(tokens[2], pin, mask) || !parse_number(tokens[3], value) ||
+        value > 1)
+    {
+      error = "expected: pin <uart_rx|poci|gpio<n>> <0|1>";
+      return false;
+    }
+    changes.push_back({cycle, pin, false, mask, value ? mask : 0});
+    return true;
+  }
+
+  if (command == "toggle")
+  {
+    uint64_t count = 1;
+    uint64_t period = 0;
+
+    if ((tokens.size() != 3 && tokens.size() != 5) || !parse_pin(tokens[2], pin, mask) ||
+        (tokens.size() == 5 && (!parse_number(tokens[3], count) ||
+                                !parse_time(tokens[4], 0, period) || period == 0)))
+    {
+      error = "expected: toggle <uart_rx|poci|gpio<n>> [<count> <period>]";
+      return false;
+    }
+    for (uint64_t i = 0; i < count; i++)
+    {
+      changes.push_back({cycle + i * period, pin, true, mask, 0});
+    }
+    return true;
+  }
+
+  if (command == "uart")
+  {
+    std::vector<uint8_t> bytes;
+    uint64_t baud_rate = timing.uart_baud_rate;
+    uint64_t gap = 0;
+    uint64_t repeat = 1;
+
+    for (size_t i = 2; i < tokens.size(); i++)
+    {
+      const std::string &token = tokens[i];
+
+      if (token[0] == '"')
+      {
+        bytes.insert(bytes.end(), token.begin() + 1, token.end());
+      }
+      else if (token.compare(0, 5, "baud=") == 0)
+      {
+        if (!parse_number(token.substr(5), baud_rate) || baud_rate == 0)
+        {
+          error = "invalid baud rate: " + token;
+          return false;
+        }
+      }
+      else if (token.compare(0, 4, "gap=") == 0)
+      {
+        if (!parse_time(token.substr(4), 0, gap))
+        {
+          error = "invalid gap: " + token;
+          return false;
+        }
+      }
+      else if (token.compare(0, 7, "repeat=") == 0)
+      {
+        if (!parse_number(token.substr(7), repeat))
+        {
+          error = "invalid repeat: " + token;
+          return false;
+        }
+      }
+      else if (parse_number(token, value) && value <= 0xff)
+      {
+        bytes.push_back((uint8_t)value);
+      }
+      else
+      {
+        error = "invalid byte: " + token;
+        return false;
+      }
+    }
+
+    if (bytes.empty())
+    {
+      error = "expected: uart <bytes|\"string\">... [baud=<rate>] [gap=<time>] [repeat=<count>]";
+      return false;
+    }
+
+    for (uint64_t i = 0; i < repeat; i++)
+    {
+      cycle = add_uart(cycle, bytes, baud_rate) + gap;
+    }
+    return true;
+  }
+
+  error = "unknown command: " + command;
+  return false;
+}
+
+bool Stimulus::load(const char *path, std::string &error)
+{
+  std::ifstream file(path);
+  std::string line;
+  uint64_t time = 0;
+  size_t line_number = 0;
+
+  if (!file.is_open())
+  {
+    error = std::string("Error file opening: ") + path;
+    return false;
+  }
+
+  while (std::getline(file, line))
+  {
+    std::vector<std::string> tokens;
+    line_number++;
+
+    if (!tokenize(line, tokens))
+    {
+      error = std::string(path) + ":" + std::to_string(line_number) + ": unterminated string";
+      return false;
+    }
+
+    if (tokens.empty())
+    {
+      continue;
+    }
+
+    if (!parse_line(tokens, time, error))
+    {
+      error = std::string(path) + ":" + std::to_string(line_number) + ": " + error;
+      return false;
+    }
+  }
+
+  // Changes of the same cycle are applied in the order of the file
+  std::stable_sort(changes.begin(), changes.end(),
+                   [](const Change &a, const Change &b) { return a.cycle < b.cycle; });
+  for (Change &change : changes)
+  {
+    change.cycle += timing.start_cycle;
+  }
+  next = 0;
+
+  return true;
+}
+
+void Stimulus::apply(uint64_t cycle, StimulusPins &pins)
+{
+  for (; next < changes.size() && changes[next].cycle <= cycle; next++)
+  {
+    const Change &change = changes[next];
+
+    switch (change.pin)
+    {
+    case Pin::UART_RX:
+      pins.uart_rx = change.toggle ? !pins.uart_rx : change.value;
+      break;
+
+    case Pin::POCI:
+      pins.poci = change.toggle ? !pins.poci : change.value;
+      break;
+
+    case Pin::GPIO:
+      if (change.toggle)
+        pins.gpio_input ^= change.mask;
+      else
+        pins.gpio_input = (pins.gpio_input & ~change.mask) | (change.value & change.mask);
+      break;
+    }
+  }
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef STIMULUS_H
+#define STIMULUS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Inputs of mcu_sim driven by the stimulus
+struct StimulusPins
+{
+  uint8_t uart_rx{1};
+  uint8_t poci{0};
+  uint32_t gpio_input{0};
+};
+
+struct StimulusTiming
+{
+  // Period of the simulated clock (--freq-ns), used to convert times to cycles
+  uint32_t clock_period_ns;
+  // Clock frequency and default baud rate of the DUT, used to serialize UART bytes
+  uint32_t clock_frequency;
+  uint32_t uart_baud_rate;
+  uint32_t gpio_width;
+  // Cycle the times of the script are counted from
+  uint64_t start_cycle{0};
+};
+
+// Time-stamped stimulus script. The events of the script are expanded into pin changes, sorted by
+// cycle when the file is loaded, so the harness only has to compare the current cycle with the
+// cycle of the next change.
+//
+//   # <time> <command> <arguments>
+//   1000      gpio 0x3                 # cycle 1000: gpio_input = 0b11
+//   20us      pin gpio1 0              # simulated time (ns, us, ms)
+//   +500      pin poci 1               # relative to the previous event
+//   1ms       toggle gpio0 1000 200ns  # 1000 toggles, one every 200ns
+//   2ms       uart "hello\n" 0x00 baud=115200 gap=10us repeat=10
+class Stimulus
+{
+public:
+  explicit Stimulus(const StimulusTiming &timing);
+
+  // Returns false and sets error (with the line number) if the file is invalid
+  bool load(const char *path, std::string &error);
+
+  bool due(uint64_t cycle) const
+  {
+    return next < changes.size() && changes[next].cycle <= cycle;
+  }
+
+  // Applies all the changes due at the given cycle
+  void apply(uint64_t cycle, StimulusPins &pins);
+
+  size_t size() const
+  {
+    return changes.size();
+  }
+
+  // Index of the next change, saved and restored with the checkpoints
+  size_t position() const
+  {
+    return next;
+  }
+
+  void seek(size_t position)
+  {
+    next = position;
+  }
+
+private:
+  enum class Pin
+  {
+    UART_RX,
+    POCI,
+    GPIO,
+  };
+
+  struct Change
+  {
+    uint64_t cycle;
+    Pin pin;
+    bool toggle;
+    uint32_t mask;
+    uint32_t value;
+  };
+
+  StimulusTiming timing;
+  std::vector<Change> changes;
+  size_t next{0};
+
+  bool parse_time(const std::string &text, uint64_t base, uint64_t &cycle) const;
+  bool parse_pin(const std::string &text, Pin &pin, uint32_t &mask) const;
+  bool parse_line(const std::vector<std::string> &tokens, uint64_t &time, std::string &error);
+  uint64_t add_uart(uint64_t cycle, const std::vector<uint8_t> &bytes, uint32_t baud_rate);
+};
+
+#endif // STIMULUS_H
@@ -0,0 +1,593 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "system_sim.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "Vmcu_sim.h"
+#include "Vmcu_sim___024root.h"
+#include "log.h"
+#include "ram_init.h"
+
+struct PinChange
+{
+  uint64_t cycle;
+  uint32_t value;
+};
+
+// Pin changes of a link. The driver appends to produced during a quantum; the receiver reads
+// pending, which is only updated while all the threads wait at the barrier.
+struct Channel
+{
+  const SystemLink *link;
+  uint32_t last{0};
+  std::vector<PinChange> produced;
+  std::vector<PinChange> pending;
+  size_t next{0};
+};
+
+class McuInstance
+{
+public:
+  McuInstance(const SystemMcu &config, uint64_t quantum) : config(config), quantum(quantum)
+  {
+    model = new Vmcu_sim(&context, config.name.c_str());
+  }
+
+  ~McuInstance()
+  {
+    model->final();
+    delete model;
+  }
+
+  bool open(std::string &error);
+
+  void add_input(Channel *channel)
+  {
+    inputs.push_back(channel);
+  }
+
+  void add_output(Channel *channel)
+  {
+    channel->last = read_pin(channel->link->from_pin, channel->link->from_bit);
+    // The receiver starts with the state of the pin after the reset
+    channel->produced.push_back({0, channel->last});
+    outputs.push_back(channel);
+  }
+
+  // Runs up to the end cycle, or until the program finishes
+  void run(uint64_t end_cycle);
+
+  // Complete lines of console output, the rest is kept for the next call
+  std::string console_lines(bool all);
+
+  const std::string &name() const
+  {
+    return config.name;
+  }
+
+  bool has_wr_addr() const
+  {
+    return config.wr_addr != 0;
+  }
+
+  bool finished() const
+  {
+    return done;
+  }
+
+  // Cycle at which the program finished, or the last cycle run
+  uint64_t cycles() const
+  {
+    return done ? finish_cycle : cycle;
+  }
+
+private:
+  SystemMcu config;
+  uint64_t quantum;
+  VerilatedContext context;
+  Vmcu_sim *model;
+  uint64_t cycle{0};
+  uint64_t finish_cycle{0};
+  bool done{false};
+  // Store to host_out presented in the last cycle, printed when the device responds
+  bool host_out_pending{false};
+  char host_out_data{0};
+  std::string console;
+  uint32_t gpio_input{0};
+  std::vector<Channel *> inputs;
+  std::vector<Channel *> outputs;
+
+  uint32_t read_pin(SystemPin pin, uint32_t bit) const;
+  void write_pin(SystemPin pin, uint32_t bit, uint32_t value);
+};
+
+bool McuInstance::open(std::string &error)
+{
+  uint32_t ram_size = model->rootp->mcu_sim__DOT__rvx_instance__DOT__MEMORY_SIZE;
+  DutRamWrite write = [this](uint32_t i, uint32_t v) {
+    model->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_ram_instance__DOT__ram[i] = v;
+  };
+
+  if (!std::ifstream(config.image).good())
+  {
+    error = config.name + ": error file opening: " + config.image;
+    return false;
+  }
+
+  if (config.bin)
+    ram_init_bin(config.image.c_str(), ram_size / 4, write);
+  else
+    ram_init_h32(config.image.c_str(), ram_size / 4, write);
+
+  // Same reset as mcu_sim, the UART line idles high
+  model->uart_rx = 1;
+  model->poci = 0;
+  model->gpio_input = 0;
+  model->halt = 0;
+  model->reset = 1;
+  for (int i = 0; i < 100; i++)
+  {
+    model->clock ^= 1;
+    model->eval();
+  }
+  model->reset = 0;
+
+  return true;
+}
+
+uint32_t McuInstance::read_pin(SystemPin pin, uint32_t bit) const
+{
+  switch (pin)
+  {
+  case SystemPin::UART_TX:
+    return model->uart_tx;
+  case SystemPin::SCLK:
+    return model->sclk;
+  case SystemPin::PICO:
+    return model->pico;
+  case SystemPin::CS:
+    return (model->cs >> bit) & 1;
+  case SystemPin::GPIO_OUTPUT:
+    return (model->gpio_output >> bit) & 1;
+  default:
+    return 0;
+  }
+}
+
+void McuInstance::write_pin(SystemPin pin, uint32_t bit, uint32_t value)
+{
+  switch (pin)
+  {
+  case SystemPin::UART_RX:
+    model->uart_rx = value;
+    break;
+  case SystemPin::POCI:
+    model->poci = value;
+    break;
+  case SystemPin::GPIO_INPUT:
+    gpio_input = (gpio_input & ~(1u << bit)) | (value << bit);
+    model->gpio_input = gpio_input;
+    break;
+  default:
+    break;
+  }
+}
+
+void McuInstance::run(uint64_t end_cycle)
+{
+  while (cycle < end_cycle)
+  {
+    if (done)
+    {
+      // A finished MCU is idle, the changes of its inputs are dropped
+      for (Channel *channel : inputs)
+      {
+        channel->next = channel->pending.size();
+      }
+      cycle = end_cycle;
+      break;
+    }
+
+    // Inputs arrive one quantum after the output changed, and are sampled at this rising edge
+    for (Channel *channel : inputs)
+    {
+      while (channel->next < channel->pending.size() &&
+             channel->pending[channel->next].cycle + quantum <= cycle)
+      {
+        write_pin(channel->link->to_pin, channel->link->to_bit,
+                  channel->pending[channel->next++].value);
+      }
+    }
+
+    model->clock = 1;
+    model->eval();
+    cycle++;
+
+    bool write_request =
+        model->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_request;
+    uint32_t address =
+        model->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__rw_address;
+    uint32_t data =
+        model->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_data;
+
+    // Back-to-back stores keep write_request high, each one is accepted by the response in the
+    // next cycle
+    if (host_out_pending &&
+        model->rootp->mcu_sim__DOT__rvx_instance__DOT__rvx_core_instance__DOT__write_response)
+    {
+      console += host_out_data;
+    }
+    host_out_pending = config.host_out && write_request && address == config.host_out;
+    host_out_data = (char)data;
+
+    if (config.wr_addr && write_request && address == config.wr_addr && data == 1)
+    {
+      done = true;
+      finish_cycle = cycle;
+    }
+
+    model->clock = 0;
+    model->eval();
+
+    for (Channel *channel : outputs)
+    {
+      uint32_t value = read_pin(channel->link->from_pin, channel->link->from_bit);
+      if (value != channel->last)
+      {
+        channel->last = value;
+        channel->produced.push_back({cycle, value});
+      }
+    }
+  }
+}
+
+std::string McuInstance::console_lines(bool all)
+{
+  size_t end = all ? console.size() : console.rfind('\n');
+  if (!all)
+  {
+    if (end == std::string::npos)
+      return "";
+    end++;
+  }
+
+  std::string lines = console.substr(0, end);
+  console.erase(0, end);
+  if (all && !lines.empty() && lines.back() != '\n')
+  {
+    lines += '\n';
+  }
+  return lines;
+}
+
+// Reusable barrier, the last thread to arrive runs the completion before the others are released
+class QuantumBarrier
+{
+public:
+  QuantumBarrier(size_t count, std::function<void()> completion)
+      : count(count), completion(std::move(completion))
+  {
+  }
+
+  void arrive_and_wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t current = generation;
+
+    if (++arrived == count)
+    {
+      completion();
+      arrived = 0;
+      generation++;
+      released.notify_all();
+      return;
+    }
+
+    released.wait(lock, [&]() { return generation != current; });
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable released;
+  size_t count;
+  size_t arrived{0};
+  uint64_t generation{0};
+  std::function<void()> completion;
+};
+
+static bool parse_pin(const std::string &text, bool output, SystemPin &pin, uint32_t &bit)
+{
+  struct Name
+  {
+    const char *name;
+    SystemPin pin;
+    bool output;
+    bool indexed;
+  };
+  static const Name names[] = {
+      {"uart_tx", SystemPin::UART_TX, true, false},
+      {"sclk", SystemPin::SCLK, true, false},
+      {"pico", SystemPin::PICO, true, false},
+      {"cs", SystemPin::CS, true, true},
+      {"gpio", SystemPin::GPIO_OUTPUT, true, true},
+      {"uart_rx", SystemPin::UART_RX, false, false},
+      {"poci", SystemPin::POCI, false, false},
+      {"gpio", SystemPin::GPIO_INPUT, false, true},
+  };
+
+  for (const Name &name : names)
+  {
+    size_t length = std::strlen(name.name);
+    if (name.output != output || text.compare(0, length, name.name) != 0)
+    {
+      continue;
+    }
+
+    pin = name.pin;
+    bit = 0;
+    if (!name.indexed)
+    {
+      return text.size() == length;
+    }
+
+    char *end;
+    bit = std::strtoul(text.c_str() + length, &end, 10);
+    return text.size() > length && *end == '\0' && bit < 32;
+  }
+
+  return false;
+}
+
+bool SystemTopology::load(const char *path, uint32_t host_out, uint32_t wr_addr,
+                          std::string &error)
+{
+  std::ifstream file(path);
+  std::string line;
+  size_t line_number = 0;
+
+  if (!file.is_open())
+  {
+    error = std::string("Error file opening: ") + path;
+    return false;
+  }
+
+  auto find_mcu = [this](const std::string &name, size_t &index) {
+    for (index = 0; index < mcus.size(); index++)
+    {
+      if (mcus[index].name == name)
+        return true;
+    }
+    return false;
+  };
+
+  while (std::getline(file, line))
+  {
+    line_number++;
+    line = line.substr(0, line.find('#'));
+
+    std::istringstream tokens(line);
+    std::string command;
+    if (!(tokens >> command))
+    {
+      continue;
+    }
+
+    std::string where = std::string(path) + ":" + std::to_string(line_number) + ": ";
+    size_t index;
+
+    if (command == "mcu")
+    {
+      SystemMcu mcu;
+      std::string format, option;
+      mcu.host_out = host_out;
+      mcu.wr_addr = wr_addr;
+
+      if (!(tokens >> mcu.name >> format >> mcu.image) || (format != "bin" && format != "h32"))
+      {
+        error = where + "expected mcu <name> <bin|h32> <image>";
+        return false;
+      }
+      if (find_mcu(mcu.name, index))
+      {
+        error = where + "duplicate mcu: " + mcu.name;
+        return false;
+      }
+      mcu.bin = format == "bin";
+
+      while (tokens >> option)
+      {
+        if (option.compare(0, 9, "host-out=") == 0)
+          mcu.host_out = std::strtoul(option.c_str() + 9, nullptr, 0);
+        else if (option.compare(0, 8, "wr-addr=") == 0)
+          mcu.wr_addr = std::strtoul(option.c_str() + 8, nullptr, 0);
+        else
+        {
+          error = where + "unknown option: " + option;
+          return false;
+        }
+      }
+
+      mcus.push_back(mcu);
+    }
+    else if (command == "connect")
+    {
+      std::string from, to, extra;
+      SystemLink link;
+
+      if (!(tokens >> from >> to) || (tokens >> extra))
+      {
+        error = where + "expected connect <mcu>.<output> <mcu>.<input>";
+        return false;
+      }
+
+      size_t from_dot = from.find('.');
+      size_t to_dot = to.find('.');
+      if (from_dot == std::string::npos || !find_mcu(from.substr(0, from_dot), link.from) ||
+          !parse_pin(from.substr(from_dot + 1), true, link.from_pin, link.from_bit))
+      {
+        error = where + "invalid output: " + from;
+        return false;
+      }
+      if (to_dot == std::string::npos || !find_mcu(to.substr(0, to_dot), link.to) ||
+          !parse_pin(to.substr(to_dot + 1), false, link.to_pin, link.to_bit))
+      {
+        error = where + "invalid input: " + to;
+        return false;
+      }
+
+      for (const SystemLink &other : links)
+      {
+        if (other.to == link.to && other.to_pin == link.to_pin && other.to_bit == link.to_bit)
+        {
+          error = where + "input already driven: " + to;
+          return false;
+        }
+      }
+
+      links.push_back(link);
+    }
+    else
+    {
+      error = where + "unknown command: " + command;
+      return false;
+    }
+  }
+
+  if (mcus.empty())
+  {
+    error = std::string(path) + ": no mcu";
+    return false;
+  }
+
+  return true;
+}
+
+SystemSim::SystemSim(const SystemTopology &topology, uint64_t quantum)
+    : topology(topology), quantum(quantum ? quantum : 1)
+{
+}
+
+SystemSim::~SystemSim() = default;
+
+bool SystemSim::open(std::string &error)
+{
+  for (const SystemMcu &mcu : topology.mcus)
+  {
+    instances.emplace_back(new McuInstance(mcu, quantum));
+    if (!instances.back()->open(error))
+    {
+      return false;
+    }
+    Log::info("MCU %s: %s", mcu.name.c_str(), mcu.image.c_str());
+  }
+
+  return true;
+}
+
+void SystemSim::run(uint64_t max_cycles)
+{
+  std::vector<Channel> channels(topology.links.size());
+  for (size_t i = 0; i < channels.size(); i++)
+  {
+    const SystemLink &link = topology.links[i];
+    channels[i].link = &link;
+    instances[link.from]->add_output(&channels[i]);
+    instances[link.to]->add_input(&channels[i]);
+  }
+
+  bool wait_finish = false;
+  for (const auto &instance : instances)
+  {
+    wait_finish |= instance->has_wr_addr();
+  }
+
+  uint64_t end_cycle = max_cycles ? std::min(quantum, max_cycles) : quantum;
+  bool stop = false;
+
+  auto flush_console = [this](bool all) {
+    for (const auto &instance : instances)
+    {
+      std::string lines = instance->console_lines(all);
+      for (size_t start = 0; start < lines.size();)
+      {
+        size_t end = lines.find('\n', start) + 1;
+        Log::host_out('[');
+        for (char c : instance->name() + "] " + lines.substr(start, end - start))
+        {
+          Log::host_out(c);
+        }
+        start = end;
+      }
+    }
+  };
+
+  // Runs in the last thread to reach the end of the quantum, while the others wait
+  QuantumBarrier barrier(instances.size(), [&]() {
+    for (Channel &channel : channels)
+    {
+      channel.pending.erase(channel.pending.begin(), channel.pending.begin() + channel.next);
+      channel.pending.insert(channel.pending.end(), channel.produced.begin(),
+                             channel.produced.end());
+      channel.produced.clear();
+      channel.next = 0;
+    }
+
+    flush_console(false);
+
+    bool all_finished = true;
+    for (const auto &instance : instances)
+    {
+      all_finished &= !instance->has_wr_addr() || instance->finished();
+    }
+
+    if ((wait_finish && all_finished) || (max_cycles && end_cycle >= max_cycles))
+    {
+      stop = true;
+      return;
+    }
+    end_cycle = max_cycles ? std::min(end_cycle + quantum, max_cycles) : end_cycle + quantum;
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+
+  for (const auto &instance : instances)
+  {
+    McuInstance *mcu = instance.get();
+    threads.emplace_back([&, mcu]() {
+      while (!stop)
+      {
+        mcu->run(end_cycle);
+        barrier.arrive_and_wait();
+      }
+    });
+  }
+
+  for (std::thread &thread : threads)
+  {
+    thread.join();
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  flush_console(true);
+
+  for (const auto &instance : instances)
+  {
+    Log::info("MCU %s: %s at cycle %llu", instance->name().c_str(),
+              instance->finished() ? "finished" : "stopped",
+              (unsigned long long)instance->cycles());
+  }
+  Log::info("System: %llu cycles in %.2f s, quantum %llu", (unsigned long long)end_cycle,
+            elapsed.count(), (unsigned long long)quantum);
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef SYSTEM_SIM_H
+#define SYSTEM_SIM_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class SystemPin
+{
+  // Outputs
+  UART_TX,
+  SCLK,
+  PICO,
+  CS,
+  GPIO_OUTPUT,
+  // Inputs
+  UART_RX,
+  POCI,
+  GPIO_INPUT,
+};
+
+struct SystemMcu
+{
+  std::string name;
+  std::string image;
+  bool bin{false};
+  uint32_t host_out{0};
+  uint32_t wr_addr{0};
+};
+
+// An output pin of one MCU driving an input pin of another one. bit selects the line of cs and
+// gpio.
+struct SystemLink
+{
+  size_t from;
+  SystemPin from_pin;
+  uint32_t from_bit;
+  size_t to;
+  SystemPin to_pin;
+  uint32_t to_bit;
+};
+
+// Topology file:
+//
+//   # mcu <name> <bin|h32> <image> [host-out=<address>] [wr-addr=<address>]
+//   mcu sensor  bin sensor.bin
+//   mcu gateway bin gateway.bin host-out=0x90000000
+//
+//   # connect <mcu>.<output> <mcu>.<input>
+//   # outputs: uart_tx, sclk, pico, cs<n>, gpio<n>   inputs: uart_rx, poci, gpio<n>
+//   connect sensor.uart_tx  gateway.uart_rx
+//   connect gateway.uart_tx sensor.uart_rx
+//   connect gateway.gpio0   sensor.gpio3
+struct SystemTopology
+{
+  std::vector<SystemMcu> mcus;
+  std::vector<SystemLink> links;
+
+  // Returns false and sets error (with the line number) if the file is invalid. host_out and
+  // wr_addr are the defaults of the MCUs that do not set them.
+  bool load(const char *path, uint32_t host_out, uint32_t wr_addr, std::string &error);
+};
+
+class McuInstance;
+
+// Several MCUs simulated together, each one on its own thread. The threads run a quantum of cycles
+// independently, then synchronize: the output pin changes of the quantum are passed to the inputs
+// they drive, which see them exactly one quantum later. A quantum shorter than the fastest signal
+// of the links (a UART bit, an SPI clock period) keeps the links working; a longer one makes the
+// threads synchronize less often.
+class SystemSim
+{
+public:
+  SystemSim(const SystemTopology &topology, uint64_t quantum);
+  ~SystemSim();
+
+  bool open(std::string &error);
+
+  // Runs until all the MCUs with a wr-addr have finished, or max_cycles (0 = no limit)
+  void run(uint64_t max_cycles);
+
+private:
+  SystemTopology topology;
+  uint64_t quantum;
+  std::vector<std::unique_ptr<McuInstance>> instances;
+};
+
+#endif // SYSTEM_SIM_H
@@ -0,0 +1,778 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#include "tlm_peripherals.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "Vmcu_sim__Dpi.h"
+#include "svdpi.h"
+
+static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+void TlmDevice::reset(uint64_t cycle)
+{
+  clear();
+  processed = cycle;
+}
+
+void TlmDevice::catch_up(uint64_t cycle)
+{
+  while (processed < cycle)
+  {
+    uint64_t quiet = std::min(quiet_edges(), cycle - processed);
+    if (quiet)
+    {
+      skip(quiet);
+      processed += quiet;
+    }
+    else
+    {
+      step(TlmEdge());
+      processed++;
+    }
+  }
+}
+
+uint64_t TlmDevice::edge(uint64_t cycle, const TlmEdge &access, uint32_t input_value,
+                         uint32_t &read_data)
+{
+  catch_up(cycle - 1);
+
+  input = input_value;
+  if (access.read)
+  {
+    read_data = read_register(access.address);
+  }
+  step(access);
+  processed = cycle;
+
+  uint64_t quiet = quiet_edges();
+  return quiet == NEVER ? NEVER : processed + quiet + 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+// rvx_uart
+
+static constexpr uint32_t UART_WDATA = 0x00;
+static constexpr uint32_t UART_RDATA = 0x04;
+static constexpr uint32_t UART_READY = 0x08;
+static constexpr uint32_t UART_RXSTATUS = 0x0c;
+static constexpr uint32_t UART_STATUS = 0x10;
+static constexpr uint32_t UART_LEVEL = 0x14;
+static constexpr uint32_t UART_IRQ_ENABLE = 0x18;
+static constexpr uint32_t UART_WATERMARK = 0x1c;
+
+void TlmUart::clear()
+{
+  reset_reg = true;
+  tx_cycle_counter = 0;
+  tx_fraction = 0;
+  tx_register = 0x3ff;
+  tx_bit_counter = 0;
+  rx_cycle_counter = 0;
+  rx_fraction = 0;
+  rx_register = 0;
+  rx_bit_counter = 0;
+  tx_fifo.clear();
+  rx_fifo.clear();
+  rx_overrun = false;
+  rx_timeout_counter = 0;
+  irq_enable = 0x1;
+  rx_watermark = 1;
+  tx_threshold = 0;
+  irq_active = 0;
+  irq_taken = false;
+}
+
+uint32_t TlmUart::pending() const
+{
+  bool tx_empty = tx_fifo.empty() && tx_bit_counter == 0;
+
+  return (!rx_fifo.empty() && rx_fifo.size() >= rx_watermark) |
+         (rx_timeout_counter == timeout_cycles) << 1 | tx_empty << 2 |
+         (tx_fifo.size() <= tx_threshold) << 3;
+}
+
+uint32_t TlmUart::read_register(uint32_t address) const
+{
+  switch (address)
+  {
+  case UART_RDATA:
+    return rx_fifo.empty() ? 0 : rx_fifo.front();
+  case UART_READY:
+    return tx_fifo.size() != tx_depth;
+  case UART_RXSTATUS:
+    return !rx_fifo.empty();
+  case UART_STATUS:
+    return pending() << 8 | rx_overrun << 4 | (tx_fifo.size() == tx_depth) << 3 |
+           (tx_fifo.empty() && tx_bit_counter == 0) << 2 | (rx_fifo.size() == rx_depth) << 1 |
+           !rx_fifo.empty();
+  case UART_LEVEL:
+    return (tx_fifo.size() & 0xff) << 8 | (rx_fifo.size() & 0xff);
+  case UART_IRQ_ENABLE:
+    return irq_enable;
+  case UART_WATERMARK:
+    return tx_threshold << 8 | rx_watermark;
+  default:
+    return 0;
+  }
+}
+
+void TlmUart::step(const TlmEdge &access)
+{
+  if (reset_reg)
+  {
+    clear();
+    reset_reg = false;
+    return;
+  }
+
+  uint32_t active = irq_enable & pending();
+
+  // Transmitter. The next byte starts when the line is idle or right after the stop bit, the bytes
+  // written to a full FIFO are dropped.
+  bool tx_push = access.write && access.address == UART_WDATA && tx_fifo.size() != tx_depth;
+  bool tx_bit_end = tx_bit_counter && !tx_cycle_counter;
+  bool tx_load = !tx_fifo.empty() && (tx_bit_counter == 0 || (tx_bit_counter == 1 && tx_bit_end));
+  uint32_t tx_sum = tx_fraction + divider_fraction;
+
+  if (tx_load)
+  {
+    tx_cycle_counter = divider_integer - 1 + (tx_sum >> 8);
+    tx_fraction = tx_sum & 0xff;
+    tx_register = 0x200 | tx_fifo.front() << 1;
+    tx_bit_counter = 10;
+    tx_fifo.pop_front();
+  }
+  else if (tx_bit_end)
+  {
+    bool stop = tx_bit_counter == 1;
+    tx_cycle_counter = stop ? 0 : divider_integer - 1 + (tx_sum >> 8);
+    tx_fraction = stop ? 0 : tx_sum & 0xff;
+    tx_register = 0x200 | tx_register >> 1;
+    tx_bit_counter--;
+  }
+  else if (tx_bit_counter)
+  {
+    tx_cycle_counter--;
+  }
+
+  if (tx_push)
+  {
+    tx_fifo.push_back(access.data & 0xff);
+  }
+
+  // Receiver. The bytes received while the FIFO is full are dropped.
+  bool rx = input & 0x1;
+  bool rx_pop = access.read && access.address == UART_RDATA && !rx_fifo.empty();
+  bool rx_sample = rx_bit_counter && !rx_cycle_counter;
+  bool rx_push = rx_sample && rx_bit_counter == 1;
+  bool rx_write = rx_push && (rx_fifo.size() != rx_depth || rx_pop);
+  bool rx_empty = rx_fifo.empty();
+  uint8_t received = rx_register;
+  uint32_t rx_sum = rx_fraction + divider_fraction;
+
+  if (rx_bit_counter == 0)
+  {
+    if (rx)
+    {
+      rx_cycle_counter = 0;
+    }
+    else if (rx_cycle_counter >= divider_integer / 2)
+    {
+      // Middle of the start bit
+      rx_cycle_counter = divider_integer - 1 + (rx_sum >> 8);
+      rx_fraction = rx_sum & 0xff;
+      rx_bit_counter = 9;
+    }
+    else
+    {
+      rx_cycle_counter++;
+    }
+  }
+  else if (rx_sample)
+  {
+    bool stop = rx_bit_counter == 1;
+    rx_cycle_counter = stop ? 0 : divider_integer - 1 + (rx_sum >> 8);
+    rx_fraction = stop ? 0 : rx_sum & 0xff;
+    if (!stop)
+    {
+      rx_register = (rx ? 0x80 : 0) | rx_register >> 1;
+    }
+    rx_bit_counter--;
+  }
+  else
+  {
+    rx_cycle_counter--;
+  }
+
+  if (rx_pop)
+  {
+    rx_fifo.pop_front();
+  }
+  if (rx_write)
+  {
+    rx_fifo.push_back(received);
+  }
+
+  if (rx_push && !rx_write)
+  {
+    rx_overrun = true;
+  }
+  else if (access.read && access.address == UART_STATUS)
+  {
+    rx_overrun = false;
+  }
+
+  if (rx_empty || rx_push || rx_pop)
+  {
+    rx_timeout_counter = 0;
+  }
+  else if (rx_timeout_counter != timeout_cycles)
+  {
+    rx_timeout_counter++;
+  }
+
+  // A condition that becomes active, or a byte received, read or written, ends the interrupt
+  // taken by the core
+  if ((active & ~irq_active) || rx_write || rx_pop || tx_push)
+  {
+    irq_taken = false;
+  }
+  else if (access.irq_response)
+  {
+    irq_taken = true;
+  }
+  irq_active = active;
+
+  if (access.write && access.address == UART_IRQ_ENABLE)
+  {
+    irq_enable = access.data & 0xf;
+  }
+  else if (access.write && access.address == UART_WATERMARK)
+  {
+    rx_watermark = access.data & 0xff;
+    tx_threshold = access.data >> 8 & 0xff;
+  }
+}
+
+uint64_t TlmUart::quiet_edges() const
+{
+  // The edge after a change of the enabled conditions can end the interrupt taken
+  if (reset_reg || (irq_enable & pending()) != irq_active)
+  {
+    return 0;
+  }
+
+  // Edges that only count the cycles of a bit, of half the start bit or of the idle timeout
+  uint64_t tx;
+  uint64_t rx;
+  uint64_t timeout = NEVER;
+
+  if (tx_bit_counter == 0)
+  {
+    tx = tx_fifo.empty() ? NEVER : 0;
+  }
+  else
+  {
+    tx = tx_cycle_counter;
+  }
+
+  if (rx_bit_counter == 0 && (input & 0x1))
+  {
+    rx = rx_cycle_counter ? 0 : NEVER;
+  }
+  else if (rx_bit_counter == 0)
+  {
+    rx = rx_cycle_counter < divider_integer / 2 ? divider_integer / 2 - rx_cycle_counter : 0;
+  }
+  else
+  {
+    rx = rx_cycle_counter;
+  }
+
+  if (!rx_fifo.empty() && rx_timeout_counter != timeout_cycles)
+  {
+    timeout = timeout_cycles - 1 - rx_timeout_counter;
+  }
+
+  return std::min({tx, rx, timeout});
+}
+
+void TlmUart::skip(uint64_t edges)
+{
+  if (tx_bit_counter)
+  {
+    tx_cycle_counter -= edges;
+  }
+
+  if (rx_bit_counter)
+  {
+    rx_cycle_counter -= edges;
+  }
+  else if (!(input & 0x1))
+  {
+    rx_cycle_counter += edges;
+  }
+
+  if (!rx_fifo.empty() && rx_timeout_counter != timeout_cycles)
+  {
+    rx_timeout_counter += edges;
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+// rvx_mtimer
+
+enum TimerRegister : uint32_t
+{
+  TIMER_CR = 0,
+  TIMER_MTIMEL = 1,
+  TIMER_MTIMEH = 2,
+  TIMER_MTIMECMPL = 3,
+  TIMER_MTIMECMPH = 4,
+};
+
+void TlmTimer::clear()
+{
+  cr_en = false;
+  mtime = 0;
+  mtimecmp = ~0ull;
+  timer_irq = false;
+}
+
+void TlmTimer::load(bool enable, uint64_t mtime_value, uint64_t mtimecmp_value)
+{
+  cr_en = enable;
+  mtime = mtime_value;
+  mtimecmp = mtimecmp_value;
+  timer_irq = false;
+}
+
+uint32_t TlmTimer::read_register(uint32_t address) const
+{
+  switch (address >> 2 & 0x7)
+  {
+  case TIMER_CR:
+    return cr_en;
+  case TIMER_MTIMEL:
+    return (uint32_t)mtime;
+  case TIMER_MTIMEH:
+    return mtime >> 32;
+  case TIMER_MTIMECMPL:
+    return (uint32_t)mtimecmp;
+  case TIMER_MTIMECMPH:
+    return mtimecmp >> 32;
+  default:
+    return 0;
+  }
+}
+
+void TlmTimer::step(const TlmEdge &access)
+{
+  bool update = access.write && !(access.address & 0x3) && access.strobe == 0xf;
+  uint32_t index = update ? access.address >> 2 & 0x7 : ~0u;
+  uint64_t mtime_plus_1 = mtime + 1;
+
+  // The interrupt is not updated at the edges that write mtime or mtimecmp
+  if (index < TIMER_MTIMEL || index > TIMER_MTIMECMPH)
+  {
+    timer_irq = mtime >= mtimecmp;
+  }
+
+  switch (index)
+  {
+  case TIMER_MTIMEL:
+    mtime = (mtime_plus_1 & ~0xffffffffull) | access.data;
+    break;
+  case TIMER_MTIMEH:
+    mtime = (uint64_t)access.data << 32 | (mtime_plus_1 & 0xffffffffull);
+    break;
+  default:
+    if (cr_en)
+    {
+      mtime = mtime_plus_1;
+    }
+    break;
+  }
+
+  switch (index)
+  {
+  case TIMER_CR:
+    cr_en = access.data & 0x1;
+    break;
+  case TIMER_MTIMECMPL:
+    mtimecmp = (mtimecmp & ~0xffffffffull) | access.data;
+    break;
+  case TIMER_MTIMECMPH:
+    mtimecmp = (uint64_t)access.data << 32 | (mtimecmp & 0xffffffffull);
+    break;
+  }
+}
+
+uint64_t TlmTimer::quiet_edges() const
+{
+  bool expired = mtime >= mtimecmp;
+
+  if (timer_irq != expired)
+  {
+    return 0;
+  }
+  // mtime counts up to mtimecmp, the interrupt is raised at the edge after
+  if (cr_en && !expired)
+  {
+    return mtimecmp - mtime;
+  }
+  return NEVER;
+}
+
+void TlmTimer::skip(uint64_t edges)
+{
+  if (cr_en)
+  {
+    mtime += edges;
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+// rvx_gpio
+
+enum GpioRegister : uint32_t
+{
+  GPIO_IN = 0,
+  GPIO_OE = 1,
+  GPIO_OUT = 2,
+  GPIO_CLR = 3,
+  GPIO_SET = 4,
+};
+
+void TlmGpio::clear()
+{
+  oe = 0;
+  out = 0;
+}
+
+void TlmGpio::load(uint32_t oe_value, uint32_t out_value)
+{
+  oe = oe_value & mask;
+  out = out_value & mask;
+}
+
+uint32_t TlmGpio::read_register(uint32_t address) const
+{
+  switch (address >> 2 & 0x7)
+  {
+  case GPIO_IN:
+    return input & mask;
+  case GPIO_OE:
+    return oe;
+  case GPIO_OUT:
+    return out;
+  default:
+    return 0;
+  }
+}
+
+void TlmGpio::step(const TlmEdge &access)
+{
+  if (!access.write || (access.address & 0x3) || access.strobe != 0xf)
+  {
+    return;
+  }
+
+  uint32_t data = access.data & mask;
+  switch (access.address >> 2 & 0x7)
+  {
+  case GPIO_OE:
+    oe = data;
+    break;
+  case GPIO_OUT:
+    out = data;
+    break;
+  case GPIO_CLR:
+    out &= ~data;
+    break;
+  case GPIO_SET:
+    out |= data;
+    break;
+  }
+}
+
+uint64_t TlmGpio::quiet_edges() const
+{
+  return NEVER;
+}
+
+void TlmGpio::skip(uint64_t)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+// rvx_spi
+
+static constexpr uint32_t SPI_CPOL = 0x00;
+static constexpr uint32_t SPI_CPHA = 0x04;
+static constexpr uint32_t SPI_CHIP_SELECT = 0x08;
+static constexpr uint32_t SPI_CLOCK_CONF = 0x0c;
+static constexpr uint32_t SPI_WDATA = 0x10;
+static constexpr uint32_t SPI_RDATA = 0x14;
+static constexpr uint32_t SPI_BUSY = 0x18;
+
+void TlmSpi::clear()
+{
+  cpol = false;
+  cpha = false;
+  chip_select = 0xff;
+  clock_div = 0;
+  tx_reg = 0;
+  tx_start = false;
+  state = READY;
+  cycle_counter = 0;
+  bit_count = 7;
+  clk_edge = false;
+  sclk = false;
+  pico = false;
+  cs = num_chip_select >= 32 ? ~0u : (1u << num_chip_select) - 1;
+}
+
+TlmSpi::Next TlmSpi::next() const
+{
+  Next n;
+  uint8_t start = cpha ? CPOL_N : CPOL;
+  bool last_bit = bit_count == 0;
+
+  n.cs = num_chip_select >= 32 ? ~0u : (1u << num_chip_select) - 1;
+  if (chip_select < num_chip_select)
+  {
+    n.cs &= ~(1u << chip_select);
+  }
+
+  switch (state)
+  {
+  case CPOL:
+    n.sclk = cpol;
+    n.pico = tx_reg >> (bit_count & 0x7) & 0x1;
+    n.state = cycle_counter < clock_div ? state : (last_bit && cpha ? IDLE : CPOL_N);
+    break;
+  case CPOL_N:
+    n.sclk = !cpol;
+    n.pico = tx_reg >> (bit_count & 0x7) & 0x1;
+    n.state = cycle_counter < clock_div ? state : (last_bit && !cpha ? IDLE : CPOL);
+    break;
+  case IDLE:
+    n.sclk = cpol;
+    n.pico = tx_reg & 0x1;
+    n.state = chip_select == 0xff ? READY : (tx_start ? start : state);
+    break;
+  default:
+    n.sclk = cpol;
+    n.pico = tx_reg >> 7;
+    n.state = tx_start ? start : state;
+    break;
+  }
+  return n;
+}
+
+bool TlmSpi::settled() const
+{
+  Next n = next();
+  return sclk == n.sclk && pico == n.pico && cs == n.cs &&
+         clk_edge == ((cpol ^ cpha) ? !n.sclk : n.sclk);
+}
+
+uint32_t TlmSpi::read_register(uint32_t address) const
+{
+  switch (address)
+  {
+  case SPI_CPOL:
+    return cpol;
+  case SPI_CPHA:
+    return cpha;
+  case SPI_CHIP_SELECT:
+    return chip_select;
+  case SPI_CLOCK_CONF:
+    return clock_div;
+  case SPI_RDATA:
+    return rx_reg;
+  case SPI_BUSY:
+    return state == CPOL || state == CPOL_N;
+  default:
+    return 0xdeadbeef;
+  }
+}
+
+void TlmSpi::step(const TlmEdge &access)
+{
+  Next n = next();
+  bool valid = access.write && access.strobe == 0xf;
+  uint8_t data = access.data & 0xff;
+  bool ready = state == READY || state == IDLE;
+  bool shift_edge = (cpol ^ cpha) ? !n.sclk : n.sclk;
+
+  if (ready)
+  {
+    cycle_counter = 0;
+    bit_count = 7;
+  }
+  else if ((state == CPOL && n.state == CPOL_N) || (state == CPOL_N && n.state == CPOL))
+  {
+    if ((!cpha && state == CPOL_N) || (cpha && state == CPOL))
+    {
+      bit_count = (bit_count - 1) & 0xf;
+    }
+    cycle_counter = 0;
+  }
+  else
+  {
+    cycle_counter++;
+  }
+
+  if (valid && access.address == SPI_WDATA)
+  {
+    if (ready)
+    {
+      tx_reg = data;
+      tx_start = true;
+    }
+  }
+  else if (!ready)
+  {
+    tx_start = false;
+  }
+
+  state = chip_select == 0xff ? READY : n.state;
+  sclk = n.sclk;
+  pico = n.pico;
+  cs = n.cs;
+
+  // rx_reg is clocked by the rising edges of clk_edge
+  if (!clk_edge && shift_edge)
+  {
+    rx_reg = rx_reg << 1 | (input & 0x1);
+  }
+  clk_edge = shift_edge;
+
+  if (valid)
+  {
+    switch (access.address)
+    {
+    case SPI_CPOL:
+      cpol = data & 0x1;
+      break;
+    case SPI_CPHA:
+      cpha = data & 0x1;
+      break;
+    case SPI_CHIP_SELECT:
+      chip_select = data;
+      break;
+    case SPI_CLOCK_CONF:
+      clock_div = data;
+      break;
+    }
+  }
+}
+
+uint64_t TlmSpi::quiet_edges() const
+{
+  if (!settled())
+  {
+    return 0;
+  }
+
+  Next n = next();
+  if (state == READY || state == IDLE)
+  {
+    // A pending tx_start only matters once a chip is selected
+    bool stays = chip_select == 0xff ? state == READY : n.state == state;
+    return stays && cycle_counter == 0 && bit_count == 7 ? NEVER : 0;
+  }
+
+  // Half period of sclk
+  if (!tx_start && chip_select != 0xff && cycle_counter < clock_div)
+  {
+    return clock_div - cycle_counter;
+  }
+  return 0;
+}
+
+void TlmSpi::skip(uint64_t edges)
+{
+  if (state == CPOL || state == CPOL_N)
+  {
+    cycle_counter += edges;
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+// DPI functions of rvx_tlm_device.v
+
+static std::mutex devices_mutex;
+static std::map<std::string, std::unique_ptr<TlmDevice>> devices;
+
+TlmDevice *tlm_find(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(devices_mutex);
+  auto found = devices.find(name);
+  return found == devices.end() ? nullptr : found->second.get();
+}
+
+void *rvx_tlm_open(int device, int config, int config_extra)
+{
+  std::unique_ptr<TlmDevice> model;
+
+  switch (device)
+  {
+  case TLM_UART:
+    model.reset(new TlmUart(config, config_extra));
+    break;
+  case TLM_MTIMER:
+    model.reset(new TlmTimer());
+    break;
+  case TLM_GPIO:
+    model.reset(new TlmGpio(config));
+    break;
+  case TLM_SPI:
+    model.reset(new TlmSpi(config));
+    break;
+  default:
+    return nullptr;
+  }
+
+  // Several models can be built in the same process (--system), each one on its own thread
+  TlmDevice *handle = model.get();
+  std::lock_guard<std::mutex> lock(devices_mutex);
+  devices[svGetNameFromScope(svGetScope())] = std::move(model);
+  return handle;
+}
+
+void rvx_tlm_reset(void *model, unsigned long long cycle, unsigned int *outputs)
+{
+  TlmDevice *device = static_cast<TlmDevice *>(model);
+  device->reset(cycle);
+  *outputs = device->outputs();
+}
+
+unsigned long long rvx_tlm_edge(void *model, unsigned long long cycle, svBit read, svBit write,
+                                unsigned int address, unsigned int data, unsigned int strobe,
+                                unsigned int input, svBit irq_response, unsigned int *read_data,
+                                unsigned int *outputs, svBit *irq)
+{
+  TlmDevice *device = static_cast<TlmDevice *>(model);
+  TlmEdge access;
+  access.read = read;
+  access.write = write;
+  access.address = address;
+  access.data = data;
+  access.strobe = strobe;
+  access.irq_response = irq_response;
+
+  uint64_t next_event = device->edge(cycle, access, input, *read_data);
+  *outputs = device->outputs();
+  *irq = device->irq();
+  return next_event;
+}
@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+#ifndef TLM_PERIPHERALS_H
+#define TLM_PERIPHERALS_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+
+// C++ models of the rvx peripherals, used by the mcu_sim_tlm build in place of their RTL. Each one
+// sits behind an rvx_tlm_device shell (rvx_tlm_device.v), which calls it through DPI at the rising
+// edges with a bus access, an input change or an interrupt response, and at the edges the model
+// asked for. The models replay the edges they were not called for when they are called again, with
+// the runs of edges that only count cycles (a UART bit, an SPI half period, the timer counting to
+// mtimecmp) skipped in one step. The registers and pins match the RTL at every edge.
+
+// Values of the DEVICE parameter of rvx_tlm_device
+enum TlmDeviceKind
+{
+  TLM_UART = 1,
+  TLM_MTIMER = 2,
+  TLM_GPIO = 3,
+  TLM_SPI = 4,
+};
+
+// Bus access and inputs of one rising edge
+struct TlmEdge
+{
+  bool read{false};
+  bool write{false};
+  uint32_t address{0};
+  uint32_t data{0};
+  uint32_t strobe{0};
+  bool irq_response{false};
+};
+
+class TlmDevice
+{
+public:
+  virtual ~TlmDevice() = default;
+
+  // Reset asserted at the edge of cycle
+  void reset(uint64_t cycle);
+
+  // Processes the edge of cycle, the value read is the one of the register before the edge.
+  // Returns the next cycle at which the pins or the interrupt can change (UINT64_MAX: never).
+  uint64_t edge(uint64_t cycle, const TlmEdge &access, uint32_t input, uint32_t &read_data);
+
+  // State after the last edge processed
+  virtual uint32_t outputs() const = 0;
+  virtual bool irq() const
+  {
+    return false;
+  }
+
+protected:
+  uint64_t processed{0};
+  uint32_t input{0};
+
+  virtual void clear() = 0;
+  virtual uint32_t read_register(uint32_t address) const = 0;
+  // One rising edge, with the values of the registers before it
+  virtual void step(const TlmEdge &access) = 0;
+  // Number of edges from now on without bus access that only advance counters
+  virtual uint64_t quiet_edges() const = 0;
+  virtual void skip(uint64_t edges) = 0;
+
+private:
+  void catch_up(uint64_t cycle);
+};
+
+class TlmUart : public TlmDevice
+{
+public:
+  // bit_period in cycles with 8 fractional bits, fifo_depths holds RX_FIFO_DEPTH in the low byte
+  // and TX_FIFO_DEPTH in the next one
+  TlmUart(uint32_t bit_period, uint32_t fifo_depths)
+      : divider_integer(bit_period >> 8), divider_fraction(bit_period & 0xff),
+        timeout_cycles(40 * divider_integer), rx_depth(fifo_depths & 0xff),
+        tx_depth(fifo_depths >> 8 & 0xff)
+  {
+  }
+
+  uint32_t outputs() const override
+  {
+    return tx_register & 0x1;
+  }
+  bool irq() const override
+  {
+    return (irq_enable & pending()) && !irq_taken;
+  }
+
+protected:
+  void clear() override;
+  uint32_t read_register(uint32_t address) const override;
+  void step(const TlmEdge &access) override;
+  uint64_t quiet_edges() const override;
+  void skip(uint64_t edges) override;
+
+private:
+  uint32_t divider_integer;
+  uint32_t divider_fraction;
+  uint32_t timeout_cycles;
+  uint32_t rx_depth;
+  uint32_t tx_depth;
+  // rvx_uart stays in reset one edge longer than the other devices
+  bool reset_reg{false};
+  uint32_t tx_cycle_counter{0};
+  uint32_t rx_cycle_counter{0};
+  uint32_t tx_fraction{0};
+  uint32_t rx_fraction{0};
+  uint32_t tx_bit_counter{0};
+  uint32_t rx_bit_counter{0};
+  uint32_t tx_register{0x3ff};
+  uint32_t rx_register{0};
+  std::deque<uint8_t> tx_fifo;
+  std::deque<uint8_t> rx_fifo;
+  bool rx_overrun{false};
+  uint32_t rx_timeout_counter{0};
+  uint32_t irq_enable{0x1};
+  uint32_t rx_watermark{1};
+  uint32_t tx_threshold{0};
+  // Enabled conditions at the last edge, and interrupt taken by the core since the last event
+  uint32_t irq_active{0};
+  bool irq_taken{false};
+
+  // Interrupt conditions, in the order of the bits of REG_IRQ_ENABLE
+  uint32_t pending() const;
+};
+
+class TlmTimer : public TlmDevice
+{
+public:
+  uint32_t outputs() const override
+  {
+    return 0;
+  }
+  bool irq() const override
+  {
+    return timer_irq;
+  }
+
+  // Sets the registers, for the state copied from the functional model of a sampled simulation
+  void load(bool enable, uint64_t mtime, uint64_t mtimecmp);
+
+protected:
+  void clear() override;
+  uint32_t read_register(uint32_t address) const override;
+  void step(const TlmEdge &access) override;
+  uint64_t quiet_edges() const override;
+  void skip(uint64_t edges) override;
+
+private:
+  bool cr_en{false};
+  uint64_t mtime{0};
+  uint64_t mtimecmp{~0ull};
+  bool timer_irq{false};
+};
+
+class TlmGpio : public TlmDevice
+{
+public:
+  explicit TlmGpio(uint32_t width) : mask(width >= 32 ? ~0u : (1u << width) - 1), width(width)
+  {
+  }
+
+  // gpio_oe in the low bits, gpio_output above
+  uint32_t outputs() const override
+  {
+    return oe | out << width;
+  }
+
+  void load(uint32_t oe, uint32_t out);
+
+protected:
+  void clear() override;
+  uint32_t read_register(uint32_t address) const override;
+  void step(const TlmEdge &access) override;
+  uint64_t quiet_edges() const override;
+  void skip(uint64_t edges) override;
+
+private:
+  uint32_t mask;
+  uint32_t width;
+  uint32_t oe{0};
+  uint32_t out{0};
+};
+
+class TlmSpi : public TlmDevice
+{
+public:
+  explicit TlmSpi(uint32_t num_chip_select) : num_chip_select(num_chip_select)
+  {
+  }
+
+  // sclk, pico, then cs
+  uint32_t outputs() const override
+  {
+    return sclk | pico << 1 | cs << 2;
+  }
+
+protected:
+  void clear() override;
+  uint32_t read_register(uint32_t address) const override;
+  void step(const TlmEdge &access) override;
+  uint64_t quiet_edges() const override;
+  void skip(uint64_t edges) override;
+
+private:
+  // States of the FSM
+  static constexpr uint8_t READY = 0x1;
+  static constexpr uint8_t IDLE = 0x2;
+  static constexpr uint8_t CPOL = 0x4;
+  static constexpr uint8_t CPOL_N = 0x8;
+
+  // Combinational signals of the current state
+  struct Next
+  {
+    uint8_t state;
+    bool sclk;
+    bool pico;
+    uint32_t cs;
+  };
+
+  uint32_t num_chip_select;
+  bool cpol{false};
+  bool cpha{false};
+  uint8_t chip_select{0xff};
+  uint8_t clock_div{0};
+  uint8_t tx_reg{0};
+  bool tx_start{false};
+  uint8_t state{READY};
+  uint8_t cycle_counter{0};
+  uint8_t bit_count{7};
+  uint8_t rx_reg{0};
+  bool clk_edge{false};
+  bool sclk{false};
+  bool pico{false};
+  uint32_t cs{0};
+
+  Next next() const;
+  bool settled() const;
+};
+
+// Model of a device instance by hierarchical name, for example
+// "TOP.mcu_sim.rvx_instance.rvx_mtimer_instance". nullptr if there is none.
+TlmDevice *tlm_find(const std::string &name);
+
+#endif // TLM_PERIPHERALS_H
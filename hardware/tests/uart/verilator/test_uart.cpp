@@ -0,0 +1,378 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020-2025 RVX Project Contributors
+
+// Native Verilator test bench of the UART FIFOs, interrupts and fractional baud divider. The model
+// is built with a bit period of 8.68 cycles and FIFOs of 4 bytes (see the Makefile).
+
+#include <memory>
+#include <vector>
+
+#include "Vrvx_uart.h"
+#include "bus_master.h"
+#include "test_runner.h"
+
+using Dut = Vrvx_uart;
+
+static constexpr double CYCLES_PER_BIT = 1000000.0 / 115200;
+static constexpr uint32_t FIFO_DEPTH = 4;
+
+static constexpr uint32_t REG_WDATA = 0x00;
+static constexpr uint32_t REG_RDATA = 0x04;
+static constexpr uint32_t REG_READY = 0x08;
+static constexpr uint32_t REG_RXSTATUS = 0x0c;
+static constexpr uint32_t REG_STATUS = 0x10;
+static constexpr uint32_t REG_LEVEL = 0x14;
+static constexpr uint32_t REG_IRQ_ENABLE = 0x18;
+static constexpr uint32_t REG_WATERMARK = 0x1c;
+
+// Bits of REG_STATUS, the interrupt conditions are those of REG_IRQ_ENABLE shifted by 8
+static constexpr uint32_t STATUS_RX_NOT_EMPTY = 1u << 0;
+static constexpr uint32_t STATUS_RX_FULL = 1u << 1;
+static constexpr uint32_t STATUS_TX_EMPTY = 1u << 2;
+static constexpr uint32_t STATUS_TX_FULL = 1u << 3;
+static constexpr uint32_t STATUS_RX_OVERRUN = 1u << 4;
+
+static constexpr uint32_t IRQ_RX_WATERMARK = 1u << 0;
+static constexpr uint32_t IRQ_RX_TIMEOUT = 1u << 1;
+static constexpr uint32_t IRQ_TX_EMPTY = 1u << 2;
+static constexpr uint32_t IRQ_TX_LOW = 1u << 3;
+
+struct Bench
+{
+  std::unique_ptr<Dut> dut{new Dut};
+  BusMaster<Dut> bus{dut.get()};
+  // uart_tx at each cycle since the end of the reset
+  std::vector<uint8_t> tx_line;
+
+  Bench()
+  {
+    // Idle line
+    dut->uart_rx = 1;
+    bus.reset();
+    bus.on_tick = [this]() { tx_line.push_back(dut->uart_tx); };
+    bus.wait(10);
+  }
+
+  // 8N1 frames on uart_rx, with the fractional part of the bit time accumulated
+  void send(const std::vector<uint8_t> &bytes)
+  {
+    double time = 0;
+    uint64_t cycle = 0;
+
+    for (uint8_t byte : bytes)
+    {
+      uint32_t frame = 0x200 | (uint32_t)byte << 1;
+      for (int bit = 0; bit < 10; bit++)
+      {
+        dut->uart_rx = frame >> bit & 0x1;
+        time += CYCLES_PER_BIT;
+        for (; cycle < (uint64_t)time; cycle++)
+        {
+          bus.tick();
+        }
+      }
+    }
+  }
+
+  // Request held for several cycles after its response, as rvx_core with HARVARD = 0 repeats it
+  // while it is halted
+  uint32_t held_read(uint32_t address, uint32_t cycles)
+  {
+    dut->rw_address = address;
+    dut->read_request = 1;
+    bus.wait(cycles);
+    uint32_t data = dut->read_data;
+    dut->read_request = 0;
+    bus.tick();
+    return data;
+  }
+
+  void held_write(uint32_t address, uint32_t data, uint32_t cycles)
+  {
+    dut->rw_address = address;
+    dut->write_data = data;
+    dut->write_request = 1;
+    bus.wait(cycles);
+    dut->write_request = 0;
+    bus.tick();
+  }
+
+  // The core takes the interrupt (one cycle of uart_irq_response, as in rvx_core)
+  void take_irq()
+  {
+    dut->uart_irq_response = 1;
+    bus.tick();
+    dut->uart_irq_response = 0;
+  }
+};
+
+// Frames of a recorded line, sampled in the middle of the bits that follow each start bit
+static std::vector<uint8_t> decode(const std::vector<uint8_t> &line, std::vector<size_t> &starts)
+{
+  std::vector<uint8_t> bytes;
+  size_t i = 1;
+
+  while (i < line.size())
+  {
+    if (!(line[i - 1] && !line[i]))
+    {
+      i++;
+      continue;
+    }
+
+    starts.push_back(i);
+    uint8_t byte = 0;
+    for (int bit = 0; bit < 8; bit++)
+    {
+      byte |= line[i + (size_t)((bit + 1.5) * CYCLES_PER_BIT)] << bit;
+    }
+    CHECK_EQ(1, line[i + (size_t)(9.5 * CYCLES_PER_BIT)]);
+    bytes.push_back(byte);
+    i += (size_t)(9.5 * CYCLES_PER_BIT);
+  }
+
+  return bytes;
+}
+
+static void test_transmit()
+{
+  Bench b;
+  const std::vector<uint8_t> message = {'R', 'V', 'X', 0xa5};
+
+  // The first byte starts right away, the others wait in the FIFO
+  for (uint8_t byte : message)
+  {
+    CHECK_EQ(1, b.bus.read_request(REG_READY));
+    b.bus.write_request(REG_WDATA, byte);
+  }
+
+  b.bus.wait(50 * CYCLES_PER_BIT);
+  std::vector<size_t> starts;
+  std::vector<uint8_t> received = decode(b.tx_line, starts);
+  CHECK_EQ(message.size(), received.size());
+  for (size_t i = 0; i < message.size(); i++)
+  {
+    CHECK_EQ(message[i], received[i]);
+  }
+
+  // Back to back frames, at the exact baud rate on average
+  for (size_t i = 1; i < starts.size(); i++)
+  {
+    double expected = starts[0] + i * 10 * CYCLES_PER_BIT;
+    CHECK(starts[i] >= expected - 1 && starts[i] <= expected + 1);
+  }
+
+  CHECK_EQ(STATUS_TX_EMPTY, b.bus.read_request(REG_STATUS) & 0xff);
+}
+
+static void test_transmit_full()
+{
+  Bench b;
+
+  // One byte in the shift register, FIFO_DEPTH bytes in the FIFO, the last one is dropped
+  for (uint32_t i = 0; i < FIFO_DEPTH + 2; i++)
+  {
+    b.bus.write_request(REG_WDATA, 0x30 + i);
+  }
+
+  CHECK_EQ(0, b.bus.read_request(REG_READY));
+  CHECK_EQ(FIFO_DEPTH << 8, b.bus.read_request(REG_LEVEL));
+  CHECK_EQ(STATUS_TX_FULL, b.bus.read_request(REG_STATUS) & 0xff);
+
+  b.bus.wait(60 * CYCLES_PER_BIT);
+  std::vector<size_t> starts;
+  std::vector<uint8_t> received = decode(b.tx_line, starts);
+  CHECK_EQ(FIFO_DEPTH + 1, received.size());
+  CHECK_EQ(0x30 + FIFO_DEPTH, received.back());
+  CHECK_EQ(1, b.bus.read_request(REG_READY));
+}
+
+static void test_receive()
+{
+  Bench b;
+
+  CHECK_EQ(0, b.bus.read_request(REG_RXSTATUS));
+  b.send({0x12, 0x80, 0xff});
+  b.bus.wait(2 * CYCLES_PER_BIT);
+
+  CHECK_EQ(1, b.bus.read_request(REG_RXSTATUS));
+  CHECK_EQ(3, b.bus.read_request(REG_LEVEL));
+  CHECK_EQ(0x12, b.bus.read_request(REG_RDATA));
+  CHECK_EQ(0x80, b.bus.read_request(REG_RDATA));
+  CHECK_EQ(0xff, b.bus.read_request(REG_RDATA));
+
+  // Empty FIFO
+  CHECK_EQ(0, b.bus.read_request(REG_RDATA));
+  CHECK_EQ(0, b.bus.read_request(REG_RXSTATUS));
+  CHECK_EQ(0, b.bus.read_request(REG_LEVEL));
+}
+
+static void test_receive_overrun()
+{
+  Bench b;
+
+  b.send({0x01, 0x02, 0x03, 0x04, 0x05});
+  b.bus.wait(2 * CYCLES_PER_BIT);
+
+  CHECK_EQ(FIFO_DEPTH, b.bus.read_request(REG_LEVEL));
+  CHECK_EQ(STATUS_RX_OVERRUN | STATUS_TX_EMPTY | STATUS_RX_FULL | STATUS_RX_NOT_EMPTY,
+           b.bus.read_request(REG_STATUS) & 0xff);
+
+  // Cleared by the read of REG_STATUS
+  CHECK_EQ(0, b.bus.read_request(REG_STATUS) & STATUS_RX_OVERRUN);
+
+  for (uint32_t i = 1; i <= FIFO_DEPTH; i++)
+  {
+    CHECK_EQ(i, b.bus.read_request(REG_RDATA));
+  }
+}
+
+static void test_rx_watermark_irq()
+{
+  Bench b;
+
+  // Reset: RX watermark interrupt enabled, watermark of 1 byte
+  CHECK_EQ(IRQ_RX_WATERMARK, b.bus.read_request(REG_IRQ_ENABLE));
+  CHECK_EQ(1, b.bus.read_request(REG_WATERMARK));
+  CHECK_EQ(0, b.dut->uart_irq);
+
+  b.send({0x55});
+  b.bus.wait(2 * CYCLES_PER_BIT);
+  CHECK_EQ(1, b.dut->uart_irq);
+  b.bus.read_request(REG_RDATA);
+  CHECK_EQ(0, b.dut->uart_irq);
+
+  b.bus.write_request(REG_WATERMARK, 3);
+  b.send({0x01, 0x02});
+  b.bus.wait(2 * CYCLES_PER_BIT);
+  CHECK_EQ(0, b.dut->uart_irq);
+
+  b.send({0x03});
+  b.bus.wait(2 * CYCLES_PER_BIT);
+  CHECK_EQ(1, b.dut->uart_irq);
+  CHECK_EQ(IRQ_RX_WATERMARK << 8, b.bus.read_request(REG_STATUS) & (IRQ_RX_WATERMARK << 8));
+
+  b.bus.read_request(REG_RDATA);
+  CHECK_EQ(0, b.dut->uart_irq);
+}
+
+static void test_rx_timeout_irq()
+{
+  Bench b;
+
+  b.bus.write_request(REG_IRQ_ENABLE, IRQ_RX_TIMEOUT);
+  b.send({0x42});
+  b.bus.wait(2 * CYCLES_PER_BIT);
+  CHECK_EQ(0, b.dut->uart_irq);
+
+  // 4 frames of idle line
+  b.bus.wait(40 * CYCLES_PER_BIT);
+  CHECK_EQ(1, b.dut->uart_irq);
+  CHECK_EQ(IRQ_RX_TIMEOUT << 8, b.bus.read_request(REG_STATUS) & (IRQ_RX_TIMEOUT << 8));
+
+  CHECK_EQ(0x42, b.bus.read_request(REG_RDATA));
+  CHECK_EQ(0, b.dut->uart_irq);
+}
+
+static void test_tx_irqs()
+{
+  Bench b;
+
+  // Empty FIFO and idle line
+  b.bus.write_request(REG_IRQ_ENABLE, IRQ_TX_EMPTY);
+  CHECK_EQ(1, b.dut->uart_irq);
+
+  b.bus.write_request(REG_WDATA, 0x61);
+  b.bus.write_request(REG_WDATA, 0x62);
+  CHECK_EQ(0, b.dut->uart_irq);
+  b.bus.wait(21 * CYCLES_PER_BIT);
+  CHECK_EQ(1, b.dut->uart_irq);
+
+  // Low when the FIFO has at most one byte left
+  b.bus.write_request(REG_WATERMARK, 1 << 8 | 1);
+  b.bus.write_request(REG_IRQ_ENABLE, IRQ_TX_LOW);
+  for (uint32_t i = 0; i < FIFO_DEPTH; i++)
+  {
+    b.bus.write_request(REG_WDATA, 0x70 + i);
+  }
+  CHECK_EQ(0, b.dut->uart_irq);
+
+  // Two frames later, while the third one is sent
+  b.bus.wait(21 * CYCLES_PER_BIT);
+  CHECK_EQ(1, b.dut->uart_irq);
+  CHECK_EQ(1 << 8, b.bus.read_request(REG_LEVEL));
+  CHECK_EQ(0, b.bus.read_request(REG_STATUS) & STATUS_TX_EMPTY);
+}
+
+static void test_irq_response()
+{
+  Bench b;
+
+  // Once taken, low until the next byte, as with the UART without FIFOs
+  b.send({0x31});
+  b.bus.wait(2 * CYCLES_PER_BIT);
+  CHECK_EQ(1, b.dut->uart_irq);
+  b.take_irq();
+  CHECK_EQ(0, b.dut->uart_irq);
+  b.bus.wait(20 * CYCLES_PER_BIT);
+  CHECK_EQ(0, b.dut->uart_irq);
+
+  b.send({0x32});
+  b.bus.wait(2 * CYCLES_PER_BIT);
+  CHECK_EQ(1, b.dut->uart_irq);
+
+  // Raised again by a read that leaves a byte in the FIFO
+  b.take_irq();
+  CHECK_EQ(0, b.dut->uart_irq);
+  CHECK_EQ(0x31, b.bus.read_request(REG_RDATA));
+  CHECK_EQ(1, b.dut->uart_irq);
+  CHECK_EQ(0x32, b.bus.read_request(REG_RDATA));
+  CHECK_EQ(0, b.dut->uart_irq);
+
+  // and by a condition that becomes active
+  b.bus.write_request(REG_IRQ_ENABLE, IRQ_TX_EMPTY);
+  CHECK_EQ(1, b.dut->uart_irq);
+  b.take_irq();
+  CHECK_EQ(0, b.dut->uart_irq);
+  b.bus.write_request(REG_IRQ_ENABLE, IRQ_TX_EMPTY | IRQ_TX_LOW);
+  CHECK_EQ(1, b.dut->uart_irq);
+}
+
+static void test_held_requests()
+{
+  Bench b;
+
+  // A read of REG_RDATA held for 5 cycles pops one byte and returns it until the end
+  b.send({0x41, 0x42});
+  b.bus.wait(2 * CYCLES_PER_BIT);
+  CHECK_EQ(2, b.bus.read_request(REG_LEVEL));
+  CHECK_EQ(0x41, b.held_read(REG_RDATA, 5));
+  CHECK_EQ(1, b.bus.read_request(REG_LEVEL));
+  CHECK_EQ(0x42, b.held_read(REG_RDATA, 5));
+  CHECK_EQ(0, b.bus.read_request(REG_LEVEL));
+
+  // A write of REG_WDATA held for 5 cycles sends one byte
+  b.held_write(REG_WDATA, 0x43, 5);
+  b.bus.wait(12 * CYCLES_PER_BIT);
+  std::vector<size_t> starts;
+  std::vector<uint8_t> received = decode(b.tx_line, starts);
+  CHECK_EQ(1, received.size());
+  CHECK_EQ(0x43, received[0]);
+}
+
+int main(int argc, char *argv[])
+{
+  return run_tests(
+      {
+          {"test_transmit", test_transmit},
+          {"test_transmit_full", test_transmit_full},
+          {"test_receive", test_receive},
+          {"test_receive_overrun", test_receive_overrun},
+          {"test_rx_watermark_irq", test_rx_watermark_irq},
+          {"test_rx_timeout_irq", test_rx_timeout_irq},
+          {"test_tx_irqs", test_tx_irqs},
+          {"test_irq_response", test_irq_response},
+          {"test_held_requests", test_held_requests},
+      },
+      argc, argv);
+}